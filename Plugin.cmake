@@ -58,6 +58,7 @@ set(SRC
   src/cutil.cpp
   src/EditPolarDialog.cpp
   src/FilterRoutesDialog.cpp
+  src/Geodesy.cpp
   src/georef.cpp
   src/GribRecord.cpp
   src/icons.cpp
@@ -68,11 +69,14 @@ set(SRC
   src/Polar.cpp
   src/PolygonRegion.cpp
   src/Position.cpp
+  src/RejectionHistogram.cpp
   src/ReportDialog.cpp
   src/RouteMap.cpp
   src/RouteMapOverlay.cpp
   src/RoutePoint.cpp
   src/RouteSimplifier.cpp
+  src/RoutingProfile.cpp
+  src/RoutingTrace.cpp
   src/RoutingTablePanel.cpp
   src/SettingsDialog.cpp
   src/StatisticsDialog.cpp
@@ -92,6 +96,7 @@ set(SRC
   include/cutil.h
   include/EditPolarDialog.h
   include/FilterRoutesDialog.h
+  include/Geodesy.h
   include/georef.h
   include/GribRecord.h
   include/icons.h
@@ -102,11 +107,14 @@ set(SRC
   include/Polar.h
   include/PolygonRegion.h
   include/Position.h
+  include/RejectionHistogram.h
   include/ReportDialog.h
   include/RouteMap.h
   include/RouteMapOverlay.h
   include/RoutePoint.h
   include/RouteSimplifier.h
+  include/RoutingProfile.h
+  include/RoutingTrace.h
   include/RoutingTablePanel.h
   include/SettingsDialog.h
   include/StatisticsDialog.h
@@ -20,6 +20,8 @@
 #ifndef _WEATHER_ROUTING_BOAT_H_
 #define _WEATHER_ROUTING_BOAT_H_
 
+#include <memory>
+
 #include "Polar.h"
 
 /*
@@ -34,6 +36,23 @@ public:
   wxString OpenXML(wxString filename, bool shortcut = true);
   wxString SaveXML(wxString filename);
 
+  /**
+   * Gets the read-only boat loaded from a boat file, shared by every user of
+   * that file.
+   *
+   * Loaded boats are cached by file name for as long as someone holds them.
+   * The file is only read again when its modification time changes, so
+   * route configurations can share one copy of the polars instead of each
+   * holding its own.
+   *
+   * @param filename The boat XML file.
+   * @param error Set to the error message from OpenXML(), empty on success.
+   * @return The boat, never null. On error it holds the polars loaded before
+   * the failure.
+   */
+  static std::shared_ptr<const Boat> Shared(const wxString& filename,
+                                            wxString& error);
+
   std::vector<Polar> Polars;
 
   /**
@@ -70,6 +89,21 @@ public:
    *         - Any other polar produces a faster boat speed for these conditions
    */
   bool FastestPolar(int p, float H, float VW);
+  /**
+   * Gets the highest boat speed through water found in any of the polars.
+   *
+   * @return The maximum boat speed in knots, or 0 if there is no polar data.
+   */
+  double MaxSpeed() const;
+  /**
+   * Gets the highest boat speed through water any of the polars gives for
+   * wind speeds up to max_tws, including the extrapolation beyond the polar
+   * tables.
+   *
+   * @param max_tws Strongest true wind speed in knots.
+   * @return The maximum boat speed in knots, or 0 if there is no polar data.
+   */
+  double MaxSpeed(double max_tws) const;
   /**
    * Generates CrossOverRegion and StandaloneRegion polygons for each polar in
    * the boat configuration.
@@ -157,7 +191,7 @@ public:
    */
   int FindBestPolarForCondition(int curpolar, double tws, double twa,
                                 double swell, bool optimize_tacking,
-                                PolarSpeedStatus* status = nullptr);
+                                PolarSpeedStatus* status = nullptr) const;
 
 private:
   /**
@@ -20,6 +20,9 @@
 #ifndef _WEATHER_ROUTING_CONSTRAINT_CHECKER_H_
 #define _WEATHER_ROUTING_CONSTRAINT_CHECKER_H_
 
+#include <utility>
+#include <vector>
+
 struct RouteMapConfiguration;
 
 enum PropagationError {
@@ -53,7 +56,45 @@ enum PropagationError {
   /** Cyclone track crossing detected during propagation. */
   PROPAGATION_CYCLONE_TRACK_CROSSING = 14,
   /** Propagation angle error. */
-  PROPAGATION_ANGLE_ERROR = 15
+  PROPAGATION_ANGLE_ERROR = 15,
+  /** Position cannot beat the best known arrival time at the destination. */
+  PROPAGATION_HEURISTIC_PRUNED = 16,
+  /** Position is outside the reverse pass isochrone of its time. */
+  PROPAGATION_OUTSIDE_REVERSE_REACH = 17
+};
+
+/**
+ * Legs of the corridor of a MultiResolution route, bucketed on a latitude and
+ * longitude grid.
+ *
+ * The cells are about as large as the corridor is wide, and each leg is
+ * listed in every cell within the corridor width of it, so a position only
+ * needs to be checked against the few legs of its own cell.
+ */
+struct CorridorGrid {
+  /**
+   * @param track Corridor track as (lat, lon) pairs, leg i goes from point i
+   * to point i + 1.
+   * @param width Corridor width in nautical miles.
+   */
+  CorridorGrid(const std::vector<std::pair<double, double>>& track,
+               double width);
+
+  /**
+   * Gets the legs which may be within the corridor width of a position.
+   *
+   * @return Indices of the legs, nullptr if the position is outside the grid.
+   */
+  const std::vector<int>* Legs(double lat, double lon) const;
+
+private:
+  int Row(double lat) const;
+  int Col(double lon) const;
+
+  double m_LatMin, m_LonOrigin, m_LonMin;
+  double m_CellLat, m_CellLon;
+  int m_Rows, m_Cols;
+  std::vector<std::vector<int>> m_Cells;
 };
 
 /**
@@ -150,6 +191,21 @@ public:
   static bool CheckMaxDivertedCourse(RouteMapConfiguration& configuration,
                                      double dlat, double dlon);
 
+  /**
+   * Check if a position lies inside the corridor of a multi resolution route.
+   *
+   * During the fine pass of a MultiResolution route, positions further than
+   * CorridorWidth from the track of the coarse pass are rejected. Only the
+   * legs listed by CorridorCells for the position are checked.
+   *
+   * @param configuration The route map configuration containing the corridor
+   * @param dlat Destination latitude
+   * @param dlon Destination longitude
+   * @return true if constraint is met, false otherwise
+   */
+  static bool CheckCorridorConstraint(RouteMapConfiguration& configuration,
+                                      double dlat, double dlon);
+
   /**
    * Check if a position avoids land areas with appropriate safety margin.
    *
@@ -168,6 +224,46 @@ public:
                                   double lat, double lon, double dlat,
                                   double dlon, double cog);
 
+  /**
+   * Check if a position may still beat the best known arrival time.
+   *
+   * The remaining time to the destination is bounded from below by the great
+   * circle distance divided by HeuristicSpeedBound. Positions whose bound
+   * exceeds HeuristicTimeBound cannot improve the route and need not be
+   * propagated. Always succeeds unless HeuristicPruning is enabled and both
+   * bounds are known and positive.
+   *
+   * @param configuration The route map configuration containing the bounds
+   * @param lat Latitude of the position to check
+   * @param lon Longitude of the position to check
+   * @param error_code [out] Error code set to PROPAGATION_HEURISTIC_PRUNED on
+   * failure
+   * @return true if the position should be propagated, false otherwise
+   */
+  static bool CheckHeuristicBound(RouteMapConfiguration& configuration,
+                                  double lat, double lon,
+                                  PropagationError& error_code);
+
+  /**
+   * Check if the destination can still be reached in time from a position.
+   *
+   * During the full pass of a Bidirectional route, ReverseReach holds the
+   * positions from which the reverse pass reached the destination by a step
+   * after the arrival of the coarse pass. Positions too close to its edge to
+   * tell are kept. Always succeeds when there is no such isochrone.
+   *
+   * @param configuration The route map configuration containing the
+   * isochrone
+   * @param lat Latitude of the position to check
+   * @param lon Longitude of the position to check
+   * @param error_code [out] Error code set to
+   * PROPAGATION_OUTSIDE_REVERSE_REACH on failure
+   * @return true if the position should be propagated, false otherwise
+   */
+  static bool CheckReverseReach(RouteMapConfiguration& configuration,
+                                double lat, double lon,
+                                PropagationError& error_code);
+
   static bool CheckMaxTrueWindConstraint(RouteMapConfiguration& configuration,
                                          double twsOverWater,
                                          PropagationError& error_code);
@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#ifndef _WEATHER_ROUTING_GEODESY_H_
+#define _WEATHER_ROUTING_GEODESY_H_
+
+#include <cmath>
+
+/**
+ * Fast forward geodesic solutions from a fixed start position.
+ *
+ * Propagating a position calls ll_gc_ll() for every heading from the same
+ * start point. ll_gc_ll() solves the WGS84 geodesic with a dozen
+ * trigonometric calls, and most of the work only depends on the start
+ * latitude.
+ *
+ * GeodesicOrigin computes the latitude dependent terms once. For short
+ * steps it then uses a second order expansion of the geodesic in the local
+ * tangent plane, which costs a sine and a cosine of the course plus a few
+ * multiplications. Steps longer than MaxFastDistance(), including every
+ * step near the poles, fall back to ll_gc_ll().
+ *
+ * The error of the expansion against ll_gc_ll() is bounded by
+ * ErrorBound(), and MaxFastDistance() is chosen so it stays below the
+ * requested maximum error.
+ */
+class GeodesicOrigin {
+public:
+  /** Upper limit for fast steps used by Position::Propagate(), in nautical
+   * miles. */
+  static constexpr double DEFAULT_MAX_DISTANCE = 60;
+  /** Maximum error of fast steps used by Position::Propagate(), in nautical
+   * miles (about 9 m). */
+  static constexpr double DEFAULT_MAX_ERROR = 0.005;
+
+  /**
+   * @param lat Latitude of the start position in degrees.
+   * @param lon Longitude of the start position in degrees.
+   * @param max_distance Steps longer than this, in nautical miles, always
+   * use ll_gc_ll().
+   * @param max_error Maximum error of fast steps against ll_gc_ll(), in
+   * nautical miles. Shortens the fast steps at high latitudes.
+   *
+   * The limits are not a user setting; the route propagation always uses
+   * the defaults, and the tests override them to check the expansion.
+   */
+  GeodesicOrigin(double lat, double lon,
+                 double max_distance = DEFAULT_MAX_DISTANCE,
+                 double max_error = DEFAULT_MAX_ERROR);
+
+  /**
+   * Upper bound of the distance between the fast solution and ll_gc_ll().
+   *
+   * The expansion neglects third order terms, which grow with the cube of
+   * the distance and with the convergence of the meridians.
+   * @param lat Latitude of the start position in degrees.
+   * @param dist Length of the step in nautical miles.
+   * @return The error bound in nautical miles, infinite at the poles.
+   */
+  static double ErrorBound(double lat, double dist);
+
+  /** Longest step, in nautical miles, solved without ll_gc_ll(). */
+  double MaxFastDistance() const { return m_MaxFastDistance; }
+
+  /**
+   * Position reached from the origin, same as ll_gc_ll().
+   * @param brg Initial course in degrees.
+   * @param dist Distance in nautical miles.
+   * @param dlat [out] Latitude in degrees.
+   * @param dlon [out] Longitude in degrees, in -180..180.
+   */
+  void Destination(double brg, double dist, double* dlat, double* dlon) const;
+
+private:
+  bool Fast(double dist) const { return fabs(dist) <= m_MaxFastDistance; }
+
+  double m_lat, m_lon;
+
+  /* radians of latitude and longitude per nautical mile north and east */
+  double m_LatPerNm, m_LonPerNm;
+  /* second order terms from the convergence of the meridians */
+  double m_LatCurvature, m_LonCurvature;
+  /* second order term from the change of the meridian radius of curvature */
+  double m_MeridianCurvature;
+
+  double m_MaxFastDistance;
+};
+
+/**
+ * Great circle distance on a sphere of the mean earth radius.
+ *
+ * Much cheaper than DistGreatCircle(), but off by up to 0.5%. Only use it
+ * where distances are compared against coarse thresholds.
+ * @return The distance in nautical miles.
+ */
+double FastDistance(double lat1, double lon1, double lat2, double lon2);
+
+#endif
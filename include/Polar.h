@@ -236,7 +236,7 @@ public:
    * to the index of the last wind speed and VW2i is set to the index of the
    * last wind speed minus 1.
    */
-  void ClosestVWi(double VW, int& VW1i, int& VW2i);
+  void ClosestVWi(double VW, int& VW1i, int& VW2i) const;
 
   /**
    * Calculate the boat speed based on the wind angle and wind speed using polar
@@ -263,7 +263,7 @@ public:
    * other calculation constraints.
    */
   double Speed(double twa, double tws, PolarSpeedStatus* status = nullptr,
-               bool bound = false, bool optimize_tacking = false);
+               bool bound = false, bool optimize_tacking = false) const;
   /**
    * Iteratively solves for boat speed given a target apparent wind direction.
    *
@@ -319,7 +319,31 @@ public:
    *
    * @return The minimum True Wind Angle in degrees from the polar data.
    */
-  double MinDegreeStep() { return degree_steps[0]; }
+  double MinDegreeStep() const { return degree_steps[0]; }
+
+  /**
+   * Gets the highest boat speed found anywhere in the polar table.
+   *
+   * Since Speed() interpolates linearly between table entries, this is an
+   * upper bound of the boat speed through water for any wind angle and any
+   * wind speed inside the polar range.
+   *
+   * @return The maximum boat speed in knots, or 0 if the polar has no data.
+   */
+  double MaxSpeed() const;
+
+  /**
+   * Gets the highest boat speed Speed() returns for wind speeds up to
+   * max_tws, without bounds.
+   *
+   * Unbounded, Speed() extrapolates linearly beyond the wind speeds of the
+   * table, so outside the table the speeds at the ends of the extrapolated
+   * segments are considered as well as the table entries.
+   *
+   * @param max_tws Strongest true wind speed in knots.
+   * @return The maximum boat speed in knots, or 0 if the polar has no data.
+   */
+  double MaxSpeed(double max_tws) const;
 
   /**
    * Gets optimal VMG angles for a given true wind speed.
@@ -335,7 +359,7 @@ public:
    *         - PORT_DOWNWIND: Best downwind angle on port
    *         Values will be NAN if wind speed is outside polar range
    */
-  SailingVMG GetVMGTrueWind(double tws);
+  SailingVMG GetVMGTrueWind(double tws) const;
   /**
    * Calculates optimal VMG angles for a given apparent wind speed.
    *
@@ -398,7 +422,7 @@ public:
    * otherwise
    */
   bool InsideCrossOverContour(float twa, float tws, bool optimize_tacking,
-                              PolarSpeedStatus* status = nullptr);
+                              PolarSpeedStatus* status = nullptr) const;
 
   /**
    * Defines the optimal wind conditions where this sail configuration
@@ -555,8 +579,8 @@ private:
    * @return true if a better VMG angle was found and W was modified, false
    * otherwise
    */
-  bool VMGAngle(SailingWindSpeed& ws1, SailingWindSpeed& ws2, float VW,
-                float& W);
+  bool VMGAngle(const SailingWindSpeed& ws1, const SailingWindSpeed& ws2,
+                float VW, float& W) const;
 
   /**
    * Stores boat performance data at different wind speeds.
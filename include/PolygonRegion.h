@@ -267,7 +267,7 @@ public:
    *
    * @see @ref hole_semantics "Hole Semantics" in class documentation
    */
-  bool Contains(float x, float y);
+  bool Contains(float x, float y) const;
 
   /**
    * Computes the intersection of this region with another region.
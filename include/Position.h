@@ -28,6 +28,7 @@
 #include "ConstraintChecker.h"
 
 
+class GeodesicOrigin;
 class SkipPosition;
 class WR_GribRecordSet;
 
@@ -165,10 +166,11 @@ private:
   /** Get detailed error information for debugging. */
   wxString GetDetailedErrorInfo() const;
 
-  bool rk_step(double timeseconds, double cog, double dist, double twa,
+  bool rk_step(const GeodesicOrigin& origin, double timeseconds, double cog,
+               double dist, double twa, DayLightStatus dayLight,
                RouteMapConfiguration& configuration, WR_GribRecordSet* grib,
-               const wxDateTime& time, int newpolar, double& rk_BG,
-               double& rk_dist, DataMask& data_mask);
+               int newpolar, double& rk_BG, double& rk_dist,
+               DataMask& data_mask);
   
 };
 
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#ifndef _WEATHER_ROUTING_REJECTION_HISTOGRAM_H_
+#define _WEATHER_ROUTING_REJECTION_HISTOGRAM_H_
+
+#include <wx/string.h>
+#include <json/json.h>
+
+/**
+ * Why the candidates of the isochrone computation were thrown away.
+ *
+ * Position::Propagate() tries each heading of DegreeSteps from each position
+ * of the last isochrone. The headings are counted by their angle off the
+ * bearing from the start to the destination, in buckets of BUCKET_DEGREES,
+ * along with the constraint which rejected them. Positions rejected before
+ * any heading was tried, by the swell, latitude or wind at the position or
+ * by the heuristic bound, are counted separately.
+ *
+ * Like the RoutingProfile, the counts of a step are kept in its copy of the
+ * configuration, which only the propagating thread uses, so plain counters
+ * are enough. RouteMap adds them up after each step.
+ */
+class RejectionHistogram {
+public:
+  enum Reason {
+    SEARCH_ANGLE,        /*!< Outside MaxSearchAngle of the parent heading. */
+    POLAR,               /*!< No boat speed, also in a Runge-Kutta step. */
+    MAX_COURSE_ANGLE,    /*!< Beyond MaxCourseAngle from the start. */
+    MAX_DIVERTED_COURSE, /*!< Beyond MaxDivertedCourse. */
+    CORRIDOR,            /*!< Outside the corridor. */
+    MAX_APPARENT_WIND,   /*!< Apparent wind above MaxApparentWindKnots. */
+    LAND,                /*!< Crosses land. */
+    BOUNDARY,            /*!< Enters an ocpn_draw_pi boundary. */
+    CYCLONE_TRACK,       /*!< Crosses climatology cyclone tracks. */
+    MAX_SWELL,           /*!< Position: swell above MaxSwellMeters. */
+    MAX_LATITUDE,        /*!< Position: beyond MaxLatitude. */
+    MAX_TRUE_WIND,       /*!< Position: wind above MaxTrueWindKnots. */
+    WIND_VS_CURRENT,     /*!< Position: wind against current. */
+    WIND_DATA,           /*!< Position: no wind data. */
+    HEURISTIC_BOUND,     /*!< Position: cannot beat the heuristic bound. */
+    REVERSE_REACH,       /*!< Position: outside the reverse pass. */
+    REASON_COUNT
+  };
+
+  enum { BUCKET_DEGREES = 15, BUCKET_COUNT = 180 / BUCKET_DEGREES };
+
+  RejectionHistogram() { Clear(); }
+
+  void Clear();
+  /** Adds the counts of another histogram to this one. */
+  void Add(const RejectionHistogram& histogram);
+
+  /**
+   * Bucket of a heading.
+   * @param angle Angle of the heading off the start to destination bearing,
+   * in degrees.
+   */
+  static int Bucket(double angle);
+
+  /** Counts a heading tried. */
+  void Try(int bucket) { m_Tried[bucket]++; }
+  /** Counts a heading tried and rejected. */
+  void Reject(Reason reason, int bucket) { m_Headings[reason][bucket]++; }
+  /** Counts a position rejected before trying its headings. */
+  void RejectPosition(Reason reason) { m_Positions[reason]++; }
+
+  long Tried(int bucket) const { return m_Tried[bucket]; }
+  long Tried() const;
+  long Rejected(Reason reason, int bucket) const {
+    return m_Headings[reason][bucket];
+  }
+  /** Headings rejected for a reason, in all buckets. */
+  long Rejected(Reason reason) const;
+  /** Headings rejected for any reason in a bucket. */
+  long RejectedInBucket(int bucket) const;
+  long RejectedPositions(Reason reason) const { return m_Positions[reason]; }
+
+  /** Untranslated name of a reason, for logs and data files. */
+  static const char* ReasonName(Reason reason);
+
+  /** One line summary of the reasons with rejections, for the log. */
+  wxString ToString() const;
+  /**
+   * Writes the headings tried by bucket, and the headings rejected by bucket
+   * and the positions rejected of each reason, keyed by reason name.
+   */
+  void toJson(Json::Value& json) const;
+
+private:
+  long m_Tried[BUCKET_COUNT];
+  long m_Headings[REASON_COUNT][BUCKET_COUNT];
+  long m_Positions[REASON_COUNT];
+};
+
+#endif
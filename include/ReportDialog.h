@@ -21,29 +21,93 @@
 #define _WEATHER_ROUTING_REPORT_DIALOG_H_
 
 #include <list>
+#include <map>
+#include <set>
+
+#include <wx/thread.h>
 
 #include "WeatherRoutingUI.h"
 
+class PlotData;
+class ReportThread;
 class RouteMapOverlay;
 class WeatherRouting;
 
 class ReportDialog : public ReportDialogBase {
 public:
   ReportDialog(WeatherRouting& weatherrouting);
+  ~ReportDialog();
 
   void SetRouteMapOverlays(std::list<RouteMapOverlay*> routemapoverlays);
+  /**
+   * Forgets the report metrics of a route.
+   *
+   * Must be called when a route finishes again, so only its own metrics are
+   * recomputed, and before a route is deleted, so the report thread no
+   * longer uses it.
+   */
+  void RemoveRouteMapOverlay(RouteMapOverlay* routemapoverlay);
 
   bool m_bReportStale;
 
+  /* metrics of a finished route shown in the reports */
+  struct RouteReport {
+    wxString BoatFileName, Start, End;
+    double GreatCircleDistance;
+    wxDateTime StartTime, EndTime;
+    bool HasDestination;
+    int Tacks, Jibes;
+
+    double Distance, AvgSpeed, AvgSpeedGround, AvgWind, MaxWind, AvgSwell;
+    double PercentageUpwind, PortStarboard;
+    int Comfort;
+
+    int Cyclones;  // -1 if climatology is unavailable
+    int CycloneMonths[12];
+  };
+
+  /* a route waiting for the report thread, with the plot data copied on the
+     GUI thread as RouteMapOverlay::GetPlotData() is not thread safe */
+  struct RouteReportJob {
+    RouteMapOverlay* routemapoverlay;
+    std::list<PlotData> plotdata;
+    RouteReport report;
+  };
+
+  /* used by the report thread */
+  bool NextRouteReportJob(RouteReportJob& job);
+  static void ComputeRouteReport(RouteReportJob& job);
+  void AddRouteReport(const RouteReportJob& job);
+
 protected:
   void GenerateRoutesReport();
   void OnInformation(wxCommandEvent& event);
   void OnClose(wxCommandEvent& event) { Hide(); }
 
 private:
+  void QueueRouteReport(RouteMapOverlay* routemapoverlay);
+  void StartReportThread();
+  void StopReportThread();
+  void OnReportThread(wxThreadEvent& event);
+
   wxDateTime DisplayedTime(wxDateTime t);
   wxString FormatTime(wxDateTime t);
   WeatherRouting& m_WeatherRouting;
+
+  std::list<RouteMapOverlay*> m_RouteMapOverlays;
+
+  /* only accessed from the GUI thread */
+  std::map<RouteMapOverlay*, RouteReport> m_RouteReports;
+  std::set<RouteMapOverlay*> m_PendingRouteReports;
+
+  /* shared with the report thread */
+  wxMutex m_ReportMutex;
+  std::list<RouteReportJob> m_RouteReportJobs;
+  std::list<RouteReportJob> m_FinishedRouteReports;
+  RouteMapOverlay* m_RouteReportInProgress;
+  bool m_bReportThreadDone;
+
+  ReportThread* m_ReportThread;
 };
 
 #endif
\ No newline at end of file
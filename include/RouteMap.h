@@ -24,7 +24,11 @@
 #include <wx/object.h>
 #include <wx/weakref.h>
 
+#include <chrono>
 #include <list>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "ODAPI.h"
 #include "GribRecordSet.h"
@@ -32,9 +36,12 @@
 #include "RoutePoint.h"
 #include "Position.h"
 #include "Boat.h"
+#include "RoutingProfile.h"
+#include "RejectionHistogram.h"
 
 struct RouteMapConfiguration;
 class IsoRoute;
+class IsoChron;
 
 class PlotData;
 
@@ -258,8 +265,13 @@ struct RouteMapConfiguration {
   /** Time in seconds between propagations. */
   double UsedDeltaTime;
 
-  /** The polars of the boat, used for the route calculation. */
-  Boat boat;
+  /**
+   * The polars of the boat, used for the route calculation.
+   *
+   * The boat is shared between configurations and must not be modified; see
+   * Boat::Shared(). Copying a configuration only copies the pointer.
+   */
+  std::shared_ptr<const Boat> boat;
   /** The name of the boat XML file referencing polars. */
   wxString boatFileName;
 
@@ -518,6 +530,57 @@ struct RouteMapConfiguration {
    */
   bool Anchoring;
 
+  /**
+   * If true, stop propagating positions which cannot beat the arrival time of
+   * a route known to reach the destination.
+   *
+   * The route is computed in two passes. The coarse pass, with all the
+   * constraints of the route, reaches the destination with the weather of
+   * each step. The full pass then drops the positions that cannot arrive
+   * within a time step of it. The remaining time from a position is bounded
+   * from below by the great circle distance to the destination divided by
+   * the fastest speed over ground the boat could possibly make: the polar
+   * speed extrapolated up to MaxTrueWindKnots plus the strongest current of
+   * the forecasts the coarse pass sailed through. With climatology winds
+   * there is no such bound, and nothing is pruned.
+   */
+  bool HeuristicPruning;
+
+  /**
+   * If true, the route is computed in three passes.
+   *
+   * A coarse pass finds an arrival time at the destination. A reverse pass
+   * then propagates a front backwards in time from the destination, from a
+   * step after that arrival to the start time, at full resolution, sailing
+   * the polars with the wind and current reversed and the weather of each
+   * step at its own time. Its isochrones hold the positions from which the
+   * destination can still be reached in time. The full pass propagates from
+   * the start as usual, but positions outside the backward isochrone of their
+   * time are not propagated any further. The full pass completes the route
+   * itself, so the two fronts need not be joined.
+   */
+  bool Bidirectional;
+
+  /**
+   * If true, the route is computed in two passes.
+   *
+   * The coarse pass uses a larger time step and angular resolution and does
+   * not detect land, producing a candidate track quickly. The fine pass then
+   * runs with the configured resolution, but only positions within
+   * CorridorWidth of the candidate track are explored. This gives close to
+   * full quality at a fraction of the cost on long passages. The corridor
+   * should be wide enough for the fine pass to route around any land the
+   * coarse track crosses; when the fine pass does not reach the destination
+   * within it, the fine pass is repeated without the corridor.
+   */
+  bool MultiResolution;
+
+  /**
+   * Maximum distance in nautical miles from the coarse track for positions
+   * of the fine pass of a MultiResolution route.
+   */
+  double CorridorWidth;
+
   /**
    * Do not go below this minimum True Wind angle at each step of the route
    * calculation. The default value is 0 degrees.
@@ -578,7 +641,7 @@ struct RouteMapConfiguration {
    * complexity. Smaller step sizes provide more precise routing but require
    * more calculations.
    */
-  std::list<double> DegreeSteps;
+  std::vector<double> DegreeSteps;
   /** The latitude of the starting position, in decimal degrees. */
   double StartLat;
   /** The longitude of the starting position, in decimal degrees. */
@@ -603,6 +666,51 @@ struct RouteMapConfiguration {
    */
   bool positive_longitudes;
 
+  /**
+   * Upper bound of the speed over ground in knots, used by HeuristicPruning.
+   * Zero when no bound is known.
+   */
+  double HeuristicSpeedBound;
+  /**
+   * Time in seconds from `time` to the arrival of the coarse pass at the
+   * destination plus a time step, used by HeuristicPruning. NAN when no
+   * arrival time is known. Nothing is pruned when it is not positive.
+   */
+  double HeuristicTimeBound;
+  /**
+   * True during the reverse pass of a Bidirectional route. Each step then
+   * swaps Start/End and reverses the wind and current directions.
+   */
+  bool ReverseTime;
+  /**
+   * Isochrone of the reverse pass of a Bidirectional route for the time of
+   * the step, during the full pass. Positions outside it cannot reach the
+   * destination in time. Null when there is none.
+   */
+  IsoChron* ReverseReach;
+
+  /**
+   * Track of the coarse pass of a MultiResolution route as (lat, lon) pairs,
+   * from start to destination. Empty while the coarse pass runs.
+   */
+  std::vector<std::pair<double, double>> Corridor;
+  /** Legs of Corridor by grid cell, null when there is no corridor. */
+  std::shared_ptr<const CorridorGrid> CorridorCells;
+  /**
+   * True once the coarse pass of a MultiResolution, HeuristicPruning or
+   * Bidirectional route is done and the full pass runs.
+   */
+  bool FinePass;
+
+  /**
+   * Returns true during the coarse pass of a MultiResolution, HeuristicPruning
+   * or Bidirectional route.
+   */
+  bool CoarsePass() const {
+    return (MultiResolution || HeuristicPruning || Bidirectional) &&
+           !ReverseTime && !FinePass;
+  }
+
   // parameters
   WR_GribRecordSet* grib;
 
@@ -654,6 +762,10 @@ struct RouteMapConfiguration {
   bool land_crossing;
   // Set to true if the route crossed a boundary.
   bool boundary_crossing;
+  // Time spent in the phases of the current propagation step.
+  RoutingProfile profile;
+  // Candidates thrown away in the current propagation step, and why.
+  RejectionHistogram rejections;
 };
 
 bool operator!=(const RouteMapConfiguration& c1,
@@ -756,6 +868,57 @@ public:
     return status;
   }
 
+  /** Time spent in the phases of the computation since it was reset. */
+  RoutingProfile GetProfile() {
+    Lock();
+    RoutingProfile profile = m_Profile;
+    Unlock();
+    return profile;
+  }
+  /** Time spent in the phases of each propagation step, oldest first. */
+  std::vector<RoutingProfile> GetStepProfiles() {
+    Lock();
+    std::vector<RoutingProfile> profiles = m_StepProfiles;
+    Unlock();
+    return profiles;
+  }
+  /**
+   * Time spent in the phases of the last propagation step, empty before the
+   * first one. Cheaper than copying all of GetStepProfiles().
+   */
+  RoutingProfile GetLastStepProfile() {
+    Lock();
+    RoutingProfile profile;
+    if (!m_StepProfiles.empty()) profile = m_StepProfiles.back();
+    Unlock();
+    return profile;
+  }
+  /** Candidates rejected since the computation was reset, and why. */
+  RejectionHistogram GetRejections() {
+    Lock();
+    RejectionHistogram rejections = m_Rejections;
+    Unlock();
+    return rejections;
+  }
+  /** Candidates rejected in each propagation step, oldest first. */
+  std::vector<RejectionHistogram> GetStepRejections() {
+    Lock();
+    std::vector<RejectionHistogram> rejections = m_StepRejections;
+    Unlock();
+    return rejections;
+  }
+  /**
+   * Candidates rejected in the last propagation step, empty before the first
+   * one. Cheaper than copying all of GetStepRejections().
+   */
+  RejectionHistogram GetLastStepRejections() {
+    Lock();
+    RejectionHistogram rejections;
+    if (!m_StepRejections.empty()) rejections = m_StepRejections.back();
+    Unlock();
+    return rejections;
+  }
+
   /**
    * Thread-safe accessor to check if there was insufficient weather data for
    * the calculation.
@@ -840,6 +1003,7 @@ public:
     m_Configuration = o;
     m_bValid = m_Configuration.Update();
     m_bFinished = false;
+    UpdateConfigurationSnapshot();
     Unlock();
   }
   RouteMapConfiguration GetConfiguration() {
@@ -848,6 +1012,22 @@ public:
     Unlock();
     return o;
   }
+  /**
+   * Thread-safe accessor to a shared, immutable copy of the configuration.
+   *
+   * Unlike GetConfiguration() this does not copy the configuration, so it is
+   * the accessor to use from renderers and dialogs which only read it. The
+   * snapshot stays valid for as long as the caller holds it, even if the
+   * configuration of the route map is changed meanwhile.
+   *
+   * @return The configuration as of the last change.
+   */
+  std::shared_ptr<const RouteMapConfiguration> GetConfigurationSnapshot() {
+    Lock();
+    std::shared_ptr<const RouteMapConfiguration> o = m_ConfigurationSnapshot;
+    Unlock();
+    return o;
+  }
 
   void GetStatistics(int& isochrones, int& routes, int& invroutes,
                      int& skippositions, int& positions);
@@ -917,9 +1097,7 @@ public:
    *
    * @return Error message if loading failed, or empty string on success
    */
-  wxString LoadBoat() {
-    return m_Configuration.boat.OpenXML(m_Configuration.boatFileName);
-  }
+  wxString LoadBoat();
 
   // XXX Isn't wxString refcounting thread safe?
   wxString GetError() {
@@ -956,6 +1134,23 @@ public:
    */
   wxString GetRoutingErrorInfo();
 
+  /**
+   * Prepares the next pass of a MultiResolution, HeuristicPruning or
+   * Bidirectional route.
+   *
+   * If the coarse pass has reached the destination, its track is kept as the
+   * corridor for the fine pass of a MultiResolution route, and its arrival
+   * time as the bound of a HeuristicPruning route. A Bidirectional route
+   * first runs the reverse pass from a step after that arrival, whose
+   * isochrones are then kept for the fine pass. Without an arrival the fine
+   * pass is run unrestricted, as it is again when a restricted fine pass did
+   * not reach the destination. The map is reset so the calculation can be
+   * started again.
+   *
+   * @return true if another pass must be run, false otherwise
+   */
+  bool StartFinePass();
+
 protected:
   void SetFinished(bool destination) {
     m_bReachedDestination = destination;
@@ -973,6 +1168,11 @@ protected:
     if (configuration.boundary_crossing) m_bBoundaryCrossing = true;
 
     if (configuration.land_crossing) m_bLandCrossing = true;
+
+    m_Profile.Add(configuration.profile);
+    m_StepProfiles.push_back(configuration.profile);
+    m_Rejections.Add(configuration.rejections);
+    m_StepRejections.push_back(configuration.rejections);
   }
 
   virtual void Clear();
@@ -1020,6 +1220,44 @@ protected:
    */
   double DetermineDeltaTime();
 
+  /**
+   * Computes the bounds used by HeuristicPruning for the next propagation.
+   *
+   * The speed bound combines the fastest boat speed the polars give up to
+   * the maximum true wind (with efficiency factors and motoring applied) with
+   * the strongest current seen so far, which covers the forecasts of the
+   * coarse pass up to its arrival. The arrival bound is only known in the
+   * full pass, from the arrival of the coarse pass.
+   *
+   * @param configuration [in,out] Configuration for the next propagation, the
+   * HeuristicSpeedBound and HeuristicTimeBound fields are updated.
+   */
+  void UpdateHeuristicBounds(RouteMapConfiguration& configuration);
+
+  /**
+   * Returns the isochrone of the reverse pass of a Bidirectional route with
+   * the latest time not after the given time, or null when there is none.
+   *
+   * The backward isochrones grow as their time gets earlier, so this is the
+   * smallest one still holding every position the destination can be
+   * reached from in time when leaving at `time`.
+   */
+  IsoChron* ReverseReach(const wxDateTime& time);
+
+  /**
+   * Marks the route map as finished after its isochrones were restored from a
+   * snapshot instead of being computed.
+   *
+   * @param reached_destination Whether the restored route reached the
+   * destination.
+   */
+  void SetRestored(bool reached_destination) {
+    m_bValid = true;
+    m_bFinished = true;
+    m_bReachedDestination = reached_destination;
+    m_bNeedsGrib = false;
+  }
+
   /**
    * List of isochrones in chronological order.
    *
@@ -1039,7 +1277,15 @@ private:
   void CollectPositionErrors(Position* position,
                              std::vector<Position*>& failed_positions);
 
+  /** Publishes m_Configuration to readers; must be called with the lock. */
+  void UpdateConfigurationSnapshot() {
+    m_ConfigurationSnapshot =
+        std::make_shared<const RouteMapConfiguration>(m_Configuration);
+  }
+
   RouteMapConfiguration m_Configuration;
+  /** Immutable copy of m_Configuration shared with the readers. */
+  std::shared_ptr<const RouteMapConfiguration> m_ConfigurationSnapshot;
   bool m_bFinished, m_bValid;
   bool m_bReachedDestination;
   /**
@@ -1073,10 +1319,32 @@ private:
   wxString m_bGribError;
   bool m_bLandCrossing;
   bool m_bBoundaryCrossing;
+  RoutingProfile m_Profile;
+  std::vector<RoutingProfile> m_StepProfiles;
+  RejectionHistogram m_Rejections;
+  std::vector<RejectionHistogram> m_StepRejections;
+  // When the last grib was requested, to profile the wait for it.
+  std::chrono::steady_clock::time_point m_GribRequestTime;
 
   wxString m_ErrorMsg;
 
   wxDateTime m_NewTime;
+
+  /** Strongest current in knots seen in the GRIB data, for HeuristicPruning. */
+  double m_HeuristicMaxCurrent;
+  /** Last GRIB record set scanned for m_HeuristicMaxCurrent. */
+  WR_GribRecordSet* m_HeuristicGrib;
+  /**
+   * Arrival at the destination of the coarse pass, during the reverse and
+   * full passes of a route which has them. Invalid otherwise.
+   */
+  wxDateTime m_HeuristicArrival;
+
+  /**
+   * Isochrones of the reverse pass of a Bidirectional route during its full
+   * pass, from the destination backwards in time to the start.
+   */
+  IsoChronList m_ReverseOrigin;
 };
 
 #endif
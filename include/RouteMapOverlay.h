@@ -20,6 +20,18 @@
 #ifndef _WEATHER_ROUTING_ROUTE_MAP_OVERLAY_H_
 #define _WEATHER_ROUTING_ROUTE_MAP_OVERLAY_H_
 
+#include <wx/geometry.h>
+#include <wx/stopwatch.h>
+#include <wx/thread.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "RouteMap.h"
 #include "LineBufferOverlay.h"
 
@@ -53,6 +65,33 @@ private:
   RouteMapOverlay& m_RouteMapOverlay;
 };
 
+/**
+ * Thread sampling the wind and current overlay tiles requested by
+ * RouteMapOverlay::RenderWindBarbs() and RouteMapOverlay::RenderCurrent().
+ *
+ * Searching the isochrones and the GRIB for every arrow is too slow for the
+ * GUI thread, so rendering only draws the tiles sampled so far and queues
+ * the missing ones for this thread.
+ */
+class OverlayTileThread : public wxThread {
+public:
+  /**
+   * Constructor for the thread.
+   * @param routemapoverlay Reference to the RouteMapOverlay owning the tiles.
+   */
+  OverlayTileThread(RouteMapOverlay& routemapoverlay);
+
+  /**
+   * Thread entry point, samples requested tiles until the thread is deleted.
+   * @return Thread exit code.
+   */
+  void* Entry();
+
+private:
+  /** Reference to the RouteMapOverlay owning the tiles. */
+  RouteMapOverlay& m_RouteMapOverlay;
+};
+
 /**
  * The central class for weather routing calculation, visualization, and
  * analysis.
@@ -105,6 +144,7 @@ private:
  */
 class RouteMapOverlay : public RouteMap {
   friend class RouteMapOverlayThread;
+  friend class OverlayTileThread;
 
 public:
   /**
@@ -130,6 +170,8 @@ public:
     SAIL_PLAN_CHANGES,  //!< Number of sail changes performed
     COMFORT             //!< Sailing comfort level
   };
+  /** Number of route information types. */
+  static const int ROUTE_INFO_TYPES = COMFORT + 1;
 
   /**
    * Default constructor.
@@ -218,12 +260,27 @@ public:
 
   /**
    * Gets specific route information based on type.
+   *
+   * All types are computed together in one pass over the plot data and
+   * cached until the plot data changes.
    * @param type Type of information to retrieve.
    * @param cursor_route If true, gets info for cursor route, otherwise for
    * destination route.
    * @return The requested route information value.
    */
   double RouteInfo(enum RouteInfoType type, bool cursor_route = false);
+  /**
+   * Computes every type of route information from a copy of the route's plot
+   * data in one pass.
+   *
+   * Unlike the overload above this does not touch the plot data caches, so
+   * it can be called from a worker thread with data obtained earlier from
+   * GetPlotData() on the GUI thread.
+   * @param plotdata The plot data of the route.
+   * @param info Receives the route information, indexed by RouteInfoType.
+   */
+  void RouteInfo(const std::list<PlotData>& plotdata,
+                 double info[ROUTE_INFO_TYPES]);
 
   /**
    * Counts the number of cyclone track crossings.
@@ -279,6 +336,54 @@ public:
    */
   virtual void Clear();
 
+  /**
+   * Saves the isochrones of a finished route map to a binary snapshot file.
+   *
+   * The snapshot holds every isochrone with its positions, parent links,
+   * polar indices and data masks, the reference time and id of the GRIB used
+   * for each step, the destination and the plot data of the route to it.
+   * The GRIB data itself is not saved.
+   *
+   * @param filename The file to write.
+   * @param fingerprint Identifies the configuration of the route.
+   * @return true on success.
+   */
+  bool SaveSnapshot(const wxString& filename, uint64_t fingerprint);
+
+  /**
+   * Replaces the route map with the isochrones of a snapshot file written by
+   * SaveSnapshot(), so a finished route does not have to be computed again.
+   *
+   * Nothing is changed if the file cannot be read, was written by a
+   * different snapshot version, is corrupt, was saved for a different
+   * configuration, or the GRIB plugin now has a different GRIB file for the
+   * start of the route. The GRIB is requested with RequestGrib(), the caller
+   * must route the reply to this route map.
+   *
+   * @param filename The file to read.
+   * @param fingerprint Identifies the configuration of the route, as passed
+   * to SaveSnapshot().
+   * @param error Set to the reason of a failure.
+   * @return true on success.
+   */
+  bool LoadSnapshot(const wxString& filename, uint64_t fingerprint,
+                    wxString& error);
+
+  /**
+   * Gets the snapshot file holding the current isochrones.
+   * @return The file last saved or loaded, empty if the isochrones changed
+   * since.
+   */
+  wxString SnapshotFileName() { return m_SnapshotFileName; }
+  /** Gets the configuration fingerprint of SnapshotFileName(). */
+  uint64_t SnapshotFingerprint() { return m_SnapshotFingerprint; }
+
+  /**
+   * Removes the snapshot file of the current isochrones, when the route is
+   * reset or deleted.
+   */
+  void DeleteSnapshot();
+
   /**
    * Locks the route map for thread-safe access.
    */
@@ -357,6 +462,106 @@ public:
   const IsoChronList& GetIsoChronList() const { return origin; }
 
 private:
+  /**
+   * Line segments of the isochrones at one level of detail, ready to draw.
+   *
+   * Isochrones never change once propagated, so each one is converted to
+   * vertices only once per level and new isochrones are appended as they
+   * arrive.
+   */
+  struct IsoChronVertexCache {
+    /** Segment end points (x, y pairs) in Mercator meters. */
+    std::vector<float> vertices;
+
+    /** RGBA color of each vertex. */
+    std::vector<unsigned char> colors;
+
+    /**
+     * Isochrones in the cache, in origin order, each with the index one past
+     * its last vertex.
+     */
+    std::vector<std::pair<const IsoChron*, size_t>> isochrons;
+
+    /** Appends a vertex. */
+    void Push(const wxPoint2DDouble& p, const wxColour& c);
+
+    /** Drops the isochrone at index n and all that follow it. */
+    void Truncate(size_t n);
+  };
+
+  /** Weather fields drawn as tiled arrow overlays. */
+  enum OverlayField { WIND_OVERLAY, CURRENT_OVERLAY };
+
+  /**
+   * Identifies an overlay tile.
+   *
+   * Tiles are laid out in Mercator meters from the start position. A tile
+   * has OVERLAY_TILE_CELLS grid cells per side and each cell is 2^level
+   * meters, so zooming within a factor of two reuses the same tiles.
+   */
+  struct OverlayTileKey {
+    int field;  //!< OverlayField of the arrows
+    int level;  //!< Cell size as a power of two meters
+    int x, y;   //!< Tile indices
+
+    bool operator<(const OverlayTileKey& o) const {
+      return std::tie(field, level, x, y) <
+             std::tie(o.field, o.level, o.x, o.y);
+    }
+  };
+
+  /** Weather at one grid point of an overlay tile. */
+  struct OverlayArrow {
+    double lat, lon;
+    double direction;  //!< Degrees, interpolated between two isochrones
+    double speed;      //!< Knots
+  };
+
+  /** Arrows sampled for one overlay tile. */
+  struct OverlayTile {
+    std::vector<OverlayArrow> arrows;
+
+    /** Time of the last isochrone when the tile was sampled. */
+    wxDateTime time;
+
+    /**
+     * True if every grid point was inside the isochrones. Incomplete tiles
+     * are sampled again once newer isochrones cover more of them.
+     */
+    bool complete;
+  };
+
+  /**
+   * Draws the arrows of a weather field from the tiles sampled so far.
+   *
+   * Queues the tiles in view that are missing or stale for the tile thread.
+   * Never touches the isochrones or the GRIB beyond reading their bounds.
+   * @param field The OverlayField to draw.
+   * @param dc Device context for drawing.
+   * @param vp ViewPort for coordinate transformations.
+   */
+  void RenderOverlayField(OverlayField field, piDC& dc, PlugIn_ViewPort& vp);
+
+  /**
+   * Takes the next tile request, waiting a little if there is none.
+   * Called by the tile thread.
+   * @param key Set to the tile to sample.
+   * @return False if there was no request.
+   */
+  bool NextOverlayTileRequest(OverlayTileKey& key);
+
+  /**
+   * Samples the wind or current at every grid point of a tile inside the
+   * isochrones and stores the tile. Called by the tile thread.
+   * @param key The tile to sample.
+   */
+  void SampleOverlayTile(const OverlayTileKey& key);
+
+  /**
+   * Stops the tile thread and waits until it is deleted.
+   */
+  void DeleteOverlayTileThread();
+
   /**
    * Renders an alternate route.
    * @param r Pointer to the route to render.
@@ -380,6 +585,39 @@ private:
                       wxColour& climatology_color, piDC& dc,
                       PlugIn_ViewPort& vp);
 
+  /**
+   * Appends the segments of an isochrone route to a vertex cache.
+   *
+   * Emits the same segments and colors as RenderIsoRoute(), in the frame of
+   * the cache viewport. Above level 0 the route is first simplified with
+   * Douglas-Peucker, so zoomed-out views draw a fraction of the positions.
+   * @param r Pointer to the route to cache.
+   * @param grib_color Color for grib-based segments.
+   * @param climatology_color Color for climatology-based segments.
+   * @param cvp Cache viewport: Mercator centered on the start position,
+   * unrotated, at a constant scale.
+   * @param lod Level of detail, the cache in isochron_cache to append to.
+   */
+  void CacheIsoRoute(IsoRoute* r, wxColour& grib_color,
+                     wxColour& climatology_color, PlugIn_ViewPort& cvp,
+                     int lod);
+
+  /**
+   * Draws the cached isochrones with a single transform for the viewport.
+   *
+   * The cache is independent of panning, zooming and rotation. With OpenGL
+   * the current view is applied through the modelview matrix.
+   * @param cache The cache to draw.
+   * @param closest Isochrone to draw thicker, or nullptr.
+   * @param thickness Isochrone line thickness.
+   * @param dc Device context for drawing.
+   * @param vp ViewPort to draw into.
+   * @param cvp Cache viewport the vertices were computed in.
+   */
+  void RenderIsoChronCache(const IsoChronVertexCache& cache,
+                           const IsoChron* closest, int thickness, piDC& dc,
+                           PlugIn_ViewPort& vp, PlugIn_ViewPort& cvp);
+
   /**
    * Renders markers at points where the polar changes.
    * @param cursor_route If true, renders for cursor route, otherwise for
@@ -553,17 +791,40 @@ private:
   /** Plot data for the cursor route. */
   std::list<PlotData> last_cursor_plotdata;
 
-  /** Line buffer for wind barb caching. */
-  LineBuffer wind_barb_cache;
+  /** Route information computed from the plot data by RouteInfo(). */
+  struct RouteInfoCache {
+    bool valid = false;
+    bool finished = false;  //!< Finished() when computed, affects DISTANCE
+    double info[ROUTE_INFO_TYPES];
+  };
+
+  /** Route information of the destination [0] and cursor [1] routes. */
+  RouteInfoCache m_RouteInfoCache[2];
+
+  /** Forgets the route information after the plot data changed. */
+  void InvalidateRouteInfo();
 
-  /** Scale factor for wind barb cache. */
-  double wind_barb_cache_scale;
+  /**
+   * Plot data of every leg computed so far, keyed by the position ending the
+   * leg.
+   *
+   * Routes to nearby cursor positions share most of their legs with each
+   * other and with the route to the destination, so GetPlotData() only has
+   * to sample the weather for legs it has not seen before. Cleared whenever
+   * the positions or the destination change.
+   */
+  std::unordered_map<const Position*, PlotData> m_LegPlotData;
 
-  /** Original size of the origin list when the wind barb cache was created. */
-  size_t wind_barb_cache_origin_size;
+  /** Snapshot file matching the current isochrones, see SaveSnapshot(). */
+  wxString m_SnapshotFileName;
+  /** Configuration fingerprint stored in m_SnapshotFileName. */
+  uint64_t m_SnapshotFingerprint;
 
-  /** Projection type for the wind barb cache. */
-  int wind_barb_cache_projection;
+  /**
+   * Isochrone vertex caches by level of detail. Only the levels of the
+   * scales viewed so far are built. Cleared with the isochrones.
+   */
+  std::unordered_map<int, IsoChronVertexCache> isochron_cache;
 
   /** Line buffer for wind barbs along the route. */
   LineBuffer wind_barb_route_cache;
@@ -571,17 +832,33 @@ private:
   /** Current sailing comfort level. */
   int m_sailingComfort;
 
-  /** Line buffer for current arrow caching. */
-  LineBuffer current_cache;
+  /** Sampled overlay tiles, see OverlayTileKey. */
+  std::map<OverlayTileKey, OverlayTile> m_OverlayTiles;
+
+  /** Tiles waiting for the tile thread, those in view first. */
+  std::deque<OverlayTileKey> m_OverlayTileRequests;
+
+  /**
+   * Incremented whenever the isochrones are cleared, so tiles sampled from
+   * the old isochrones are dropped instead of stored.
+   */
+  unsigned int m_OverlayTileGeneration;
+
+  /**
+   * Protects m_OverlayTiles, m_OverlayTileRequests and
+   * m_OverlayTileGeneration. When both are needed, take the route map lock
+   * first.
+   */
+  wxMutex m_OverlayTileMutex;
 
-  /** Scale factor for current cache. */
-  double current_cache_scale;
+  /** Signaled when tiles are requested. */
+  wxCondition m_OverlayTileCondition;
 
-  /** Original size of the origin list when the current cache was created. */
-  size_t current_cache_origin_size;
+  /** Thread sampling the requested tiles, started on the first request. */
+  OverlayTileThread* m_OverlayTileThread;
 
-  /** Projection type for the current cache. */
-  int current_cache_projection;
+  /** Time since the tile thread last asked for a redraw. */
+  wxStopWatch m_OverlayTileRefresh;
 };
 
 #endif
@@ -25,6 +25,7 @@
 #include <json/json.h>
 
 #include "ConstraintChecker.h"
+#include "SunCalculator.h"
 
 struct RouteMapConfiguration;
 class PlotData;
@@ -148,14 +149,25 @@ public:
   double currentSpeed;
   double swell;
   climatology_wind_atlas atlas;
+  /** Day or night at the position, only looked up when the night efficiency
+   * applies. It does not depend on the heading, so it is read once with the
+   * weather rather than for each heading. */
+  DayLightStatus dayLight;
 
   WeatherData(RoutePoint* position);
 
+  /**
+   * Reads the weather at the position and checks the constraints on it.
+   * @param lookup_daylight Whether to look up dayLight. Without, the caller
+   * sets it, as the Runge-Kutta steps do with the day or night status of
+   * the position they start from.
+   */
   bool ReadWeatherDataAndCheckConstraints(RouteMapConfiguration& configuration,
                                           RoutePoint* position,
                                           DataMask& data_mask,
                                           PropagationError& error_code,
-                                          bool end);
+                                          bool end,
+                                          bool lookup_daylight = true);
 };
 
 /**
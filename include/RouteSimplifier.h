@@ -22,9 +22,13 @@
 
 #include "RouteMap.h"
 class RouteMapOverlay;
+#include <functional>
 #include <list>
+#include <map>
+#include <unordered_map>
 #include <vector>
 #include <wx/string.h>
+#include <wx/thread.h>
 
 /**
  * Parameters for route simplification.
@@ -33,6 +37,7 @@ struct SimplificationParams {
   double maxDurationPenaltyPercent =
       0.05;                //!< Maximum acceptable duration penalty (%)
   int maxIterations = 15;  //!< Maximum optimization iterations
+  int threads = 0;  //!< Threads of the parallel loops, 0 for one per CPU
 
   SimplificationParams() = default;
   SimplificationParams(double durationPenaltyPercent, int iterations)
@@ -82,6 +87,10 @@ struct RouteSegment {
  * - Ensures segments remain navigable under weather conditions
  * - Optimizes for minimal time penalty
  * - Uses adaptive epsilon adjustment for optimal results
+ *
+ * The maneuver segments and the candidate endpoints of alternate routes are
+ * processed in parallel. Segment validations are memoized, as the alternate
+ * route searches and the waypoint insertion check the same segments again.
  */
 class RouteSimplifier {
 public:
@@ -118,6 +127,40 @@ public:
    */
   size_t GetOriginalWayPointCount() const { return m_originalRoute.size(); }
 
+  /** Segment checks and final legs found in the memo. */
+  long GetMemoHits() const { return m_memoHits; }
+  /** Segment checks and final legs computed and added to the memo. */
+  long GetMemoMisses() const { return m_memoMisses; }
+
+  /** Endpoint of the last isochrone from which the destination is reached. */
+  struct RouteCandidate {
+    Position* pos;    //!< Endpoint in the last isochrone
+    double seconds;   //!< Arrival at the destination from the start
+    int tacks;        //!< Tacks from the start to the endpoint
+    int jibes;        //!< Jibes from the start to the endpoint
+    int sailChanges;  //!< Sail plan changes from the start to the endpoint
+
+    int Maneuvers() const { return tacks + jibes + sailChanges; }
+  };
+
+  /**
+   * Keep the candidates which are Pareto optimal in arrival time and
+   * maneuvers, within the duration penalty.
+   *
+   * Sorts the candidates by arrival time, then by maneuvers, and sweeps
+   * them, keeping each one with fewer maneuvers than all faster ones. Of
+   * candidates arriving at the same time only one with the fewest
+   * maneuvers is kept.
+   * @param candidates Endpoints reaching the destination, in any order
+   * @param originalSeconds Duration of the original route
+   * @param maxDurationPenaltyPercent Candidates arriving later than this
+   * fraction past the original duration are dropped
+   * @return Candidates by increasing arrival time and decreasing maneuvers
+   */
+  static std::vector<RouteCandidate> ParetoFrontier(
+      std::vector<RouteCandidate> candidates, double originalSeconds,
+      double maxDurationPenaltyPercent);
+
 private:
   /**
    * Find alternate routes with different maneuver characteristics.
@@ -187,6 +230,15 @@ private:
    */
   bool ValidateSegment(Position* start, Position* end, Position*& validatedEnd);
 
+  /**
+   * ValidateSegment() without the memoization.
+   * @param start Start position
+   * @param end End position
+   * @param validatedEnd Output: validated end position
+   * @return true if segment is valid, false otherwise
+   */
+  bool CheckSegment(Position* start, Position* end, Position*& validatedEnd);
+
   /**
    * Advanced validation using detailed propagation.
    * @param start Start position
@@ -242,6 +294,18 @@ private:
    */
   void ApplyDouglasPeucker(std::list<Position*>& route, double epsilon);
 
+  /**
+   * Simplify one maneuver segment with Douglas-Peucker, and split the long
+   * legs of the result along their rhumb lines.
+   *
+   * Segments are independent, this is called for several at once.
+   * @param segment Segment to simplify, with at least 3 points
+   * @param epsilon Distance threshold
+   * @return Simplified segment
+   */
+  std::list<Position*> SimplifySegment(const RouteSegment& segment,
+                                       double epsilon);
+
   /**
    * Recursive Douglas-Peucker implementation.
    * @param waypoints Vector of positions
@@ -296,18 +360,38 @@ private:
                                            const wxDateTime& startTime) const;
 
   /**
-   * Find an alternate path through existing isochrones with fewer maneuvers.
+   * Find the endpoints of the isochrones which are Pareto optimal in arrival
+   * time and maneuvers, within the duration penalty.
+   *
+   * The positions of the isochrones form a tree through their parents, and
+   * the maneuver counts of a position are cumulative along it, so the cost
+   * of every path is read at its endpoint: a sort by arrival time and one
+   * sweep give the frontier, without building the route of each endpoint.
+   * @param params Simplification parameters
    * @param isochrones List of existing isochrones
+   * @return Endpoints by increasing arrival time and decreasing maneuvers
+   */
+  std::vector<RouteCandidate> FindParetoAlternates(
+      const SimplificationParams& params, const IsoChronList& isochrones);
+
+  /**
+   * Find the alternate path through existing isochrones which minimizes the
+   * arrival time plus the maneuver durations of a configuration.
+   * @param frontier Pareto optimal endpoints from FindParetoAlternates()
    * @param config Configuration with modified maneuver penalties
-   * @param destination Original destination position
    * @param result [out] Alternate route if found
    * @return true if a valid alternate path was found
    */
-  bool FindAlternatePathThroughIsochrones(const SimplificationParams& params,
-                                          const IsoChronList& isochrones,
-                                          const RouteMapConfiguration& config,
-                                          Position* destination,
-                                          RouteStats& result);
+  bool FindAlternatePathThroughIsochrones(
+      const std::vector<RouteCandidate>& frontier,
+      const RouteMapConfiguration& config, RouteStats& result);
+
+  /**
+   * Build the route to the destination through an endpoint.
+   * @param candidate Endpoint from FindParetoAlternates()
+   * @return Route with its duration and maneuvers
+   */
+  RouteStats BuildAlternateRoute(const RouteCandidate& candidate);
 
   /**
    * Find an alternate path through existing isochrones with fewer maneuvers.
@@ -323,6 +407,44 @@ private:
                          Position* destination, double penaltyAmount,
                          RouteStats& result);
 
+  /**
+   * Memoized time to sail from a position of the last isochrone to the
+   * destination.
+   * @param pos Position to sail from
+   * @param destination Destination position
+   * @return Time in seconds, NaN if the destination cannot be reached
+   */
+  double PropagateToDestination(Position* pos, Position* destination);
+
+  /**
+   * Run the iterations of a loop on all processors.
+   * @param count Number of iterations
+   * @param threads Number of threads, 0 for one per CPU
+   * @param body Called with each iteration index, from several threads
+   */
+  static void ParallelFor(size_t count, int threads,
+                          const std::function<void(size_t)>& body);
+
+  /** Keep a position created during simplification, for cleanup. */
+  void AddNewPosition(Position* pos);
+
+  /** Key of a memoized segment validation. */
+  struct SegmentKey {
+    const Position* start;
+    const Position* end;
+    /** Time the weather is read at. */
+    wxLongLong time;
+
+    bool operator<(const SegmentKey& other) const;
+  };
+  SegmentKey MakeSegmentKey(const Position* start, const Position* end) const;
+
+  /** Result of a memoized ValidateSegment(). */
+  struct SegmentValidation {
+    bool valid;
+    Position* validatedEnd;
+  };
+
   RouteMapOverlay* m_routemap;
   RouteMapConfiguration m_configuration;
   /** Original route configuration. */
@@ -331,6 +453,16 @@ private:
   std::list<Position*> m_simplifiedRoute;
 
   std::vector<Position*> m_newPositions;
+
+  /** Time from the start of each position of the isochrones. */
+  std::unordered_map<const Position*, wxTimeSpan> m_positionTimes;
+  std::map<SegmentKey, SegmentValidation> m_segmentValidations;
+  /** Memoized PropagateToDestination() results, in seconds. */
+  std::map<SegmentKey, double> m_destinationTimes;
+  long m_memoHits = 0;
+  long m_memoMisses = 0;
+  /** Guards m_newPositions, the memoized validations and their counts. */
+  wxMutex m_mutex;
 };
 
 #endif
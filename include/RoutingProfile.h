@@ -0,0 +1,121 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#ifndef _WEATHER_ROUTING_ROUTING_PROFILE_H_
+#define _WEATHER_ROUTING_ROUTING_PROFILE_H_
+
+#include <chrono>
+
+#include <wx/string.h>
+#include <json/json.h>
+
+/**
+ * Time spent in the phases of the isochrone computation.
+ *
+ * RouteMap::Propagate() measures the phases of each step in the profile of
+ * its copy of the configuration, then adds it to the cumulative profile of
+ * the route map along with the other results of the step.
+ *
+ * The phases nest: reading the weather, looking up the polars and checking
+ * the constraints happen while propagating, so their time is also part of
+ * PROPAGATE.
+ *
+ * The constraint checks which are a few comparisons are only counted, as
+ * reading the clock would take longer than the checks themselves.
+ */
+class RoutingProfile {
+public:
+  enum Phase {
+    PROPAGATE, /*!< Propagating the positions of the last isochrone. */
+    MERGE,     /*!< Merging and normalizing the propagated routes. */
+    WEATHER,   /*!< Reading the wind and current at a position. */
+    POLAR,     /*!< Choosing the sail plan and looking up the boat speed. */
+    LAND,      /*!< Testing a step for GSHHS land crossings. */
+    BOUNDARY,  /*!< Testing a step for ocpn_draw_pi boundary crossings. */
+    GRIB_WAIT, /*!< Waiting for the main thread to provide the next grib. */
+    CHECK_SWELL,
+    CHECK_MAX_LATITUDE,
+    CHECK_MAX_TRUE_WIND,
+    CHECK_MAX_APPARENT_WIND,
+    CHECK_WIND_VS_CURRENT,
+    CHECK_MAX_COURSE_ANGLE,
+    CHECK_MAX_DIVERTED_COURSE,
+    CHECK_CORRIDOR,
+    CHECK_HEURISTIC_BOUND,
+    CHECK_CYCLONE_TRACK,
+    PHASE_COUNT
+  };
+
+  RoutingProfile() { Clear(); }
+
+  void Clear();
+  /** Adds the time and calls of another profile to this one. */
+  void Add(const RoutingProfile& profile);
+
+  void Record(Phase phase, double seconds) {
+    m_Seconds[phase] += seconds;
+    m_Calls[phase]++;
+  }
+  /** Counts a call of a phase which is not timed. */
+  void Count(Phase phase) { m_Calls[phase]++; }
+
+  /** Total time spent in a phase, in seconds. */
+  double Seconds(Phase phase) const { return m_Seconds[phase]; }
+  /** Number of times a phase was entered. */
+  long Calls(Phase phase) const { return m_Calls[phase]; }
+
+  /** Untranslated name of a phase, for logs and data files. */
+  static const char* PhaseName(Phase phase);
+  /** Returns false for the phases which are only counted. */
+  static bool Timed(Phase phase);
+
+  /** One line summary of the phases with calls, for the log. */
+  wxString ToString() const;
+  /** Writes the seconds and calls of each phase, keyed by phase name. */
+  void toJson(Json::Value& json) const;
+
+private:
+  double m_Seconds[PHASE_COUNT];
+  long m_Calls[PHASE_COUNT];
+};
+
+/**
+ * Records the time from its construction to its destruction in a phase of a
+ * profile.
+ */
+class RoutingPhaseTimer {
+public:
+  RoutingPhaseTimer(RoutingProfile& profile, RoutingProfile::Phase phase)
+      : m_Profile(profile),
+        m_Phase(phase),
+        m_Start(std::chrono::steady_clock::now()) {}
+
+  ~RoutingPhaseTimer() {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - m_Start;
+    m_Profile.Record(m_Phase, elapsed.count());
+  }
+
+private:
+  RoutingProfile& m_Profile;
+  RoutingProfile::Phase m_Phase;
+  std::chrono::steady_clock::time_point m_Start;
+};
+
+#endif
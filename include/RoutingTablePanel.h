@@ -73,7 +73,8 @@ public:
   void UpdateTimeHighlight(wxDateTime timelineTime);
 
   /**
-   * Export the table data to Excel XML format with formatting preserved
+   * Export the table data to Excel XML format with formatting preserved, or
+   * to CSV when a .csv file is chosen
    */
   void ExportToExcel();
 
@@ -91,35 +92,16 @@ private:
   void OnExportButton(wxCommandEvent& event);
 
   /**
-   * Helper function to format and display sail plan information
-   *
-   * @param row Current row in the table
-   * @param data Plot data for the current point
-   * @param configuration Current route configuration
-   * @param prevData Previous point's plot data (nullptr if this is first point)
+   * Grid table formatting the cells on demand from a copy of the plot data,
+   * defined in RoutingTablePanel.cpp.
    */
-  void handleSailPlanCell(int row, const PlotData& data,
-                          const RouteMapConfiguration& configuration,
-                          const PlotData* prevData);
-  /** Helper function to set cell value with colored background. */
-  void setCellWithColor(int row, int col, const wxString& value,
-                        const wxColor& bgColor);
+  class WeatherTable;
 
   /**
-   * Helper function to set cell value with time-of-day background color.
-   * This method uses the SunCalculator to determine appropriate colors based on
-   * the time of day and daylight status at the given location.
-   *
-   * @param row Grid row number
-   * @param col Grid column number
-   * @param value Text value to display in the cell
-   * @param dateTime UTC time for this route point
-   * @param lat Latitude of the route point
-   * @param lon Longitude of the route point
+   * Sizes the columns to fit their label and a sample of the rows. Measuring
+   * every row would format every cell of the table.
    */
-  void setCellWithTimeOfDayColor(int row, int col, const wxString& value,
-                                 const wxDateTime& dateTime, double lat,
-                                 double lon);
+  void AutoSizeColumns();
 
   /** Helper functions for Excel export */
   wxString ConvertColorToHex(const wxColour& color);
@@ -128,8 +110,8 @@ private:
   bool WriteExcelXML(const wxString& filename);
   bool WriteXLSX(const wxString& filename);
   bool WriteSimpleXML(const wxString& filename);
-  wxString CreateStylesXML();
-  wxString CreateWorksheetXML();
+  /** Writes the table as comma separated values, one line per row */
+  bool WriteCSV(const wxString& filename);
   wxString GetCellReference(int row, int col);
 
   /** Helper functions for cell styling in Excel export */
@@ -153,10 +135,25 @@ private:
     }
   };
 
-  CellStyle GetCellStyle(int row, int col);
+  /**
+   * Formats a cell of the table for export. The cell is formatted once for
+   * both its text and its style.
+   *
+   * @param row Grid row number
+   * @param col Grid column number
+   * @param style [out] Colors of the cell
+   * @return The text of the cell
+   */
+  wxString GetExportCell(int row, int col, CellStyle& style);
   int GetOrCreateStyleId(const CellStyle& style);
-  wxString CreateStylesXMLWithColors();
-  wxString CreateWorksheetXMLWithColors();
+
+  /**
+   * Streams the XLSX worksheet to a zip entry row by row, adding the styles
+   * of its cells to m_styles. The style sheet is written afterwards from
+   * m_styles, so the table is only formatted once.
+   */
+  bool WriteWorksheetXML(wxOutputStream& out);
+  bool WriteStylesXML(wxOutputStream& out);
 
   /** Helper function to create summary tab */
   void CreateSummaryTab();
@@ -254,15 +251,12 @@ private:
   wxButton* m_exportButton;
 
   wxGrid* m_gridWeatherTable;
+  WeatherTable* m_weatherTable;  // Owned by m_gridWeatherTable
   wxSizer* m_mainSizer;
 
   // Members for time-based highlighting
-  int m_highlightedRow;           // Current highlighted row index
   wxDateTime m_lastTimelineTime;  // Last time value used for highlighting
 
-  // Store original cell colors before highlighting
-  std::map<int, std::vector<wxColour>> m_originalCellColors;
-
   // Style mapping for Excel export
   std::map<CellStyle, int> m_styleMap;
   std::vector<CellStyle> m_styles;
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#ifndef _WEATHER_ROUTING_ROUTING_TRACE_H_
+#define _WEATHER_ROUTING_ROUTING_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+
+#include <wx/string.h>
+
+/**
+ * Timeline of a routing run, for finding stalls between the threads.
+ *
+ * While recording, spans of the propagation steps on the worker threads,
+ * of the grib handshake with the main thread and of the rendering are
+ * collected with the thread they ran on. Save() writes them in the Chrome
+ * trace event format, which chrome://tracing and ui.perfetto.dev display.
+ *
+ * Recording is off by default; a span then only tests a flag.
+ */
+class RoutingTrace {
+public:
+  typedef std::chrono::steady_clock::time_point TimePoint;
+
+  /** Discards the recorded spans and starts recording. */
+  static void Start();
+  /** Stops recording, the spans are kept until the next Start(). */
+  static void Stop();
+  static bool Recording() {
+    return s_Recording.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Records a span of the calling thread, if recording.
+   * @param name Name of the span, must outlive the trace.
+   * @param category Category of the span, must outlive the trace.
+   */
+  static void Span(const char* name, const char* category, TimePoint start,
+                   TimePoint end);
+
+  /**
+   * Writes the recorded spans as Chrome trace event JSON.
+   * @return false if the file could not be written.
+   */
+  static bool Save(const wxString& filename);
+
+private:
+  static std::atomic<bool> s_Recording;
+};
+
+/** Records the time from its construction to its destruction as a span. */
+class RoutingTraceSpan {
+public:
+  RoutingTraceSpan(const char* name, const char* category)
+      : m_Name(name),
+        m_Category(category),
+        m_Recording(RoutingTrace::Recording()) {
+    if (m_Recording) m_Start = std::chrono::steady_clock::now();
+  }
+
+  ~RoutingTraceSpan() {
+    if (m_Recording)
+      RoutingTrace::Span(m_Name, m_Category, m_Start,
+                         std::chrono::steady_clock::now());
+  }
+
+private:
+  const char* m_Name;
+  const char* m_Category;
+  bool m_Recording;
+  RoutingTrace::TimePoint m_Start;
+};
+
+#endif
@@ -23,6 +23,8 @@
 #include <list>
 
 #include "WeatherRoutingUI.h"
+#include "RoutingProfile.h"
+#include "RejectionHistogram.h"
 
 class RouteMapOverlay;
 
@@ -31,6 +33,24 @@ public:
   StatisticsDialog(wxWindow* parent);
   void SetRouteMapOverlays(std::list<RouteMapOverlay*> routemapoverlays);
   void SetRunTime(wxTimeSpan RunTime);
+
+private:
+  void OnSaveProfile(wxCommandEvent& event);
+  void OnRecordTrace(wxCommandEvent& event);
+  void OnSaveTrace(wxCommandEvent& event);
+
+  std::list<RouteMapOverlay*> m_RouteMapOverlays;
+  /* values of the profile rows, by phase */
+  wxStaticText* m_stProfileCalls[RoutingProfile::PHASE_COUNT];
+  wxStaticText* m_stProfileTime[RoutingProfile::PHASE_COUNT];
+  wxStaticText* m_stProfileLast[RoutingProfile::PHASE_COUNT];
+  /* values of the rejection rows, by reason and by heading bucket */
+  wxStaticText* m_stRejectedHeadings[RejectionHistogram::REASON_COUNT];
+  wxStaticText* m_stRejectedPositions[RejectionHistogram::REASON_COUNT];
+  wxStaticText* m_stRejectedLast[RejectionHistogram::REASON_COUNT];
+  wxStaticText* m_stBucketTried[RejectionHistogram::BUCKET_COUNT];
+  wxStaticText* m_stBucketRejected[RejectionHistogram::BUCKET_COUNT];
+  wxStaticText* m_stBucketLast[RejectionHistogram::BUCKET_COUNT];
 };
 
 #endif
@@ -70,9 +70,9 @@ public:
    * Determines whether it's day or night at a specific location and time.
    *
    * Checks if a given time at a particular location is during
-   * daylight or nighttime by calculating the sunrise and sunset times. It uses
-   * an internal caching mechanism to improve performance for repeated lookups
-   * of similar coordinates and dates.
+   * daylight or nighttime by calculating the sunrise and sunset times. They are
+   * cached per thread with 1 degree precision, so it is safe to call from
+   * several threads without locking.
    *
    * The function accounts for special cases in polar regions where the sun may
    * not rise (polar night) or set (midnight sun) on certain dates.
@@ -92,69 +92,56 @@ public:
                                    double* sunElevation = nullptr);
 
 private:
-  SunCalculator() {
-    // Make sure the cache is empty initially
-    m_cache.clear();
-    m_cacheMap.clear();
-    m_accessCounter = 0;
-  }
-
-  struct SunTimeCache {
-    int day_of_year;
-    /** The latitude with 1-degree precision. */
-    int lat_index;
-    /** The longitude with 1-degree precision. */
-    int lon_index;
-    /** Cached sunrise year (UTC). */
-    int sunriseYear;
-    /** Cached sunset year (UTC). */
-    int sunsetYear;
-    /** Cached sunrise hour (UTC). */
-    int sunriseHour;
-    /** Cached sunset hour (UTC). */
-    int sunsetHour;
-    uint64_t access_counter;
-  };
-
-  static const int MAX_SUN_CACHE_SIZE = 100;
-  std::vector<SunTimeCache> m_cache;
-  wxCriticalSection m_cacheLock;
-  uint64_t m_accessCounter = 0;  // Counter for LRU cache access tracking
+  friend class SunCalculatorTest;
 
-  // Define a struct for the cache key, packed into a single uint64_t
-  struct CacheKey {
-    uint64_t packed;
+  SunCalculator() {}
 
-    // Packing: 17 bits for day (0-366), 23 bits for lat, 24 bits for lon (all
-    // signed, centered at 0) Range: day_of_year [0, 366], lat_index [-90, 90],
-    // lon_index [-180, 180]
-    static uint64_t Pack(int day_of_year, int lat_index, int lon_index) {
-      // Offset lat/lon to unsigned
-      uint64_t day = static_cast<uint64_t>(day_of_year) & 0x1FF;      // 9 bits
-      uint64_t lat = static_cast<uint64_t>(lat_index + 90) & 0xFF;    // 8 bits
-      uint64_t lon = static_cast<uint64_t>(lon_index + 180) & 0x1FF;  // 9 bits
-      return (day << 16) | (lat << 8) | lon;
-    }
+  /**
+   * Sunrise and sunset of a day in a 1 degree cell.
+   *
+   * Each thread keeps its own direct mapped table of these, so lookups from
+   * the propagation workers never wait for each other. A slot holds the
+   * last cell which hashed to it.
+   */
+  struct SunTimes {
+    /** Packed day and cell, EMPTY_KEY for an unused slot. */
+    uint32_t key;
+    /** Sunrise hour (UTC). */
+    int8_t sunriseHour;
+    /** Sunset hour (UTC). */
+    int8_t sunsetHour;
+    /** The sun does not rise on this day (polar night). */
+    bool neverRises;
+    /** The sun does not set on this day (midnight sun). */
+    bool neverSets;
+  };
 
-    CacheKey(int day_of_year, int lat_index, int lon_index)
-        : packed(Pack(day_of_year, lat_index, lon_index)) {}
-    CacheKey(uint64_t packed_) : packed(packed_) {}
+  /** Number of slots of the table of each thread, a power of two. */
+  static const int SUN_CACHE_BITS = 10;
+  static const uint32_t EMPTY_KEY = UINT32_MAX;
 
-    bool operator==(const CacheKey& other) const {
-      return packed == other.packed;
-    }
-  };
+  /**
+   * Packs the day of year and the cell into a key.
+   *
+   * Range: day_of_year [0, 366] in 9 bits, lat_index [-90, 90] in 8 bits and
+   * lon_index [-180, 180] in 9 bits, the indices offset to unsigned.
+   */
+  static uint32_t PackKey(int day_of_year, int lat_index, int lon_index) {
+    uint32_t day = static_cast<uint32_t>(day_of_year) & 0x1FF;
+    uint32_t lat = static_cast<uint32_t>(lat_index + 90) & 0xFF;
+    uint32_t lon = static_cast<uint32_t>(lon_index + 180) & 0x1FF;
+    return (day << 17) | (lat << 9) | lon;
+  }
 
-  struct CacheKeyHash {
-    std::size_t operator()(const CacheKey& k) const {
-      // Use packed value directly as hash
-      return std::hash<uint64_t>()(k.packed);
-    }
-  };
+  /** Returns the index of the slot of a key in the table of a thread. */
+  static uint32_t SlotIndex(uint32_t key) {
+    // Fibonacci hashing spreads the neighbouring cells of a route over the
+    // table.
+    return (key * 2654435769u) >> (32 - SUN_CACHE_BITS);
+  }
 
-  // Map for O(1) lookups
-  std::unordered_map<CacheKey, size_t, CacheKeyHash>
-      m_cacheMap;  // Maps key to index in m_cache
+  /** Returns the slot of the calling thread's table for a key. */
+  static SunTimes& CacheSlot(uint32_t key);
 };
 
 #endif
@@ -508,6 +508,11 @@ private:
   void OnSaveAsRoute(wxCommandEvent& event);
   /** Export route as GPX file. */
   void OnExportRouteAsGPX(wxCommandEvent& event);
+  /**
+   * Exports every computed routing to one GPX, GeoJSON or CSV file, written
+   * on a worker thread with a progress dialog.
+   */
+  void OnExportAllRoutes(wxCommandEvent& event);
   /** Callback invoked when user clicks "Save All as Tracks" menu item. */
   void OnSaveAllAsTracks(wxCommandEvent& event);
   void OnSettings(wxCommandEvent& event);
@@ -529,6 +534,20 @@ private:
 
   bool OpenXML(wxString filename, bool reportfailure = true);
   void SaveXML(wxString filename);
+  /**
+   * Saves the isochrones of a finished route next to a configuration file,
+   * unless an up to date snapshot already exists.
+   *
+   * @param routemapoverlay The route to save.
+   * @param fn The configuration file being saved.
+   * @param index Position of the route in the configuration file.
+   * @param fingerprint Identifies the configuration of the route.
+   * @return The snapshot file relative to the directory of fn, or empty if
+   * the route has no snapshot.
+   */
+  wxString SaveSnapshot(RouteMapOverlay* routemapoverlay,
+                        const wxFileName& fn, int index,
+                        uint64_t fingerprint);
   /** Auto save on positions/routes changes. */
   void AutoSaveXML();
 
@@ -94,6 +94,8 @@ protected:
   wxMenuItem* m_mSaveAsRoute;
   /** Menu item to export weather routing as GPX file. */
   wxMenuItem* m_mExportRouteAsGPX;
+  /** Menu item to export all computed weather routings to one file. */
+  wxMenuItem* m_mExportAllRoutes;
   /** Menu item to save all weather routing configurations as tracks in OpenCPN
    * core. */
   wxMenuItem* m_mSaveAllAsTracks;
@@ -174,6 +176,8 @@ protected:
   virtual void OnSaveAsRoute(wxCommandEvent& event) { event.Skip(); }
   /** Callback invoked when user clicks "Export as GPX" menu item. */
   virtual void OnExportRouteAsGPX(wxCommandEvent& event) { event.Skip(); }
+  /** Callback invoked when user clicks "Export all routings" menu item. */
+  virtual void OnExportAllRoutes(wxCommandEvent& event) { event.Skip(); }
   /** Callback invoked when user clicks "Save All as Tracks" menu item. */
   virtual void OnSaveAllAsTracks(wxCommandEvent& event) { event.Skip(); }
   virtual void OnFilter(wxCommandEvent& event) { event.Skip(); }
@@ -435,6 +439,9 @@ protected:
   wxStaticText* m_staticText130;
   wxCheckBox* m_cbInvertedRegions;
   wxCheckBox* m_cbAnchoring;
+  wxCheckBox* m_cbHeuristicPruning;
+  wxCheckBox* m_cbBidirectional;
+  wxCheckBox* m_cbMultiResolution;
   wxStaticText* m_staticText139;
   wxComboBox* m_cIntegrator;
   wxStaticText* m_staticText1292;
@@ -452,6 +459,9 @@ protected:
   wxStaticText* m_staticText241;
   wxSpinCtrlDouble* m_sSafetyMarginLand;
   wxStaticText* m_staticText1211;
+  wxStaticText* m_staticTextCorridorWidth;
+  wxSpinCtrlDouble* m_sCorridorWidth;
+  wxStaticText* m_staticTextCorridorWidthUnit;
   wxStaticText* m_staticText113;
   wxStaticText* m_staticText115;
   wxStaticText* m_staticText117;
@@ -843,9 +853,22 @@ protected:
   wxStaticText* m_stSkipPositions;
   wxStaticText* m_staticText49;
   wxStaticText* m_stPositions;
+  wxStaticBoxSizer* m_sbProfile;
+  wxFlexGridSizer* m_fgProfile;
+  wxButton* m_bSaveProfile;
+  wxCheckBox* m_cbRecordTrace;
+  wxButton* m_bSaveTrace;
+  wxStaticBoxSizer* m_sbRejections;
+  wxFlexGridSizer* m_fgRejections;
+  wxFlexGridSizer* m_fgRejectionBuckets;
   wxStdDialogButtonSizer* m_sdbSizer5;
   wxButton* m_sdbSizer5OK;
 
+  // Virtual event handlers, overide them in your derived class
+  virtual void OnSaveProfile(wxCommandEvent& event) { event.Skip(); }
+  virtual void OnRecordTrace(wxCommandEvent& event) { event.Skip(); }
+  virtual void OnSaveTrace(wxCommandEvent& event) { event.Skip(); }
+
 public:
   StatisticsDialogBase(wxWindow* parent, wxWindowID id = wxID_ANY,
                        const wxString& title = _("Weather Routing Statistics"),
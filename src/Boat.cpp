@@ -27,6 +27,7 @@
 
 #include <wx/wx.h>
 #include <wx/filename.h>
+#include <map>
 #include <vector>
 
 #include "tinyxml.h"
@@ -39,6 +40,25 @@ Boat::Boat() {}
 
 Boat::~Boat() {}
 
+std::shared_ptr<const Boat> Boat::Shared(const wxString& filename,
+                                         wxString& error) {
+  static wxMutex mutex;
+  static std::map<wxString, std::weak_ptr<const Boat>> boats;
+
+  wxMutexLocker lock(mutex);
+  std::shared_ptr<const Boat> boat = boats[filename].lock();
+  if (boat && boat->m_last_filetime.IsValid() &&
+      boat->m_last_filetime == wxFileName(filename).GetModificationTime()) {
+    error = wxEmptyString;
+    return boat;
+  }
+
+  std::shared_ptr<Boat> loaded = std::make_shared<Boat>();
+  error = loaded->OpenXML(filename);
+  boats[filename] = loaded;
+  return loaded;
+}
+
 wxString Boat::OpenXML(wxString filename, bool shortcut) {
   wxDateTime last_filetime = wxFileName(filename).GetModificationTime();
   /* shortcut if already loaded, and boat wasn't modified */
@@ -288,6 +308,20 @@ bool Boat::FastestPolar(int p, float H, float VW) {
   return speed > 0;
 }
 
+double Boat::MaxSpeed() const {
+  double maxspeed = 0;
+  for (const Polar& polar : Polars)
+    maxspeed = wxMax(maxspeed, polar.MaxSpeed());
+  return maxspeed;
+}
+
+double Boat::MaxSpeed(double max_tws) const {
+  double maxspeed = 0;
+  for (const Polar& polar : Polars)
+    maxspeed = wxMax(maxspeed, polar.MaxSpeed(max_tws));
+  return maxspeed;
+}
+
 void Boat::GenerateCrossOverChart(void* arg, void (*status)(void*, int, int)) {
   const int maxVW = 40;
   const int stepi = 8;
@@ -506,7 +540,7 @@ void Boat::GenerateSegments(float H, float VW, float step, bool q[4],
 
 int Boat::FindBestPolarForCondition(int curpolar, double tws, double twa,
                                     double swell, bool optimize_tacking,
-                                    PolarSpeedStatus* status) {
+                                    PolarSpeedStatus* status) const {
   // First, try with the current polar. If it's still valid, we can use it.
   if (curpolar >= 0 && Polars[curpolar].InsideCrossOverContour(
                            twa, tws, optimize_tacking, status))
@@ -532,7 +566,7 @@ int Boat::FindBestPolarForCondition(int curpolar, double tws, double twa,
 
   // Second pass: find the best compromise based on the specific condition
   for (int i = 0; i < (int)Polars.size(); i++) {
-    Polar& polar = Polars[i];
+    const Polar& polar = Polars[i];
 
     // Skip polars with no data
     if (polar.degree_steps.empty() || polar.wind_speeds.empty()) continue;
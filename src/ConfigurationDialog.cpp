@@ -311,6 +311,10 @@ void ConfigurationDialog::SetConfigurations(
 
   SET_CHECKBOX(InvertedRegions);
   SET_CHECKBOX(Anchoring);
+  SET_CHECKBOX(HeuristicPruning);
+  SET_CHECKBOX(Bidirectional);
+  SET_CHECKBOX(MultiResolution);
+  SET_SPIN_DOUBLE(CorridorWidth);
 
   SET_CHECKBOX(UseGrib);
   SET_CONTROL(ClimatologyType, m_cClimatologyType, SetSelection, int, -1);
@@ -365,6 +369,10 @@ void ConfigurationDialog::OnResetAdvanced(wxCommandEvent& event) {
   // Options
   m_cbInvertedRegions->SetValue(false);
   m_cbAnchoring->SetValue(false);
+  m_cbHeuristicPruning->SetValue(false);
+  m_cbBidirectional->SetValue(false);
+  m_cbMultiResolution->SetValue(false);
+  m_sCorridorWidth->SetValue(100.);
   m_cIntegrator->SetSelection(0);
   m_sWindStrength->SetValue(100);
   m_sUpwindEfficiency->SetValue(100);
@@ -563,6 +571,10 @@ void ConfigurationDialog::Update() {
 
     GET_CHECKBOX(InvertedRegions);
     GET_CHECKBOX(Anchoring);
+    GET_CHECKBOX(HeuristicPruning);
+    GET_CHECKBOX(Bidirectional);
+    GET_CHECKBOX(MultiResolution);
+    GET_SPIN(CorridorWidth);
 
     GET_CHECKBOX(UseGrib);
     if (m_cClimatologyType->GetSelection() != -1)
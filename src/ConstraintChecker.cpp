@@ -33,6 +33,7 @@
 
 #include "ConstraintChecker.h"
 #include "WeatherDataProvider.h"
+#include "IsoRoute.h"
 #include "RouteMap.h"
 #include "Utilities.h"
 
@@ -232,6 +233,7 @@ void clear_land_cache() {
 bool ConstraintChecker::CheckSwellConstraint(
     RouteMapConfiguration& configuration, double lat, double lon, double& swell,
     PropagationError& error_code) {
+  RoutingPhaseTimer timer(configuration.profile, RoutingProfile::CHECK_SWELL);
   swell = WeatherDataProvider::GetSwell(configuration, lat, lon);
   if (swell > configuration.MaxSwellMeters) {
     wxLogGeneric(
@@ -248,6 +250,7 @@ bool ConstraintChecker::CheckSwellConstraint(
 bool ConstraintChecker::CheckMaxLatitudeConstraint(
     RouteMapConfiguration& configuration, double lat,
     PropagationError& error_code) {
+  configuration.profile.Count(RoutingProfile::CHECK_MAX_LATITUDE);
   if (fabs(lat) > configuration.MaxLatitude) {
     wxLogGeneric(
         wxLOG_Debug,
@@ -264,6 +267,8 @@ bool ConstraintChecker::CheckCycloneTrackConstraint(
     double dlon) {
   if (configuration.AvoidCycloneTracks &&
       RouteMap::ClimatologyCycloneTrackCrossings) {
+    RoutingPhaseTimer timer(configuration.profile,
+                            RoutingProfile::CHECK_CYCLONE_TRACK);
     int crossings = RouteMap::ClimatologyCycloneTrackCrossings(
         lat, lon, dlat, dlon, configuration.time,
         configuration.CycloneMonths * 30 + configuration.CycloneDays);
@@ -276,6 +281,7 @@ bool ConstraintChecker::CheckCycloneTrackConstraint(
 
 bool ConstraintChecker::CheckMaxCourseAngleConstraint(
     RouteMapConfiguration& configuration, double dlat, double dlon) {
+  configuration.profile.Count(RoutingProfile::CHECK_MAX_COURSE_ANGLE);
   if (configuration.MaxCourseAngle < 180) {
     double bearing;
     // this is faster than gc distance, and actually works better in higher
@@ -295,6 +301,7 @@ bool ConstraintChecker::CheckMaxCourseAngleConstraint(
 
 bool ConstraintChecker::CheckMaxDivertedCourse(
     RouteMapConfiguration& configuration, double dlat, double dlon) {
+  configuration.profile.Count(RoutingProfile::CHECK_MAX_DIVERTED_COURSE);
   if (configuration.MaxDivertedCourse < 180) {
     double bearing, dist;
     double bearing1, dist1;
@@ -319,10 +326,112 @@ bool ConstraintChecker::CheckMaxDivertedCourse(
   return true;
 }
 
+/* cells along each side of a corridor grid at most, very narrow corridors
+   get cells wider than the corridor */
+#define CORRIDOR_GRID_MAX_CELLS 256
+
+CorridorGrid::CorridorGrid(const std::vector<std::pair<double, double>>& track,
+                           double width)
+    : m_LatMin(0),
+      m_LonOrigin(0),
+      m_LonMin(0),
+      m_CellLat(1),
+      m_CellLon(1),
+      m_Rows(0),
+      m_Cols(0) {
+  if (track.size() < 2) return;
+
+  // longitudes relative to the start of the track, so the grid does not
+  // break across the antimeridian
+  m_LonOrigin = track[0].second;
+  double latmin = INFINITY, latmax = -INFINITY;
+  double lonmin = INFINITY, lonmax = -INFINITY;
+  for (const std::pair<double, double>& point : track) {
+    double lon = heading_resolve(point.second - m_LonOrigin);
+    latmin = wxMin(latmin, point.first);
+    latmax = wxMax(latmax, point.first);
+    lonmin = wxMin(lonmin, lon);
+    lonmax = wxMax(lonmax, lon);
+  }
+
+  // a position within the width of a leg is within these margins of the
+  // bounding box of the leg, at any latitude of the grid
+  double marginlat = wxMax(width, 0.) / 60;
+  double maxlat = wxMin(wxMax(fabs(latmin), fabs(latmax)) + marginlat, 89.);
+  double marginlon = marginlat / cos(deg2rad(maxlat));
+
+  m_LatMin = latmin - marginlat;
+  m_LonMin = lonmin - marginlon;
+  double height = latmax - latmin + 2 * marginlat;
+  double length = lonmax - lonmin + 2 * marginlon;
+  m_CellLat = wxMax(wxMax(marginlat, height / CORRIDOR_GRID_MAX_CELLS), 1e-3);
+  m_CellLon = wxMax(wxMax(marginlon, length / CORRIDOR_GRID_MAX_CELLS), 1e-3);
+  m_Rows = (int)(height / m_CellLat) + 1;
+  m_Cols = (int)(length / m_CellLon) + 1;
+  m_Cells.resize(m_Rows * m_Cols);
+
+  for (size_t i = 0; i + 1 < track.size(); i++) {
+    double lon1 = heading_resolve(track[i].second - m_LonOrigin);
+    double lon2 = heading_resolve(track[i + 1].second - m_LonOrigin);
+    int r1 = Row(wxMin(track[i].first, track[i + 1].first) - marginlat);
+    int r2 = Row(wxMax(track[i].first, track[i + 1].first) + marginlat);
+    int c1 = Col(wxMin(lon1, lon2) - marginlon);
+    int c2 = Col(wxMax(lon1, lon2) + marginlon);
+    for (int r = wxMax(r1, 0); r <= wxMin(r2, m_Rows - 1); r++)
+      for (int c = wxMax(c1, 0); c <= wxMin(c2, m_Cols - 1); c++)
+        m_Cells[r * m_Cols + c].push_back(i);
+  }
+}
+
+int CorridorGrid::Row(double lat) const {
+  return (int)floor((lat - m_LatMin) / m_CellLat);
+}
+
+int CorridorGrid::Col(double lon) const {
+  return (int)floor((lon - m_LonMin) / m_CellLon);
+}
+
+const std::vector<int>* CorridorGrid::Legs(double lat, double lon) const {
+  int r = Row(lat), c = Col(heading_resolve(lon - m_LonOrigin));
+  if (r < 0 || r >= m_Rows || c < 0 || c >= m_Cols) return nullptr;
+  return &m_Cells[r * m_Cols + c];
+}
+
+bool ConstraintChecker::CheckCorridorConstraint(
+    RouteMapConfiguration& configuration, double dlat, double dlon) {
+  if (!configuration.CorridorCells) return true;
+  RoutingPhaseTimer timer(configuration.profile,
+                          RoutingProfile::CHECK_CORRIDOR);
+
+  const std::vector<int>* legs = configuration.CorridorCells->Legs(dlat, dlon);
+  if (!legs) return false;
+
+  // Distance to each nearby leg of the track on a local flat projection
+  // centered on the position, in nautical miles. Accurate enough for a
+  // corridor check.
+  const std::vector<std::pair<double, double>>& track = configuration.Corridor;
+  double coslat = cos(deg2rad(dlat));
+  double width2 = configuration.CorridorWidth * configuration.CorridorWidth;
+  for (int i : *legs) {
+    double ax = 60 * coslat * heading_resolve(track[i].second - dlon);
+    double ay = 60 * (track[i].first - dlat);
+    double bx = 60 * coslat * heading_resolve(track[i + 1].second - dlon);
+    double by = 60 * (track[i + 1].first - dlat);
+    double dx = bx - ax, dy = by - ay;
+    double len2 = dx * dx + dy * dy;
+    double t = len2 > 0 ? -(ax * dx + ay * dy) / len2 : 0;
+    t = wxMax(0., wxMin(1., t));
+    double x = ax + t * dx, y = ay + t * dy;
+    if (x * x + y * y <= width2) return true;
+  }
+  return false;
+}
+
 bool ConstraintChecker::CheckLandConstraint(
     RouteMapConfiguration& configuration, double lat, double lon, double dlat1,
     double dlon1, double cog) {
   if (configuration.DetectLand) {
+    RoutingPhaseTimer timer(configuration.profile, RoutingProfile::LAND);
     double ndlon1 = dlon1;
     if (ndlon1 > 360) {
       ndlon1 -= 360;
@@ -355,9 +464,43 @@ bool ConstraintChecker::CheckLandConstraint(
   return true;
 }
 
+bool ConstraintChecker::CheckHeuristicBound(
+    RouteMapConfiguration& configuration, double lat, double lon,
+    PropagationError& error_code) {
+  configuration.profile.Count(RoutingProfile::CHECK_HEURISTIC_BOUND);
+  if (!configuration.HeuristicPruning ||
+      std::isnan(configuration.HeuristicTimeBound) ||
+      configuration.HeuristicTimeBound <= 0 ||
+      configuration.HeuristicSpeedBound <= 0)
+    return true;
+
+  double dist = DistGreatCircle(lat, lon, configuration.EndLat,
+                                configuration.EndLon);
+  if (3600.0 * dist / configuration.HeuristicSpeedBound >
+      configuration.HeuristicTimeBound) {
+    error_code = PROPAGATION_HEURISTIC_PRUNED;
+    return false;
+  }
+  return true;
+}
+
+bool ConstraintChecker::CheckReverseReach(
+    RouteMapConfiguration& configuration, double lat, double lon,
+    PropagationError& error_code) {
+  if (!configuration.ReverseReach) return true;
+
+  Position p(lat, lon);
+  IsoRouteList& routes = configuration.ReverseReach->routes;
+  for (IsoRouteList::iterator it = routes.begin(); it != routes.end(); ++it)
+    if ((*it)->Contains(p, true) != 0) return true;
+  error_code = PROPAGATION_OUTSIDE_REVERSE_REACH;
+  return false;
+}
+
 bool ConstraintChecker::CheckMaxTrueWindConstraint(
     RouteMapConfiguration& configuration, double twsOverWater,
     PropagationError& error_code) {
+  configuration.profile.Count(RoutingProfile::CHECK_MAX_TRUE_WIND);
   if (twsOverWater > configuration.MaxTrueWindKnots) {
     error_code = PROPAGATION_EXCEEDED_MAX_WIND;
     return false;
@@ -368,6 +511,7 @@ bool ConstraintChecker::CheckMaxTrueWindConstraint(
 bool ConstraintChecker::CheckMaxApparentWindConstraint(
     RouteMapConfiguration& configuration, double stw, double twa,
     double twsOverWater, PropagationError& error_code) {
+  configuration.profile.Count(RoutingProfile::CHECK_MAX_APPARENT_WIND);
   if (stw + twsOverWater > configuration.MaxApparentWindKnots &&
       Polar::VelocityApparentWind(stw, twa, twsOverWater) >
           configuration.MaxApparentWindKnots) {
@@ -380,6 +524,7 @@ bool ConstraintChecker::CheckWindVsCurrentConstraint(
     RouteMapConfiguration& configuration, double twsOverWater,
     double twdOverWater, double currentSpeed, double currentDir,
     PropagationError& error_code) {
+  configuration.profile.Count(RoutingProfile::CHECK_WIND_VS_CURRENT);
   if (configuration.WindVSCurrent) {
     /*
      * Calculate the wind vector (Wx, Wy) and ocean current vector (Cx, Cy).
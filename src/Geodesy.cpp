@@ -0,0 +1,123 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "georef.h"
+#include "Geodesy.h"
+
+/* WGS84, as used by ll_gc_ll() */
+static const double SEMIMAJOR_AXIS_NM = WGS84_semimajor_axis_meters / 1852.0;
+static const double ECCENTRICITY2 = (2 - 1 / WGSinvf) / WGSinvf;
+
+static const double MEAN_RADIUS_NM = 6371008.8 / 1852.0;
+
+/* the error against ll_gc_ll() stays below ERROR_FLOOR +
+   ERROR_SQUARE * dist^2 + ERROR_CUBE * dist^3 / cos^2(lat), fitted over all
+   courses up to 85 degrees latitude with a safety factor of two. The floor
+   covers rounding, the square term the flattening and the cube term the
+   neglected third order terms of the expansion */
+static const double ERROR_FLOOR = 1e-8;
+static const double ERROR_SQUARE = 1e-6;
+static const double ERROR_CUBE = 1e-7;
+
+/* ll_gc_ll() is used beyond this latitude whatever the step */
+static const double MAX_FAST_LATITUDE = 89;
+
+GeodesicOrigin::GeodesicOrigin(double lat, double lon, double max_distance,
+                               double max_error)
+    : m_lat(lat), m_lon(lon) {
+  double phi = lat * DEGREE;
+  double sinlat = sin(phi), coslat = cos(phi);
+  double w = 1 - ECCENTRICITY2 * sinlat * sinlat;
+  /* radii of curvature along the meridian and the prime vertical */
+  double M = SEMIMAJOR_AXIS_NM * (1 - ECCENTRICITY2) / (w * sqrt(w));
+  double N = SEMIMAJOR_AXIS_NM / sqrt(w);
+  double tanlat = sinlat / coslat;
+
+  m_LatPerNm = 1 / M;
+  m_LonPerNm = 1 / (N * coslat);
+  m_LatCurvature = -tanlat / (2 * M * N);
+  m_MeridianCurvature =
+      -1.5 * ECCENTRICITY2 * sinlat * coslat / (w * M * M);
+  m_LonCurvature = tanlat / (M * N * coslat);
+
+  if (fabs(lat) > MAX_FAST_LATITUDE)
+    m_MaxFastDistance = -1;  // never fast
+  else
+    /* each error term gets half of the maximum error */
+    m_MaxFastDistance = std::min(
+        {max_distance, sqrt(max_error / (2 * ERROR_SQUARE)),
+         cbrt(max_error * coslat * coslat / (2 * ERROR_CUBE))});
+}
+
+double GeodesicOrigin::ErrorBound(double lat, double dist) {
+  double coslat = cos(lat * DEGREE);
+  if (fabs(lat) > MAX_FAST_LATITUDE)
+    return std::numeric_limits<double>::infinity();
+  dist = fabs(dist);
+  return ERROR_FLOOR + ERROR_SQUARE * dist * dist +
+         ERROR_CUBE * dist * dist * dist / (coslat * coslat);
+}
+
+/* the expansion of the geodesic to second order in the distance, with dn and
+   de the northing and easting of the step */
+static inline void FastStep(double lat, double lon, double lat_per_nm,
+                            double lon_per_nm, double lat_curvature,
+                            double meridian_curvature, double lon_curvature,
+                            double brg, double dist, double& dlat,
+                            double& dlon) {
+  double a = brg * DEGREE;
+  double dn = dist * cos(a), de = dist * sin(a);
+  dlat = lat + (dn * lat_per_nm + de * de * lat_curvature +
+                dn * dn * meridian_curvature) /
+                   DEGREE;
+  dlon = lon + (de * lon_per_nm + de * dn * lon_curvature) / DEGREE;
+}
+
+/* same range as adjlon() in ll_gc_ll() */
+static inline double ResolveLongitude(double lon) {
+  if (fabs(lon) <= 180) return lon;
+  lon += 180;
+  lon -= 360 * floor(lon / 360);
+  return lon - 180;
+}
+
+void GeodesicOrigin::Destination(double brg, double dist, double* dlat,
+                                 double* dlon) const {
+  if (!Fast(dist)) {
+    ll_gc_ll(m_lat, m_lon, brg, dist, dlat, dlon);
+    return;
+  }
+
+  FastStep(m_lat, m_lon, m_LatPerNm, m_LonPerNm, m_LatCurvature,
+           m_MeridianCurvature, m_LonCurvature, brg, dist, *dlat, *dlon);
+  *dlon = ResolveLongitude(*dlon);
+}
+
+double FastDistance(double lat1, double lon1, double lat2, double lon2) {
+  /* haversine, well conditioned for short distances */
+  double phi1 = lat1 * DEGREE, phi2 = lat2 * DEGREE;
+  double sdlat = sin((phi2 - phi1) / 2);
+  double sdlon = sin((lon2 - lon1) * DEGREE / 2);
+  double h = sdlat * sdlat + cos(phi1) * cos(phi2) * sdlon * sdlon;
+  return 2 * MEAN_RADIUS_NM * asin(std::min(1.0, sqrt(h)));
+}
@@ -24,6 +24,7 @@
 #include "IsoRoute.h"
 #include "Position.h"
 #include "RouteMap.h"
+#include "RoutingTrace.h"
 
 void DeleteSkipPoints(SkipPosition* skippoints) {
   SkipPosition* s = skippoints;
@@ -238,6 +239,7 @@ IsoChron::~IsoChron() {
 
 void IsoChron::PropagateIntoList(IsoRouteList& routelist,
                                  RouteMapConfiguration& configuration) {
+  RoutingTraceSpan trace("PropagateIntoList", "routing");
   for (IsoRouteList::iterator it = routes.begin(); it != routes.end(); ++it) {
     bool propagated = false;
 
@@ -425,7 +425,7 @@ void Polar::OptimizeTackingSpeed()
 #endif
 
 // return index of wind speed in table which less than our wind speed
-void Polar::ClosestVWi(double VW, int& VW1i, int& VW2i) {
+void Polar::ClosestVWi(double VW, int& VW1i, int& VW2i) const {
   for (unsigned int VWi = 1; VWi < wind_speeds.size() - 1; VWi++)
     if (wind_speeds[VWi].tws > VW) {
       VW1i = VWi - 1;
@@ -437,8 +437,8 @@ void Polar::ClosestVWi(double VW, int& VW1i, int& VW2i) {
   VW1i = VW2i > 0 ? VW2i - 1 : 0;
 }
 
-bool Polar::VMGAngle(SailingWindSpeed& ws1, SailingWindSpeed& ws2, float VW,
-                     float& W) {
+bool Polar::VMGAngle(const SailingWindSpeed& ws1, const SailingWindSpeed& ws2,
+                     float VW, float& W) const {
   // optimization
   SailingVMG vmg1 = ws1.VMG, vmg2 = ws2.VMG;
   if (W >= vmg1.values[SailingVMG::STARBOARD_UPWIND] &&
@@ -465,7 +465,7 @@ bool Polar::VMGAngle(SailingWindSpeed& ws1, SailingWindSpeed& ws2, float VW,
 }
 
 double Polar::Speed(double twa, double tws, PolarSpeedStatus* status,
-                    bool bound, bool optimize_tacking) {
+                    bool bound, bool optimize_tacking) const {
   // Initialize error code to success
   if (status) *status = POLAR_SPEED_SUCCESS;
   if (tws < 0) {
@@ -517,7 +517,7 @@ double Polar::Speed(double twa, double tws, PolarSpeedStatus* status,
 
   int VW1i, VW2i;
   ClosestVWi(tws, VW1i, VW2i);
-  SailingWindSpeed &ws1 = wind_speeds[VW1i], &ws2 = wind_speeds[VW2i];
+  const SailingWindSpeed &ws1 = wind_speeds[VW1i], &ws2 = wind_speeds[VW2i];
 
   if (optimize_tacking) {
     float vmgW = twa;
@@ -622,11 +622,42 @@ double Polar::SpeedAtApparentWind(double A, double aws, double* pW) {
   }
 }
 
-SailingVMG Polar::GetVMGTrueWind(double VW) {
+double Polar::MaxSpeed() const {
+  double maxspeed = 0;
+  for (const SailingWindSpeed& ws : wind_speeds)
+    for (float speed : ws.speeds)
+      if (speed > maxspeed) maxspeed = speed;
+  return maxspeed;
+}
+
+double Polar::MaxSpeed(double max_tws) const {
+  double maxspeed = MaxSpeed();
+  size_t n = wind_speeds.size();
+  if (n < 2) return maxspeed;
+
+  // Speed() is linear in the wind speed on each segment, so the extremes of
+  // the extrapolated segments are at calm and at max_tws.
+  const SailingWindSpeed &first = wind_speeds[0], &second = wind_speeds[1];
+  const SailingWindSpeed &last = wind_speeds[n - 1],
+                         &before = wind_speeds[n - 2];
+  for (unsigned int i = 0; i < degree_steps.size(); i++) {
+    if (first.tws > 0)
+      maxspeed = wxMax(maxspeed, interp_value(0, first.tws, second.tws,
+                                              first.speeds[i],
+                                              second.speeds[i]));
+    if (max_tws > last.tws)
+      maxspeed = wxMax(maxspeed, interp_value(max_tws, before.tws, last.tws,
+                                              before.speeds[i],
+                                              last.speeds[i]));
+  }
+  return maxspeed;
+}
+
+SailingVMG Polar::GetVMGTrueWind(double VW) const {
   int VW1i, VW2i;
   ClosestVWi(VW, VW1i, VW2i);
 
-  SailingWindSpeed &ws1 = wind_speeds[VW1i], &ws2 = wind_speeds[VW2i];
+  const SailingWindSpeed &ws1 = wind_speeds[VW1i], &ws2 = wind_speeds[VW2i];
   double VW1 = ws1.tws, VW2 = ws2.tws;
   SailingVMG vmg, vmg1 = ws1.VMG, vmg2 = ws2.VMG;
 
@@ -818,7 +849,7 @@ void Polar::UpdateDegreeStepLookup() {
 // Determine if our current state is satisfied by the current cross over
 // contour
 bool Polar::InsideCrossOverContour(float twa, float tws, bool optimize_tacking,
-                                   PolarSpeedStatus* status) {
+                                   PolarSpeedStatus* status) const {
   // Initialize status to success
   if (status) *status = POLAR_SPEED_SUCCESS;
 
@@ -831,7 +862,7 @@ bool Polar::InsideCrossOverContour(float twa, float tws, bool optimize_tacking,
   if (optimize_tacking) {
     int VW1i, VW2i;
     ClosestVWi(tws, VW1i, VW2i);
-    SailingWindSpeed &ws1 = wind_speeds[VW1i], &ws2 = wind_speeds[VW2i];
+    const SailingWindSpeed &ws1 = wind_speeds[VW1i], &ws2 = wind_speeds[VW2i];
     VMGAngle(ws1, ws2, tws, twa);
   }
   if (tws < 0) {
@@ -20,6 +20,7 @@
 #include <wx/wx.h>
 
 #include "Position.h"
+#include "Geodesy.h"
 #include "RouteMap.h"
 #include "Utilities.h"
 
@@ -160,14 +161,15 @@ void DeletePoints(Position* point) {
  * current winds and boat polars. This function is used as part of the
  * 4th order Runge-Kutta integration.
  *
- * @param p Current position
+ * @param origin Fast geodesy from this position
  * @param timeseconds Time step in seconds
  * @param cog Course over ground (degrees)
  * @param dist Distance to travel (nm)
  * @param twa True Wind Angle (degrees)
+ * @param dayLight Day or night at this position, used for the step instead
+ * of looking it up again
  * @param configuration Route configuration parameters
  * @param grib GRIB weather data
- * @param time Current time
  * @param newpolar Index of polar to use
  * @param rk_cog [out] New bearing over ground (degrees)
  * @param rk_dist [out] New distance traveled (nm)
@@ -175,21 +177,26 @@ void DeletePoints(Position* point) {
  *
  * @return true if step was successful, false if step failed
  */
-bool Position::rk_step(double timeseconds, double cog, double dist, double twa,
+bool Position::rk_step(const GeodesicOrigin& origin, double timeseconds,
+                       double cog, double dist, double twa,
+                       DayLightStatus dayLight,
                        RouteMapConfiguration& configuration,
-                       WR_GribRecordSet* grib, const wxDateTime& time,
-                       int newpolar, double& rk_cog, double& rk_dist,
-                       DataMask& data_mask) {
+                       WR_GribRecordSet* grib, int newpolar, double& rk_cog,
+                       double& rk_dist, DataMask& data_mask) {
   double k1_lat, k1_lon;
-  ll_gc_ll(lat, lon, cog, dist, &k1_lat, &k1_lon);
+  origin.Destination(cog, dist, &k1_lat, &k1_lon);
 
   WeatherData weather_data(this);
   Position rk(k1_lat, k1_lon,
               parent);  // parent so deficient data can find parent
   if (!weather_data.ReadWeatherDataAndCheckConstraints(
-          configuration, &rk, data_mask, propagation_error, false /*end*/)) {
+          configuration, &rk, data_mask, propagation_error, false /*end*/,
+          false /* lookup_daylight */)) {
     return false;
   }
+  /* the steps read the weather at the same time as the position, and stay
+     close to it */
+  weather_data.dayLight = dayLight;
   double ctw =
       weather_data.twdOverWater + twa; /* rotated relative to true wind */
 
@@ -204,6 +211,37 @@ bool Position::rk_step(double timeseconds, double cog, double dist, double twa,
   return true;
 }
 
+/* counts a position whose weather, the heuristic bound or the reverse pass
+   rejected it before trying any heading */
+static void RejectPosition(RejectionHistogram& rejections,
+                           PropagationError error) {
+  switch (error) {
+    case PROPAGATION_EXCEEDED_MAX_SWELL:
+      rejections.RejectPosition(RejectionHistogram::MAX_SWELL);
+      break;
+    case PROPAGATION_EXCEEDED_MAX_LATITUDE:
+      rejections.RejectPosition(RejectionHistogram::MAX_LATITUDE);
+      break;
+    case PROPAGATION_EXCEEDED_MAX_WIND:
+      rejections.RejectPosition(RejectionHistogram::MAX_TRUE_WIND);
+      break;
+    case PROPAGATION_EXCEEDED_WIND_VS_CURRENT:
+      rejections.RejectPosition(RejectionHistogram::WIND_VS_CURRENT);
+      break;
+    case PROPAGATION_WIND_DATA_FAILED:
+      rejections.RejectPosition(RejectionHistogram::WIND_DATA);
+      break;
+    case PROPAGATION_HEURISTIC_PRUNED:
+      rejections.RejectPosition(RejectionHistogram::HEURISTIC_BOUND);
+      break;
+    case PROPAGATION_OUTSIDE_REVERSE_REACH:
+      rejections.RejectPosition(RejectionHistogram::REVERSE_REACH);
+      break;
+    default:
+      break;
+  }
+}
+
 /* propagate to the end position in the configuration, and return the number of
  * seconds it takes */
 double Position::PropagateToEnd(RouteMapConfiguration& cf, double& H,
@@ -221,6 +259,15 @@ bool Position::Propagate(IsoRouteList& routelist,
 
   propagated = true;
 
+  /* cannot beat the best known arrival, so don't waste time exploring */
+  if (!ConstraintChecker::CheckHeuristicBound(configuration, lat, lon,
+                                              propagation_error) ||
+      !ConstraintChecker::CheckReverseReach(configuration, lat, lon,
+                                            propagation_error)) {
+    RejectPosition(configuration.rejections, propagation_error);
+    return false;
+  }
+
   Position* points = nullptr;
   /* through all angles relative to wind */
   int count = 0;
@@ -228,12 +275,26 @@ bool Position::Propagate(IsoRouteList& routelist,
   WeatherData weather_data(this);
   if (!weather_data.ReadWeatherDataAndCheckConstraints(
           configuration, this, data_mask, propagation_error, false /*end*/)) {
+    RejectPosition(configuration.rejections, propagation_error);
     return false;
   }
 
   bool first_avoid = true;
   Position* rp;
 
+  /* the latitude dependent geodesy, the way to the destination and the
+     options do not depend on the heading, work them out once for all
+     headings. The weather read above also holds the day or night status. */
+  GeodesicOrigin origin(lat, lon);
+  const bool detect_obstacles =
+      configuration.DetectLand || configuration.DetectBoundary;
+  const bool runge_kutta =
+      configuration.Integrator == RouteMapConfiguration::RUNGE_KUTTA;
+  double bearing2end, dist2end = NAN;
+  if (detect_obstacles)
+    ll_gc_ll_reverse(lat, lon, configuration.EndLat, configuration.EndLon,
+                     &bearing2end, &dist2end);
+
   double bearing1 = NAN, bearing2 = NAN;
   if (parent && configuration.MaxSearchAngle < 180) {
     bearing1 = heading_resolve(parent_bearing - configuration.MaxSearchAngle);
@@ -246,6 +307,9 @@ bool Position::Propagate(IsoRouteList& routelist,
     double twa = heading_resolve(*it);
     double ctw =
         weather_data.twdOverWater + twa; /* rotated relative to true wind */
+    int bucket =
+        RejectionHistogram::Bucket(ctw - configuration.StartEndBearing);
+    configuration.rejections.Try(bucket);
 
     // Do no waste time exploring directions outside the configured search
     // angle.
@@ -254,6 +318,8 @@ bool Position::Propagate(IsoRouteList& routelist,
       if ((bearing1 > bearing2 && bearing3 > bearing2 && bearing3 < bearing1) ||
           (bearing1 < bearing2 &&
            (bearing3 > bearing2 || bearing3 < bearing1))) {
+        configuration.rejections.Reject(RejectionHistogram::SEARCH_ANGLE,
+                                        bucket);
         if (first_avoid) {
           /* add a position behind the lines to ensure our route intersects
           with the previous one to nicely merge the resulting graph */
@@ -277,41 +343,42 @@ bool Position::Propagate(IsoRouteList& routelist,
       if (!boat_data.GetBestPolarAndBoatSpeed(
               configuration, weather_data, twa, ctw, parent_heading, data_mask,
               this->polar, newpolar, timeseconds)) {
+        configuration.rejections.Reject(RejectionHistogram::POLAR, bucket);
         continue;
       }
 
       // {dlat, dlon} represent the destination coordinates for a route point
       // after propagation.
       double dlat, dlon;
-      if (configuration.Integrator == RouteMapConfiguration::RUNGE_KUTTA) {
+      if (runge_kutta) {
         double k2_dist, k2_BG, k3_dist, k3_BG, k4_dist, k4_BG;
         // a lot more experimentation is needed here, maybe use grib for the
-        // right time??
-        wxDateTime rk_time_2 =
-            configuration.time + wxTimeSpan::Seconds(timeseconds / 2);
-        wxDateTime rk_time =
-            configuration.time + wxTimeSpan::Seconds(timeseconds);
-        if (!rk_step(timeseconds, boat_data.cog, boat_data.dist / 2, twa,
-                     configuration, configuration.grib, rk_time_2, newpolar,
-                     k2_BG, k2_dist, data_mask) ||
-            !rk_step(timeseconds, boat_data.cog, k2_dist / 2,
-                     twa + k2_BG - boat_data.cog, configuration,
-                     configuration.grib, rk_time_2, newpolar, k3_BG, k3_dist,
+        // right time?? The steps read the weather at the time of the
+        // configuration for now.
+        if (!rk_step(origin, timeseconds, boat_data.cog, boat_data.dist / 2,
+                     twa, weather_data.dayLight, configuration,
+                     configuration.grib, newpolar, k2_BG, k2_dist,
                      data_mask) ||
-            !rk_step(timeseconds, boat_data.cog, k3_dist,
-                     twa + k3_BG - boat_data.cog, configuration,
-                     configuration.grib, rk_time, newpolar, k4_BG, k4_dist,
-                     data_mask)) {
+            !rk_step(origin, timeseconds, boat_data.cog, k2_dist / 2,
+                     twa + k2_BG - boat_data.cog, weather_data.dayLight,
+                     configuration, configuration.grib, newpolar, k3_BG,
+                     k3_dist, data_mask) ||
+            !rk_step(origin, timeseconds, boat_data.cog, k3_dist,
+                     twa + k3_BG - boat_data.cog, weather_data.dayLight,
+                     configuration, configuration.grib, newpolar, k4_BG,
+                     k4_dist, data_mask)) {
+          configuration.rejections.Reject(RejectionHistogram::POLAR, bucket);
           continue;
         }
 
-        ll_gc_ll(lat, lon, boat_data.cog,
-                 boat_data.dist / 6 + k2_dist / 3 + k3_dist / 3 + k4_dist / 6,
-                 &dlat, &dlon);
+        origin.Destination(
+            boat_data.cog,
+            boat_data.dist / 6 + k2_dist / 3 + k3_dist / 3 + k4_dist / 6,
+            &dlat, &dlon);
       } else /* newtons method */
 #if 1
-        ll_gc_ll(lat, lon, heading_resolve(boat_data.cog), boat_data.dist,
-                 &dlat, &dlon);
+        origin.Destination(heading_resolve(boat_data.cog), boat_data.dist,
+                           &dlat, &dlon);
 #else
       {
         double d = boat_data.dist / 60;
@@ -324,10 +391,19 @@ bool Position::Propagate(IsoRouteList& routelist,
       if (configuration.positive_longitudes && dlon < 0) dlon += 360;
       if (!ConstraintChecker::CheckMaxCourseAngleConstraint(configuration, dlat,
                                                             dlon)) {
+        configuration.rejections.Reject(RejectionHistogram::MAX_COURSE_ANGLE,
+                                        bucket);
         continue;
       }
       if (!ConstraintChecker::CheckMaxDivertedCourse(configuration, dlat,
                                                      dlon)) {
+        configuration.rejections.Reject(
+            RejectionHistogram::MAX_DIVERTED_COURSE, bucket);
+        continue;
+      }
+      if (!ConstraintChecker::CheckCorridorConstraint(configuration, dlat,
+                                                      dlon)) {
+        configuration.rejections.Reject(RejectionHistogram::CORRIDOR, bucket);
         continue;
       }
 
@@ -335,21 +411,20 @@ bool Position::Propagate(IsoRouteList& routelist,
       if (!ConstraintChecker::CheckMaxApparentWindConstraint(
               configuration, boat_data.stw, twa, weather_data.twsOverWater,
               propagation_error)) {
+        configuration.rejections.Reject(RejectionHistogram::MAX_APPARENT_WIND,
+                                        bucket);
         continue;
       }
 
-      if (configuration.DetectLand || configuration.DetectBoundary) {
+      if (detect_obstacles) {
         double dlat1, dlon1;
-        double bearing, dist2end;
         double dist2test;
 
         // it's not an error if there's boundaries after we reach destination
-        ll_gc_ll_reverse(lat, lon, configuration.EndLat, configuration.EndLon,
-                         &bearing, &dist2end);
         if (dist2end < boat_data.dist) {
           dist2test = dist2end;
-          ll_gc_ll(lat, lon, heading_resolve(boat_data.cog), dist2test, &dlat1,
-                   &dlon1);
+          origin.Destination(heading_resolve(boat_data.cog), dist2test, &dlat1,
+                             &dlon1);
         } else {
           dist2test = boat_data.dist;
           dlat1 = dlat;
@@ -360,13 +435,18 @@ bool Position::Propagate(IsoRouteList& routelist,
         if (!ConstraintChecker::CheckLandConstraint(
                 configuration, lat, lon, dlat1, dlon1, boat_data.cog)) {
           configuration.land_crossing = true;
+          configuration.rejections.Reject(RejectionHistogram::LAND, bucket);
           continue;
         }
 
         /* Boundary test */
         if (configuration.DetectBoundary) {
+          RoutingPhaseTimer timer(configuration.profile,
+                                  RoutingProfile::BOUNDARY);
           if (EntersBoundary(dlat1, dlon1)) {
             configuration.boundary_crossing = true;
+            configuration.rejections.Reject(RejectionHistogram::BOUNDARY,
+                                            bucket);
             continue;
           }
         }
@@ -374,6 +454,8 @@ bool Position::Propagate(IsoRouteList& routelist,
       /* crosses cyclone track(s)? */
       if (!ConstraintChecker::CheckCycloneTrackConstraint(configuration, lat,
                                                           lon, dlat, dlon)) {
+        configuration.rejections.Reject(RejectionHistogram::CYCLONE_TRACK,
+                                        bucket);
         continue;
       }
 
@@ -429,11 +511,14 @@ wxString Position::GetErrorText(PropagationError error) {
                                    _("Boat speed computation failed"),
                                    _("Exceeded maximum apparent wind"),
                                    _("Land intersection detected"),
+                                   _("Land safety margin exceeded"),
                                    _("Boundary intersection detected"),
                                    _("Cyclone track crossing detected"),
-                                   _("No valid angles found")};
+                                   _("No valid angles found"),
+                                   _("Cannot beat best arrival time"),
+                                   _("Cannot reach destination in time")};
 
-  if (error >= 0 && error <= PROPAGATION_ANGLE_ERROR)
+  if (error >= 0 && error <= PROPAGATION_OUTSIDE_REVERSE_REACH)
     return error_texts[error];
   else
     return _("Unknown error");
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#include <math.h>
+
+#include "RejectionHistogram.h"
+
+void RejectionHistogram::Clear() {
+  for (int j = 0; j < BUCKET_COUNT; j++) m_Tried[j] = 0;
+  for (int i = 0; i < REASON_COUNT; i++) {
+    for (int j = 0; j < BUCKET_COUNT; j++) m_Headings[i][j] = 0;
+    m_Positions[i] = 0;
+  }
+}
+
+void RejectionHistogram::Add(const RejectionHistogram& histogram) {
+  for (int j = 0; j < BUCKET_COUNT; j++) m_Tried[j] += histogram.m_Tried[j];
+  for (int i = 0; i < REASON_COUNT; i++) {
+    for (int j = 0; j < BUCKET_COUNT; j++)
+      m_Headings[i][j] += histogram.m_Headings[i][j];
+    m_Positions[i] += histogram.m_Positions[i];
+  }
+}
+
+int RejectionHistogram::Bucket(double angle) {
+  angle = fmod(fabs(angle), 360);
+  if (angle > 180) angle = 360 - angle;
+  int bucket = int(angle / BUCKET_DEGREES);
+  return bucket < BUCKET_COUNT ? bucket : BUCKET_COUNT - 1;
+}
+
+long RejectionHistogram::Tried() const {
+  long tried = 0;
+  for (int j = 0; j < BUCKET_COUNT; j++) tried += m_Tried[j];
+  return tried;
+}
+
+long RejectionHistogram::Rejected(Reason reason) const {
+  long rejected = 0;
+  for (int j = 0; j < BUCKET_COUNT; j++) rejected += m_Headings[reason][j];
+  return rejected;
+}
+
+long RejectionHistogram::RejectedInBucket(int bucket) const {
+  long rejected = 0;
+  for (int i = 0; i < REASON_COUNT; i++) rejected += m_Headings[i][bucket];
+  return rejected;
+}
+
+const char* RejectionHistogram::ReasonName(Reason reason) {
+  switch (reason) {
+    case SEARCH_ANGLE:
+      return "search_angle";
+    case POLAR:
+      return "polar";
+    case MAX_COURSE_ANGLE:
+      return "max_course_angle";
+    case MAX_DIVERTED_COURSE:
+      return "max_diverted_course";
+    case CORRIDOR:
+      return "corridor";
+    case MAX_APPARENT_WIND:
+      return "max_apparent_wind";
+    case LAND:
+      return "land";
+    case BOUNDARY:
+      return "boundary";
+    case CYCLONE_TRACK:
+      return "cyclone_track";
+    case MAX_SWELL:
+      return "max_swell";
+    case MAX_LATITUDE:
+      return "max_latitude";
+    case MAX_TRUE_WIND:
+      return "max_true_wind";
+    case WIND_VS_CURRENT:
+      return "wind_vs_current";
+    case WIND_DATA:
+      return "wind_data";
+    case HEURISTIC_BOUND:
+      return "heuristic_bound";
+    case REVERSE_REACH:
+      return "reverse_reach";
+    default:
+      return "";
+  }
+}
+
+wxString RejectionHistogram::ToString() const {
+  wxString str = wxString::Format("tried %ld", Tried());
+  for (int i = 0; i < REASON_COUNT; i++) {
+    Reason reason = Reason(i);
+    long headings = Rejected(reason), positions = m_Positions[i];
+    if (headings)
+      str += wxString::Format(", %s %ld", ReasonName(reason), headings);
+    if (positions)
+      str += wxString::Format(", %s %ld positions", ReasonName(reason),
+                              positions);
+  }
+  return str;
+}
+
+void RejectionHistogram::toJson(Json::Value& json) const {
+  json["bucket_degrees"] = int(BUCKET_DEGREES);
+  Json::Value& tried = json["tried"];
+  tried = Json::Value(Json::arrayValue);
+  for (int j = 0; j < BUCKET_COUNT; j++) tried.append(Json::Int64(m_Tried[j]));
+  for (int i = 0; i < REASON_COUNT; i++) {
+    Json::Value& value = json[ReasonName(Reason(i))];
+    Json::Value& headings = value["headings"];
+    headings = Json::Value(Json::arrayValue);
+    for (int j = 0; j < BUCKET_COUNT; j++)
+      headings.append(Json::Int64(m_Headings[i][j]));
+    value["positions"] = Json::Int64(m_Positions[i]);
+  }
+}
@@ -19,7 +19,6 @@
 #include <cstdint>
 
 #include <wx/wx.h>
-#include <wx/progdlg.h>
 
 #include <map>
 
@@ -35,6 +34,27 @@
 
 #include "WeatherRouting.h"
 
+/* computes the report metrics of the queued routes, then notifies the
+   dialog once the queue is empty */
+class ReportThread : public wxThread {
+public:
+  ReportThread(ReportDialog& dialog)
+      : wxThread(wxTHREAD_JOINABLE), m_ReportDialog(dialog) {
+    Create();
+  }
+
+  void* Entry() {
+    ReportDialog::RouteReportJob job;
+    while (!TestDestroy() && m_ReportDialog.NextRouteReportJob(job)) {
+      ReportDialog::ComputeRouteReport(job);
+      m_ReportDialog.AddRouteReport(job);
+    }
+    return 0;
+  }
+
+  ReportDialog& m_ReportDialog;
+};
+
 ReportDialog::ReportDialog(WeatherRouting& weatherrouting)
 #ifndef __WXOSX__
     : ReportDialogBase(&weatherrouting),
@@ -44,7 +64,12 @@ ReportDialog::ReportDialog(WeatherRouting& weatherrouting)
           wxDefaultPosition, wxDefaultSize,
           wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER | wxSTAY_ON_TOP),
 #endif
-      m_WeatherRouting(weatherrouting) {
+      m_WeatherRouting(weatherrouting),
+      m_RouteReportInProgress(nullptr),
+      m_bReportThreadDone(false),
+      m_ReportThread(nullptr) {
+  Connect(wxEVT_THREAD, wxThreadEventHandler(ReportDialog::OnReportThread));
+
   m_bReportStale = true;
   SetRouteMapOverlays(std::list<RouteMapOverlay*>());
 #ifdef __OCPN__ANDROID__
@@ -53,8 +78,168 @@ ReportDialog::ReportDialog(WeatherRouting& weatherrouting)
 #endif
 }
 
+ReportDialog::~ReportDialog() { StopReportThread(); }
+
+void ReportDialog::RemoveRouteMapOverlay(RouteMapOverlay* routemapoverlay) {
+  bool in_progress;
+  {
+    wxMutexLocker lock(m_ReportMutex);
+    in_progress = m_RouteReportInProgress == routemapoverlay;
+  }
+  // wait for the route to be done with, the other jobs stay queued
+  if (in_progress) StopReportThread();
+
+  {
+    wxMutexLocker lock(m_ReportMutex);
+    auto is_route = [routemapoverlay](const RouteReportJob& job) {
+      return job.routemapoverlay == routemapoverlay;
+    };
+    m_RouteReportJobs.remove_if(is_route);
+    m_FinishedRouteReports.remove_if(is_route);
+  }
+
+  m_RouteReports.erase(routemapoverlay);
+  m_PendingRouteReports.erase(routemapoverlay);
+  m_RouteMapOverlays.remove(routemapoverlay);
+  m_bReportStale = true;
+
+  if (in_progress) StartReportThread();
+}
+
+bool ReportDialog::NextRouteReportJob(RouteReportJob& job) {
+  wxMutexLocker lock(m_ReportMutex);
+  m_RouteReportInProgress = nullptr;
+  if (m_RouteReportJobs.empty()) {
+    m_bReportThreadDone = true;
+    wxThreadEvent event(wxEVT_THREAD);
+    AddPendingEvent(event);
+    return false;
+  }
+
+  job = std::move(m_RouteReportJobs.front());
+  m_RouteReportJobs.pop_front();
+  m_RouteReportInProgress = job.routemapoverlay;
+  return true;
+}
+
+void ReportDialog::ComputeRouteReport(RouteReportJob& job) {
+  RouteMapOverlay* r = job.routemapoverlay;
+  RouteReport& report = job.report;
+  const std::list<PlotData>& plotdata = job.plotdata;
+
+  double info[RouteMapOverlay::ROUTE_INFO_TYPES];
+  r->RouteInfo(plotdata, info);
+  report.Distance = info[RouteMapOverlay::DISTANCE];
+  report.AvgSpeed = info[RouteMapOverlay::AVGSPEED];
+  report.AvgSpeedGround = info[RouteMapOverlay::AVGSPEEDGROUND];
+  report.AvgWind = info[RouteMapOverlay::AVGWIND];
+  report.MaxWind = info[RouteMapOverlay::MAXWIND];
+  report.AvgSwell = info[RouteMapOverlay::AVGSWELL];
+  report.PercentageUpwind = info[RouteMapOverlay::PERCENTAGE_UPWIND];
+  report.PortStarboard = info[RouteMapOverlay::PORT_STARBOARD];
+  report.Comfort = info[RouteMapOverlay::COMFORT];
+
+  // the cyclone crossings are the slowest part, Cyclones() locks the route
+  for (int i = 0; i < 12; i++) report.CycloneMonths[i] = 0;
+  report.Cyclones = r->Cyclones(report.CycloneMonths);
+
+  job.plotdata.clear();
+}
+
+void ReportDialog::AddRouteReport(const RouteReportJob& job) {
+  wxMutexLocker lock(m_ReportMutex);
+  m_FinishedRouteReports.push_back(job);
+}
+
+void ReportDialog::QueueRouteReport(RouteMapOverlay* routemapoverlay) {
+  if (m_RouteReports.find(routemapoverlay) != m_RouteReports.end() ||
+      m_PendingRouteReports.find(routemapoverlay) !=
+          m_PendingRouteReports.end())
+    return;
+
+  RouteReportJob job;
+  job.routemapoverlay = routemapoverlay;
+  job.plotdata = routemapoverlay->GetPlotData(false);
+
+  RouteReport& report = job.report;
+  std::shared_ptr<const RouteMapConfiguration> c =
+      routemapoverlay->GetConfigurationSnapshot();
+  report.BoatFileName = c->boatFileName;
+  if (c->StartType == RouteMapConfiguration::START_FROM_BOAT)
+    report.Start = _("Boat");
+  else
+    report.Start = c->Start;
+  report.End = c->End;
+  report.GreatCircleDistance =
+      DistGreatCircle_Plugin(c->StartLat, c->StartLon, c->EndLat, c->EndLon);
+  report.StartTime = routemapoverlay->StartTime();
+  report.EndTime = routemapoverlay->EndTime();
+
+  Position* d = routemapoverlay->GetDestination();
+  report.HasDestination = d != nullptr;
+  report.Tacks = d ? d->tacks : 0;
+  report.Jibes = d ? d->jibes : 0;
+
+  m_PendingRouteReports.insert(routemapoverlay);
+  {
+    wxMutexLocker lock(m_ReportMutex);
+    m_RouteReportJobs.push_back(std::move(job));
+  }
+  StartReportThread();
+}
+
+void ReportDialog::StartReportThread() {
+  {
+    wxMutexLocker lock(m_ReportMutex);
+    if (m_RouteReportJobs.empty()) return;
+    if (m_ReportThread && !m_bReportThreadDone) return;
+  }
+
+  // the previous thread ran out of work, reap it before starting anew
+  StopReportThread();
+
+  m_bReportThreadDone = false;
+  m_ReportThread = new ReportThread(*this);
+  m_ReportThread->Run();
+}
+
+void ReportDialog::StopReportThread() {
+  if (!m_ReportThread) return;
+
+  m_ReportThread->Delete();
+  delete m_ReportThread;
+  m_ReportThread = nullptr;
+}
+
+void ReportDialog::OnReportThread(wxThreadEvent& event) {
+  std::list<RouteReportJob> finished;
+  bool done;
+  {
+    wxMutexLocker lock(m_ReportMutex);
+    finished.swap(m_FinishedRouteReports);
+    done = m_bReportThreadDone;
+  }
+
+  if (done) StopReportThread();
+
+  for (const RouteReportJob& job : finished) {
+    // dropped if the route was removed while being computed
+    if (!m_PendingRouteReports.erase(job.routemapoverlay)) continue;
+    m_RouteReports[job.routemapoverlay] = job.report;
+  }
+
+  // more routes may have been queued after the thread ran out of work
+  StartReportThread();
+
+  if (finished.empty()) return;
+
+  m_bReportStale = true;
+  if (IsShown()) SetRouteMapOverlays(m_RouteMapOverlays);
+}
+
 void ReportDialog::SetRouteMapOverlays(
     std::list<RouteMapOverlay*> routemapoverlays) {
+  m_RouteMapOverlays = routemapoverlays;
   GenerateRoutesReport();
 
   if (routemapoverlays.empty()) {
@@ -71,34 +256,34 @@ void ReportDialog::SetRouteMapOverlays(
       continue;
     }
 
-    RouteMapConfiguration c = (*it)->GetConfiguration();
-    Position* d = (*it)->GetDestination();
+    QueueRouteReport(*it);
+    std::map<RouteMapOverlay*, RouteReport>::iterator rit =
+        m_RouteReports.find(*it);
+    if (rit == m_RouteReports.end()) {
+      page += _("Computing report...");
+      continue;
+    }
+    const RouteReport& r = rit->second;
 
     page += _("Boat Filename") + _T(" ") +
-            wxFileName(c.boatFileName).GetName() + _T("<dt>");
-    if (c.StartType == RouteMapConfiguration::START_FROM_BOAT) {
-      page += _("Route from ") + _("Boat") + _(" to ") + c.End + _T("<dt>");
-    } else {
-      page += _("Route from ") + c.Start + _(" to ") + c.End + _T("<dt>");
-    }
-    page += _("Leaving ") + FormatTime((*it)->StartTime()) + _T("<dt>");
-    if (d) {
-      page += _("Arriving ") + FormatTime((*it)->EndTime()) + _T("<dt>");
-      page += _("Duration ") +
-              ((*it)->EndTime() - (*it)->StartTime()).Format() + _T("<dt>");
+            wxFileName(r.BoatFileName).GetName() + _T("<dt>");
+    page += _("Route from ") + r.Start + _(" to ") + r.End + _T("<dt>");
+    page += _("Leaving ") + FormatTime(r.StartTime) + _T("<dt>");
+    if (r.HasDestination) {
+      page += _("Arriving ") + FormatTime(r.EndTime) + _T("<dt>");
+      page += _("Duration ") + (r.EndTime - r.StartTime).Format() + _T("<dt>");
     }
     page += _T("<p>");
-    double distance =
-        DistGreatCircle_Plugin(c.StartLat, c.StartLon, c.EndLat, c.EndLon);
-    double distance_sailed = (*it)->RouteInfo(RouteMapOverlay::DISTANCE);
+    double distance = r.GreatCircleDistance;
+    double distance_sailed = r.Distance;
     page += _("Distance sailed: ") +
             wxString::Format(_T("%.2f NMi : %.2f NMi or %.2f%% "),
                              distance_sailed, distance_sailed - distance,
                              (distance_sailed / distance - 1) * 100.0) +
             _("longer than great circle route") + _T("<br>");
 
-    double avgspeed = (*it)->RouteInfo(RouteMapOverlay::AVGSPEED);
-    double avgspeedground = (*it)->RouteInfo(RouteMapOverlay::AVGSPEEDGROUND);
+    double avgspeed = r.AvgSpeed;
+    double avgspeedground = r.AvgSpeedGround;
     page += _("Average Speed Over Water (SOW)") + wxString(_T(": ")) +
             wxString::Format(_T(" %.1f"), avgspeed) + _T(" ") + _("knots") +
             _T("<dt>");
@@ -106,30 +291,23 @@ void ReportDialog::SetRouteMapOverlays(
             wxString::Format(_T(" %.1f"), avgspeedground) + _T(" ") +
             _("knots") + _T("<dt>");
     page += _("Average Wind") + wxString(_T(": ")) +
-            wxString::Format(_T(" %.1f"),
-                             (*it)->RouteInfo(RouteMapOverlay::AVGWIND)) +
-            _T(" ") + _("knots") + _T("<dt>");
+            wxString::Format(_T(" %.1f"), r.AvgWind) + _T(" ") + _("knots") +
+            _T("<dt>");
 
     // CUSTOMIZATION
     // Add max wind. I think this is more important than the average
     // wind as it gives an indication on how strong will be the sailing
     // conditions, and if the crew has sufficient experience to handle it.
     page += _("Maximum Wind") + wxString(_T(": ")) +
-            wxString::Format(_T(" %.1f"),
-                             (*it)->RouteInfo(RouteMapOverlay::MAXWIND)) +
-            _T(" ") + _("knots") + _T("<dt>");
-    ;
+            wxString::Format(_T(" %.1f"), r.MaxWind) + _T(" ") + _("knots") +
+            _T("<dt>");
 
     page += _("Average Swell") + wxString(_T(": ")) +
-            wxString::Format(_T(" %.1f"),
-                             (*it)->RouteInfo(RouteMapOverlay::AVGSWELL)) +
-            _T(" ") + _("meters") + _T("<dt>");
-    page +=
-        _("Upwind") + wxString(_T(": ")) +
-        wxString::Format(_T(" %.1f%%"),
-                         (*it)->RouteInfo(RouteMapOverlay::PERCENTAGE_UPWIND)) +
-        _T("<dt>");
-    double port_starboard = (*it)->RouteInfo(RouteMapOverlay::PORT_STARBOARD);
+            wxString::Format(_T(" %.1f"), r.AvgSwell) + _T(" ") +
+            _("meters") + _T("<dt>");
+    page += _("Upwind") + wxString(_T(": ")) +
+            wxString::Format(_T(" %.1f%%"), r.PercentageUpwind) + _T("<dt>");
+    double port_starboard = r.PortStarboard;
     page += _("Port/Starboard") + wxString(_T(": ")) +
             (std::isnan(port_starboard)
                  ? _T("nan")
@@ -137,19 +315,17 @@ void ReportDialog::SetRouteMapOverlays(
                                     100 - (int)port_starboard)) +
             _T("<dt>");
 
-    if (d) {
-      page += _("Number of tacks") + wxString::Format(_T(": %d "), d->tacks) +
+    if (r.HasDestination) {
+      page += _("Number of tacks") + wxString::Format(_T(": %d "), r.Tacks) +
               _T("<dt>");
-      page += _("Number of jibes") + wxString::Format(_T(": %d "), d->jibes) +
+      page += _("Number of jibes") + wxString::Format(_T(": %d "), r.Jibes) +
               _T("<dt>");
     }
 
     // CUSTOMIZATION
     // Display sailing comfort in the report
     page += _("Sailing comfort") + wxString(_T(": ")) +
-            (*it)->sailingConditionText(
-                (*it)->RouteInfo(RouteMapOverlay::COMFORT)) +
-            _T("<dt>\n");
+            RouteMapOverlay::sailingConditionText(r.Comfort) + _T("<dt>\n");
 
     /* determine if currents significantly improve this (boat over ground speed
        average is 10% or more faster than boat over water)  then attempt to
@@ -201,70 +377,76 @@ void ReportDialog::GenerateRoutesReport() {
      and cyclone crossings to determine cyclone times
   */
 
-  std::map<wxString, std::list<RouteMapOverlay*> > routes;
+  /* the metrics of each route are computed once on the report thread, so a
+     newly finished route only adds its own metrics to the report */
+  std::map<wxString, std::list<const RouteReport*> > routes;
+  int pending = 0;
   for (std::list<WeatherRoute*>::iterator it =
            m_WeatherRouting.m_WeatherRoutes.begin();
        it != m_WeatherRouting.m_WeatherRoutes.end(); it++) {
-    if (!(*it)->routemapoverlay->ReachedDestination()) continue;
+    RouteMapOverlay* routemapoverlay = (*it)->routemapoverlay;
+    if (!routemapoverlay->ReachedDestination()) continue;
+    QueueRouteReport(routemapoverlay);
+    std::map<RouteMapOverlay*, RouteReport>::iterator rit =
+        m_RouteReports.find(routemapoverlay);
+    if (rit == m_RouteReports.end()) {
+      pending++;
+      continue;
+    }
     wxString route_string = (*it)->Start + _T(" - ") + (*it)->End;
-    std::list<RouteMapOverlay*> overlays = routes[route_string];
-    overlays.push_back((*it)->routemapoverlay);
-    routes[route_string] = overlays;
+    routes[route_string].push_back(&rit->second);
   }
 
+  wxString page;
+  if (pending)
+    page += wxString::Format(_("Computing report for %d routes..."), pending);
+
   if (routes.size() == 0) {
-    m_htmlRoutesReport->SetPage(_("No routes to report yet."));
+    if (!pending) page = _("No routes to report yet.");
+    m_htmlRoutesReport->SetPage(page);
     return;
   }
 
-  wxString page;
-  for (std::map<wxString, std::list<RouteMapOverlay*> >::iterator it =
+  for (std::map<wxString, std::list<const RouteReport*> >::iterator it =
            routes.begin();
        it != routes.end(); it++) {
-    std::list<RouteMapOverlay*> overlays = it->second;
-    if (overlays.begin() == overlays.end()) {
-      // XXX not possible? but shut up compilers warnings
-      continue;
-    }
-    RouteMapOverlay* first = *overlays.begin();
+    std::list<const RouteReport*>& overlays = it->second;
+    const RouteReport* first = *overlays.begin();
 
-    RouteMapConfiguration c = first->GetConfiguration();
     page += _T("<p>");
-    page += c.Start + _T(" ") + _("to") + _T(" ") + c.End + _T(" ") +
+    page += first->Start + _T(" ") + _("to") + _T(" ") + first->End + _T(" ") +
             wxString::Format(
                 _T("(%ld ") + wxString(_("configurations")) + _T(")\n"),
                 overlays.size());
 
     /* determine fastest time */
     wxTimeSpan fastest_time;
-    RouteMapOverlay* fastest = nullptr;
+    const RouteReport* fastest = nullptr;
 
-    std::multimap<wxDateTime, RouteMapOverlay*> sort_by_start;
+    std::multimap<wxDateTime, const RouteReport*> sort_by_start;
     bool any_bad = false;
     bool any_good = false;
 
-    for (std::list<RouteMapOverlay*>::iterator it2 = overlays.begin();
+    for (std::list<const RouteReport*>::iterator it2 = overlays.begin();
          it2 != overlays.end(); it2++) {
-      RouteMapOverlay* r = *it2;
-      wxTimeSpan current_time = r->EndTime() - r->StartTime();
+      const RouteReport* r = *it2;
+      wxTimeSpan current_time = r->EndTime - r->StartTime;
       sort_by_start.insert(
-          std::pair<wxDateTime, RouteMapOverlay*>(r->StartTime(), r));
+          std::pair<wxDateTime, const RouteReport*>(r->StartTime, r));
       if (r == first || current_time < fastest_time) {
         fastest_time = current_time;
         fastest = r;
       }
-      if (r->RouteInfo(RouteMapOverlay::PERCENTAGE_UPWIND) > 50) {
+      if (r->PercentageUpwind > 50) {
         any_bad = true;
       } else {
         any_good = true;
       }
     }
 
-    page += _("<dt>Fastest configuration ") + FormatTime(fastest->StartTime());
+    page += _("<dt>Fastest configuration ") + FormatTime(fastest->StartTime);
     page += wxString(_T(" ")) + _("avg speed") +
-            wxString::Format(_T(": %.1f "),
-                             fastest->RouteInfo(RouteMapOverlay::AVGSPEED)) +
-            _("knots");
+            wxString::Format(_T(": %.1f "), fastest->AvgSpeed) + _("knots");
 
     /* determine best times if upwind percentage is below 50 */
     page += _T("<dt>");
@@ -277,33 +459,33 @@ void ReportDialog::GenerateRoutesReport() {
       page += _("any");
     } else {
       bool first_print = true;
-      std::multimap<wxDateTime, RouteMapOverlay*> reduce_by_start;
+      std::multimap<wxDateTime, const RouteReport*> reduce_by_start;
       // merge downwind routes in bigger interval
       // assume most routes with same start time are of same kind (downwind or
       // upwind)
-      std::multimap<wxDateTime, RouteMapOverlay*>::iterator it =
+      std::multimap<wxDateTime, const RouteReport*>::iterator it =
           sort_by_start.begin();
       while (it != sort_by_start.end()) {
         // remove first upwind routes, from any_good test there's at least one
         // downwind route
         for (; it != sort_by_start.end(); it++) {
-          RouteMapOverlay* r = it->second;
-          if (r->RouteInfo(RouteMapOverlay::PERCENTAGE_UPWIND) <= 50) {
+          const RouteReport* r = it->second;
+          if (r->PercentageUpwind <= 50) {
             break;
           }
         }
         if (it == sort_by_start.end()) break;
 
-        RouteMapOverlay* r = it->second;
-        wxDateTime s = DisplayedTime(r->StartTime());
-        wxDateTime e = DisplayedTime(r->EndTime());
+        const RouteReport* r = it->second;
+        wxDateTime s = DisplayedTime(r->StartTime);
+        wxDateTime e = DisplayedTime(r->EndTime);
         // merge downwind
         for (; it != sort_by_start.end(); it++) {
-          RouteMapOverlay* r = it->second;
-          if (r->RouteInfo(RouteMapOverlay::PERCENTAGE_UPWIND) > 50) {
+          const RouteReport* r = it->second;
+          if (r->PercentageUpwind > 50) {
             break;
           }
-          e = r->EndTime();
+          e = r->EndTime;
         }
         if (first_print)
           first_print = false;
@@ -320,15 +502,15 @@ void ReportDialog::GenerateRoutesReport() {
     page += _("Best Sailing Comfort") + wxString(_T(": "));
     wxDateTime best_comfort_date;
     int best_sailing_comfort = 6;
-    for (std::multimap<wxDateTime, RouteMapOverlay*>::iterator it3 =
+    for (std::multimap<wxDateTime, const RouteReport*>::iterator it3 =
              sort_by_start.begin();
          it3 != sort_by_start.end(); it3++) {
-      RouteMapOverlay* r = it3->second;
+      const RouteReport* r = it3->second;
       if (!best_comfort_date.IsValid() ||
-          (best_comfort_date < r->StartTime() &&
-           best_sailing_comfort > r->RouteInfo(RouteMapOverlay::COMFORT))) {
-        best_comfort_date = r->StartTime();
-        best_sailing_comfort = r->RouteInfo(RouteMapOverlay::COMFORT);
+          (best_comfort_date < r->StartTime &&
+           best_sailing_comfort > r->Comfort)) {
+        best_comfort_date = r->StartTime;
+        best_sailing_comfort = r->Comfort;
       }
     }
     page += RouteMapOverlay::sailingConditionText(best_sailing_comfort);
@@ -338,17 +520,14 @@ void ReportDialog::GenerateRoutesReport() {
     page += _T("<dt>");
     page += _("Cyclones") + wxString(_T(": "));
 
-    wxProgressDialog progressdialog(_("Weather Routing"),
-                                    _("Calculating Cyclone Crossings"),
-                                    overlays.size(), this, wxPD_ELAPSED_TIME);
-    int pdi = 0;
-
     int cyclonemonths[12] = {0};
-    std::list<RouteMapOverlay*> cyclone_safe_routes;
+    std::list<const RouteReport*> cyclone_safe_routes;
     bool allsafe = true, nonesafe = true;
-    for (std::list<RouteMapOverlay*>::iterator it2 = overlays.begin();
+    for (std::list<const RouteReport*>::iterator it2 = overlays.begin();
          it2 != overlays.end(); it2++) {
-      switch ((*it2)->Cyclones(cyclonemonths)) {
+      for (int i = 0; i < 12; i++)
+        cyclonemonths[i] += (*it2)->CycloneMonths[i];
+      switch ((*it2)->Cyclones) {
         case -1:
           page += _("Climatology data unavailable.");
           goto cyclonesfailed;
@@ -359,8 +538,6 @@ void ReportDialog::GenerateRoutesReport() {
           cyclone_safe_routes.push_back(NULL);
           allsafe = false;
       }
-
-      progressdialog.Update(pdi++);
     }
 
     int i, j;
@@ -397,13 +574,13 @@ void ReportDialog::GenerateRoutesReport() {
       /* note: does not merge beginning and end of linked list for safe times,
          this sometimes might be nice, but they will be in different years. */
       bool first = true;
-      for (std::list<RouteMapOverlay*>::iterator it2 =
+      for (std::list<const RouteReport*>::iterator it2 =
                cyclone_safe_routes.begin();
            it2 != cyclone_safe_routes.end(); it2++) {
         if (!*it2) continue;
         if (!first) page += _(" and ");
         first = false;
-        page += DisplayedTime((*it2)->StartTime()).Format(_T("%x"));
+        page += DisplayedTime((*it2)->StartTime).Format(_T("%x"));
 
         if (++it2 == cyclone_safe_routes.end()) break;
 
@@ -412,7 +589,7 @@ void ReportDialog::GenerateRoutesReport() {
         while (*it2 && ++it2 != cyclone_safe_routes.end());
 
         it2--;
-        page += _(" to ") + DisplayedTime((*it2)->StartTime()).Format(_T("%x"));
+        page += _(" to ") + DisplayedTime((*it2)->StartTime).Format(_T("%x"));
       }
     }
   cyclonesfailed:;
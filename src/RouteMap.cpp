@@ -74,9 +74,11 @@
 #include "Utilities.h"
 #include "Boat.h"
 #include "ConstraintChecker.h"
+#include "Geodesy.h"
 #include "RoutePoint.h"
 #include "IsoRoute.h"
 #include "RouteMap.h"
+#include "RoutingTrace.h"
 #include "SunCalculator.h"
 #include "WeatherDataProvider.h"
 #include "weather_routing_pi.h"
@@ -85,6 +87,10 @@
 
 long RouteMapPosition::s_ID = 0;
 
+/* time step and angular resolution multiplier for the coarse pass of a
+   multi resolution route */
+#define MULTI_RESOLUTION_FACTOR 3
+
 Shared_GribRecordSetData::~Shared_GribRecordSetData() {
   delete m_GribRecordSet;
 }
@@ -93,14 +99,24 @@ weather_routing_pi* RouteMapConfiguration::s_plugin_instance = nullptr;
 
 RouteMapConfiguration::RouteMapConfiguration()
     : StartType(START_FROM_POSITION),
+      boat(std::make_shared<const Boat>()),
       UpwindEfficiency(1.),
       DownwindEfficiency(1.),
       NightCumulativeEfficiency(1.),
+      HeuristicPruning(false),
+      Bidirectional(false),
+      MultiResolution(false),
+      CorridorWidth(100),
       UseMotor(false),
       MotorSpeedThreshold(2.0),
       MotorSpeed(5.0),
       StartLon(0),
       EndLon(0),
+      HeuristicSpeedBound(0),
+      HeuristicTimeBound(NAN),
+      ReverseTime(false),
+      ReverseReach(nullptr),
+      FinePass(false),
       grib(nullptr),
       grib_is_data_deficient(false) {}
 
@@ -188,14 +204,18 @@ bool RouteMapConfiguration::Update() {
     if (FromDegree > ToDegree) FromDegree = ToDegree;
     ByDegrees = wxMax(wxMin(ByDegrees, 60), .1);
 
-    for (double step = FromDegree; step <= ToDegree; step += ByDegrees) {
+    double by_degrees = ByDegrees;
+    if (CoarsePass())
+      by_degrees = wxMin(by_degrees * MULTI_RESOLUTION_FACTOR, 60);
+
+    for (double step = FromDegree; step <= ToDegree; step += by_degrees) {
       DegreeSteps.push_back(step);
       if (step > 0 && step < 180) DegreeSteps.push_back(360 - step);
     }
   } else {
     DegreeSteps.push_back(0.);
   }
-  DegreeSteps.sort();
+  std::sort(DegreeSteps.begin(), DegreeSteps.end());
 
   return true;
 }
@@ -214,7 +234,10 @@ OD_FindClosestBoundaryLineCrossing RouteMap::ODFindClosestBoundaryLineCrossing =
 
 std::list<RouteMapPosition> RouteMap::Positions;
 
-RouteMap::RouteMap() {}
+RouteMap::RouteMap()
+    : m_HeuristicMaxCurrent(0), m_HeuristicGrib(nullptr) {
+  UpdateConfigurationSnapshot();
+}
 
 RouteMap::~RouteMap() { Clear(); }
 
@@ -229,6 +252,7 @@ void RouteMap::PositionLatLon(wxString Name, double& lat, double& lon) {
 
 bool RouteMap::ReduceList(IsoRouteList& merged, IsoRouteList& routelist,
                           RouteMapConfiguration& configuration) {
+  RoutingTraceSpan trace("ReduceList", "routing");
   IsoRouteList unmerged;
   while (!routelist.empty()) {
     IsoRoute* r1 = routelist.front();
@@ -256,6 +280,28 @@ bool RouteMap::ReduceList(IsoRouteList& merged, IsoRouteList& routelist,
   return true;
 }
 
+/* sailing backwards in time from the destination is sailing forwards from it
+   with the wind and current reversed. The constraints on how the boat got
+   somewhere are dropped, so the backward front does not miss any position
+   the destination can be reached from. Positions which cannot be reached
+   from the start in time are pruned with the heuristic bound. */
+static void ReverseConfiguration(RouteMapConfiguration& configuration) {
+  std::swap(configuration.StartLat, configuration.EndLat);
+  std::swap(configuration.StartLon, configuration.EndLon);
+  ll_gc_ll_reverse(configuration.StartLat, configuration.StartLon,
+                   configuration.EndLat, configuration.EndLon,
+                   &configuration.StartEndBearing, nullptr);
+  configuration.MaxDivertedCourse = 180;
+  configuration.MaxCourseAngle = 180;
+  configuration.MaxSearchAngle = 180;
+  configuration.TackingTime = 0;
+  configuration.JibingTime = 0;
+  configuration.SailPlanChangeTime = 0;
+  configuration.HeuristicPruning = true;
+  configuration.Corridor.clear();
+  configuration.CorridorCells.reset();
+}
+
 /* enlarge the map by 1 level */
 bool RouteMap::Propagate() {
   Lock();
@@ -271,12 +317,30 @@ bool RouteMap::Propagate() {
     return false;
   }
 
+  RoutingTraceSpan trace("Propagate", "routing");
+
   //
   RouteMapConfiguration configuration = m_Configuration;
   configuration.polar_status = POLAR_SPEED_SUCCESS;
   configuration.wind_data_status = wxEmptyString;
   configuration.boundary_crossing = false;
   configuration.land_crossing = false;
+  configuration.profile.Clear();
+  configuration.rejections.Clear();
+  if (m_GribRequestTime != std::chrono::steady_clock::time_point()) {
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    std::chrono::duration<double> wait = now - m_GribRequestTime;
+    configuration.profile.Record(RoutingProfile::GRIB_WAIT, wait.count());
+    RoutingTrace::Span("GribWait", "grib", m_GribRequestTime, now);
+    m_GribRequestTime = std::chrono::steady_clock::time_point();
+  }
+  // the fine pass takes care of land, unless the coarse pass bounds the
+  // arrival time, which must then be reachable
+  if (configuration.CoarsePass() && !configuration.HeuristicPruning &&
+      !configuration.Bidirectional)
+    configuration.DetectLand = false;
+  if (configuration.ReverseTime) ReverseConfiguration(configuration);
 
   // reset grib data deficient flag
   bool grib_is_data_deficient = false;
@@ -302,8 +366,15 @@ bool RouteMap::Propagate() {
   // request the next grib
   // in a different thread (grib record averaging going in parallel)
   delta = DetermineDeltaTime();
-  m_NewTime += wxTimeSpan(0, 0, delta);
+  if (configuration.ReverseTime) {
+    // the reverse pass goes back to the start time, and no further
+    double left = (m_NewTime - configuration.StartTime).GetSeconds().ToDouble();
+    delta = wxMin(delta, left);
+    m_NewTime -= wxTimeSpan(0, 0, delta);
+  } else
+    m_NewTime += wxTimeSpan(0, 0, delta);
   m_bNeedsGrib = configuration.UseGrib;
+  if (m_bNeedsGrib) m_GribRequestTime = std::chrono::steady_clock::now();
 
   Unlock();
 
@@ -321,6 +392,13 @@ bool RouteMap::Propagate() {
     configuration.UsedDeltaTime = origin.back()->delta;
     configuration.grib_is_data_deficient =
         origin.back()->m_Grib_is_data_deficient;
+    if (configuration.ReverseTime) {
+      // A step back in time is sailed forwards from the earlier time, with
+      // the weather of that time.
+      configuration.grib = shared_grib.GetGribRecordSet();
+      configuration.time = time;
+      configuration.grib_is_data_deficient = grib_is_data_deficient;
+    }
     // will the grib data work for us?
     if (m_Configuration.UseGrib &&
         (!configuration.grib ||
@@ -361,6 +439,17 @@ bool RouteMap::Propagate() {
       return false;
     }
 
+    if (configuration.HeuristicPruning) UpdateHeuristicBounds(configuration);
+    if (configuration.ReverseTime)
+      configuration.HeuristicTimeBound =
+          (origin.back()->time - configuration.StartTime)
+              .GetSeconds()
+              .ToDouble() +
+          configuration.DeltaTime;
+    else
+      configuration.ReverseReach = ReverseReach(configuration.time);
+
+    RoutingPhaseTimer timer(configuration.profile, RoutingProfile::PROPAGATE);
     origin.back()->PropagateIntoList(routelist, configuration);
   }
 
@@ -369,10 +458,14 @@ bool RouteMap::Propagate() {
     update = nullptr;
   } else {
     IsoRouteList merged;
-    if (!ReduceList(merged, routelist, configuration)) return false;
+    {
+      RoutingPhaseTimer timer(configuration.profile, RoutingProfile::MERGE);
+      if (!ReduceList(merged, routelist, configuration)) return false;
 
-    for (IsoRouteList::iterator it = merged.begin(); it != merged.end(); ++it)
-      (*it)->ReduceClosePoints();
+      for (IsoRouteList::iterator it = merged.begin(); it != merged.end();
+           ++it)
+        (*it)->ReduceClosePoints();
+    }
 
     update =
         new IsoChron(merged, time, delta, shared_grib, grib_is_data_deficient);
@@ -381,7 +474,11 @@ bool RouteMap::Propagate() {
   Lock();
   if (update) {
     origin.push_back(update);
-    if (update->Contains(m_Configuration.EndLat, m_Configuration.EndLon)) {
+    if (configuration.ReverseTime) {
+      // the reverse pass is done at the start time, the fine pass follows
+      if (time <= configuration.StartTime) SetFinished(false);
+    } else if (update->Contains(m_Configuration.EndLat,
+                                m_Configuration.EndLon)) {
       SetFinished(true);  // Route reached the destination
     }
   } else {
@@ -402,7 +499,10 @@ bool RouteMap::Propagate() {
 }
 
 double RouteMap::DetermineDeltaTime() {
-  double deltaTime = m_Configuration.DeltaTime;
+  double configuredDeltaTime = m_Configuration.DeltaTime;
+  if (m_Configuration.CoarsePass())
+    configuredDeltaTime *= MULTI_RESOLUTION_FACTOR;
+  double deltaTime = configuredDeltaTime;
 
   // Find the closest position to source and destination in the last isochrone.
   double minDistToEnd = INFINITY;
@@ -437,10 +537,12 @@ double RouteMap::DetermineDeltaTime() {
           failedPropagations++;
         }
 
+        // only compared against the proximity threshold, the spherical
+        // distance is accurate enough and much cheaper
         double distFromSource =
-            DistGreatCircle(pos->lat, pos->lon, m_Configuration.StartLat,
-                            m_Configuration.StartLon);
-        double distToDest = DistGreatCircle(
+            FastDistance(pos->lat, pos->lon, m_Configuration.StartLat,
+                         m_Configuration.StartLon);
+        double distToDest = FastDistance(
             pos->lat, pos->lon, m_Configuration.EndLat, m_Configuration.EndLon);
         minDistToEnd = std::min(minDistToEnd, distToDest);
         maxDistFromStart = std::max(maxDistFromStart, distFromSource);
@@ -469,7 +571,7 @@ double RouteMap::DetermineDeltaTime() {
     deltaTime *= std::min(startReductionFactor, endReductionFactor);
   } else {
     // For the first step, use the minimum reduction factor.
-    deltaTime = m_Configuration.DeltaTime * minReductionFactor;
+    deltaTime = configuredDeltaTime * minReductionFactor;
   }
 
   // Ensure delta time doesn't go below a reasonable minimum.
@@ -479,6 +581,68 @@ double RouteMap::DetermineDeltaTime() {
   return std::max(deltaTime, minDeltaTime);
 }
 
+/* The climatology currents cannot be scanned ahead of time, so assume the
+   strongest ocean currents (Gulf Stream, Agulhas) when they may be used. */
+#define HEURISTIC_CLIMATOLOGY_MAX_CURRENT 5.0
+
+void RouteMap::UpdateHeuristicBounds(RouteMapConfiguration& configuration) {
+  configuration.HeuristicSpeedBound = 0;
+  configuration.HeuristicTimeBound = NAN;
+
+  /* the climatology wind speeds are not limited by MaxTrueWindKnots, so the
+     boat speed has no bound */
+  if (configuration.ClimatologyType > RouteMapConfiguration::CURRENTS_ONLY &&
+      RouteMap::ClimatologyData)
+    return;
+
+  /* fastest speed through water, Speed() extrapolates above the polar */
+  double speed = configuration.boat->MaxSpeed(configuration.MaxTrueWindKnots) *
+                 wxMax(1.0, wxMax(configuration.UpwindEfficiency,
+                                  configuration.DownwindEfficiency)) *
+                 wxMax(1.0, configuration.NightCumulativeEfficiency);
+  if (configuration.UseMotor) speed = wxMax(speed, configuration.MotorSpeed);
+  if (speed <= 0) return;
+
+  /* strongest current which can be added to it */
+  if (configuration.Currents) {
+    WR_GribRecordSet* grib = configuration.grib;
+    if (grib && grib != m_HeuristicGrib) {
+      m_HeuristicGrib = grib;
+      GribRecord* grx = grib->m_GribRecordPtrArray[Idx_SEACURRENT_VX];
+      GribRecord* gry = grib->m_GribRecordPtrArray[Idx_SEACURRENT_VY];
+      if (grx && gry && grx->getNi() == gry->getNi() &&
+          grx->getNj() == gry->getNj()) {
+        for (int i = 0; i < grx->getNi(); i++)
+          for (int j = 0; j < grx->getNj(); j++) {
+            if (!grx->isDefined(i, j) || !gry->isDefined(i, j)) continue;
+            double vx = grx->getValue(i, j), vy = gry->getValue(i, j);
+            double current = sqrt(vx * vx + vy * vy) * 3.6 / 1.852;  // knots
+            m_HeuristicMaxCurrent = wxMax(m_HeuristicMaxCurrent, current);
+          }
+      }
+    }
+    speed += m_HeuristicMaxCurrent;
+    if (configuration.ClimatologyType != RouteMapConfiguration::DISABLED &&
+        RouteMap::ClimatologyData)
+      speed += HEURISTIC_CLIMATOLOGY_MAX_CURRENT;
+  }
+  configuration.HeuristicSpeedBound = speed;
+
+  /* the coarse pass sailed to the destination with the weather of each step,
+     the full pass should not arrive later than a step after it */
+  if (m_HeuristicArrival.IsValid())
+    configuration.HeuristicTimeBound =
+        (m_HeuristicArrival - configuration.time).GetSeconds().ToDouble() +
+        configuration.DeltaTime;
+}
+
+IsoChron* RouteMap::ReverseReach(const wxDateTime& time) {
+  for (IsoChronList::iterator it = m_ReverseOrigin.begin();
+       it != m_ReverseOrigin.end(); ++it)
+    if ((*it)->time <= time) return *it;
+  return nullptr;
+}
+
 Position* RouteMap::ClosestPosition(double lat, double lon, wxDateTime* t,
                                     double* d) {
   if (origin.empty()) return nullptr;
@@ -526,11 +690,23 @@ void RouteMap::Reset() {
   Lock();
   Clear();
 
+  // a multi pass route starts over with the coarse pass
+  if (m_Configuration.FinePass || m_Configuration.ReverseTime) {
+    m_Configuration.Corridor.clear();
+    m_Configuration.CorridorCells.reset();
+    m_Configuration.FinePass = false;
+    m_Configuration.ReverseTime = false;
+    m_bValid = m_Configuration.Update();
+    UpdateConfigurationSnapshot();
+  }
+
   m_NewGrib = nullptr;
   m_SharedNewGrib.SetGribRecordSet(0);
 
   m_NewTime = m_Configuration.StartTime;
   m_bNeedsGrib = m_Configuration.UseGrib && m_Configuration.RouteGUID.IsEmpty();
+  m_GribRequestTime = m_bNeedsGrib ? std::chrono::steady_clock::now()
+                                   : std::chrono::steady_clock::time_point();
   m_ErrorMsg = wxEmptyString;
 
   m_bReachedDestination = false;
@@ -540,6 +716,14 @@ void RouteMap::Reset() {
   m_bFinished = false;
   m_bLandCrossing = false;
   m_bBoundaryCrossing = false;
+  m_Profile.Clear();
+  m_StepProfiles.clear();
+  m_Rejections.Clear();
+  m_StepRejections.clear();
+
+  m_HeuristicMaxCurrent = 0;
+  m_HeuristicGrib = nullptr;
+  m_HeuristicArrival = wxDateTime();
 
   Unlock();
 }
@@ -549,6 +733,7 @@ std::map<time_t, Shared_GribRecordSetRef> grib_key;
 wxMutex s_key_mutex;
 
 void RouteMap::SetNewGrib(GribRecordSet* grib) {
+  RoutingTraceSpan trace("SetNewGrib", "grib");
   if (!grib || !grib->m_GribRecordPtrArray[Idx_WIND_VX] ||
       !grib->m_GribRecordPtrArray[Idx_WIND_VY])
     return;
@@ -609,6 +794,7 @@ void RouteMap::SetNewGrib(GribRecordSet* grib) {
 }
 
 void RouteMap::SetNewGrib(WR_GribRecordSet* grib) {
+  RoutingTraceSpan trace("SetNewGrib", "grib");
   if (!grib || !grib->m_GribRecordPtrArray[Idx_WIND_VX] ||
       !grib->m_GribRecordPtrArray[Idx_WIND_VY])
     return;
@@ -665,6 +851,12 @@ void RouteMap::Clear() {
     delete *it;
 
   origin.clear();
+
+  for (IsoChronList::iterator it = m_ReverseOrigin.begin();
+       it != m_ReverseOrigin.end(); ++it)
+    delete *it;
+
+  m_ReverseOrigin.clear();
 }
 
 /**
@@ -833,3 +1025,103 @@ wxString RouteMap::GetRoutingErrorInfo() {
   Unlock();
   return info;
 }
+
+wxString RouteMap::LoadBoat() {
+  Lock();
+  wxString filename = m_Configuration.boatFileName;
+  Unlock();
+
+  wxString error;
+  std::shared_ptr<const Boat> boat = Boat::Shared(filename, error);
+
+  Lock();
+  m_Configuration.boat = boat;
+  UpdateConfigurationSnapshot();
+  Unlock();
+  return error;
+}
+
+bool RouteMap::StartFinePass() {
+  /* stopped or not started, nothing to follow up */
+  if (!Finished()) return false;
+
+  RouteMapConfiguration configuration = GetConfiguration();
+  std::vector<std::pair<double, double>> corridor;
+  wxDateTime arrival;
+  double max_current;
+  bool reverse_pass = false;
+  IsoChronList reverse;
+  if (configuration.FinePass) {
+    /* the corridor may have missed the way around land the coarse pass did
+       not check, and the reverse pass is only as exact as its time steps,
+       search the whole area again with the same bound */
+    if (ReachedDestination()) return false;
+    Lock();
+    bool restricted =
+        !configuration.Corridor.empty() || !m_ReverseOrigin.empty();
+    arrival = m_HeuristicArrival;
+    max_current = m_HeuristicMaxCurrent;
+    Unlock();
+    if (!restricted) return false;
+    wxLogMessage(
+        "WeatherRouting: %s to %s did not arrive within the corridor or the "
+        "reverse pass, repeating the fine pass without them",
+        configuration.Start, configuration.End);
+  } else if (configuration.ReverseTime) {
+    /* the reverse pass is done, keep its isochrones for the fine pass */
+    Lock();
+    reverse.swap(origin);
+    corridor = configuration.Corridor;
+    arrival = m_HeuristicArrival;
+    max_current = m_HeuristicMaxCurrent;
+    Unlock();
+  } else {
+    if (!configuration.CoarsePass()) return false;
+
+    /* without a coarse route the fine pass is neither restricted nor
+       bounded */
+    Position* p = nullptr;
+    if (ReachedDestination())
+      p = ClosestPosition(configuration.EndLat, configuration.EndLon);
+
+    Lock();
+    /* the last isochrone contains the destination, it was reached by its
+       end */
+    if (p)
+      arrival = origin.back()->time + wxTimeSpan(0, 0, origin.back()->delta);
+    max_current = m_HeuristicMaxCurrent;
+    if (p && configuration.MultiResolution) {
+      corridor.push_back(
+          std::make_pair(configuration.EndLat, configuration.EndLon));
+      for (; p; p = p->parent)
+        corridor.push_back(std::make_pair(p->lat, p->lon));
+      std::reverse(corridor.begin(), corridor.end());
+    }
+    Unlock();
+    reverse_pass = p && configuration.Bidirectional;
+  }
+
+  Reset();
+
+  Lock();
+  m_Configuration.Corridor = corridor;
+  if (corridor.size() >= 2)
+    m_Configuration.CorridorCells = std::make_shared<const CorridorGrid>(
+        corridor, configuration.CorridorWidth);
+  if (reverse_pass) {
+    /* back from a fine step after the coarse arrival, which leaves the same
+       slack as the heuristic bound */
+    m_Configuration.ReverseTime = true;
+    m_NewTime = arrival + wxTimeSpan(0, 0, configuration.DeltaTime);
+  } else
+    m_Configuration.FinePass = true;
+  m_ReverseOrigin.swap(reverse);
+  m_bValid = m_Configuration.Update();
+  UpdateConfigurationSnapshot();
+  if (arrival.IsValid()) {
+    m_HeuristicArrival = arrival;
+    m_HeuristicMaxCurrent = max_current;
+  }
+  Unlock();
+  return true;
+}
@@ -20,8 +20,17 @@
 #include <wx/wx.h>
 #include <wx/glcanvas.h>
 
+#include <wx/file.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <iterator>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 #include "ocpn_plugin.h"
 #include "pidc.h"
@@ -29,6 +38,7 @@
 #include "Utilities.h"
 #include "Boat.h"
 #include "RouteMapOverlay.h"
+#include "RoutingTrace.h"
 #include "SettingsDialog.h"
 #include "georef.h"
 
@@ -46,10 +56,11 @@ RouteMapOverlayThread::RouteMapOverlayThread(RouteMapOverlay& routemapoverlay)
 }
 
 void* RouteMapOverlayThread::Entry() {
-  RouteMapConfiguration cf = m_RouteMapOverlay.GetConfiguration();
+  std::shared_ptr<const RouteMapConfiguration> cf =
+      m_RouteMapOverlay.GetConfigurationSnapshot();
 
-  if (!cf.RouteGUID.IsEmpty()) {
-    std::unique_ptr<PlugIn_Route> rte = GetRoute_Plugin(cf.RouteGUID);
+  if (!cf->RouteGUID.IsEmpty()) {
+    std::unique_ptr<PlugIn_Route> rte = GetRoute_Plugin(cf->RouteGUID);
     PlugIn_Route* proute = rte.get();
     if (proute == nullptr) return 0;
 
@@ -70,6 +81,19 @@ void* RouteMapOverlayThread::Entry() {
   return 0;
 }
 
+OverlayTileThread::OverlayTileThread(RouteMapOverlay& routemapoverlay)
+    : wxThread(wxTHREAD_JOINABLE), m_RouteMapOverlay(routemapoverlay) {
+  Create();
+}
+
+void* OverlayTileThread::Entry() {
+  RouteMapOverlay::OverlayTileKey key;
+  while (!TestDestroy())
+    if (m_RouteMapOverlay.NextOverlayTileRequest(key))
+      m_RouteMapOverlay.SampleOverlayTile(key);
+  return 0;
+}
+
 RouteMapOverlay::RouteMapOverlay()
     : m_UpdateOverlay(true),
       m_bEndRouteVisible(false),
@@ -82,12 +106,13 @@ RouteMapOverlay::RouteMapOverlay()
       m_bUpdated(false),
       m_overlaylist(0),
       clear_destination_plotdata(false),
-      wind_barb_cache_scale(NAN),
-      wind_barb_cache_origin_size(0),
-      current_cache_scale(NAN),
-      current_cache_origin_size(0) {}
+      m_SnapshotFingerprint(0),
+      m_OverlayTileGeneration(0),
+      m_OverlayTileCondition(m_OverlayTileMutex),
+      m_OverlayTileThread(nullptr) {}
 
 RouteMapOverlay::~RouteMapOverlay() {
+  DeleteOverlayTileThread();
   delete destination_position;
 
   if (m_Thread) Stop();
@@ -102,9 +127,10 @@ bool RouteMapOverlay::Start(wxString& error) {
   error = LoadBoat();
   if (error.size()) return false;
 
-  RouteMapConfiguration configuration = GetConfiguration();
+  std::shared_ptr<const RouteMapConfiguration> configuration =
+      GetConfigurationSnapshot();
   /* test for cyclone data if needed */
-  if (configuration.AvoidCycloneTracks &&
+  if (configuration->AvoidCycloneTracks &&
       (!ClimatologyCycloneTrackCrossings ||
        ClimatologyCycloneTrackCrossings(0, 0, 0, 0, wxDateTime(), 0) == -1)) {
     error =
@@ -113,7 +139,7 @@ bool RouteMapOverlay::Start(wxString& error) {
     return false;
   }
 
-  if (configuration.DetectBoundary &&
+  if (configuration->DetectBoundary &&
       !RouteMap::ODFindClosestBoundaryLineCrossing) {
     error =
         _("Configuration specifies boundary exclusion but ocpn_draw_pi "
@@ -121,8 +147,8 @@ bool RouteMapOverlay::Start(wxString& error) {
     return false;
   }
 
-  if (!configuration.UseGrib &&
-      configuration.ClimatologyType <= RouteMapConfiguration::CURRENTS_ONLY) {
+  if (!configuration->UseGrib &&
+      configuration->ClimatologyType <= RouteMapConfiguration::CURRENTS_ONLY) {
     error = _("Configuration does not allow grib or climatology wind data");
     return false;
   }
@@ -199,6 +225,7 @@ void RouteMapOverlay::RouteAnalysis(PlugIn_Route* proute) {
                    DataMask::NONE /* data_mask */, true /* data_deficient */);
 
   last_cursor_plotdata = last_destination_plotdata;
+  InvalidateRouteInfo();
   if (ok) {
     m_EndTime = data.time;
   }
@@ -351,6 +378,239 @@ void RouteMapOverlay::RenderIsoRoute(IsoRoute* r, wxDateTime time,
     RenderIsoRoute(*it, time, cyan, magenta, dc, vp);
 }
 
+/* pixels per meter of the isochrone vertex cache.  Any value works as the view
+   transform rescales it, the float vertices are precise to about 1e-7 of
+   their distance from the start either way. */
+static const double ISOCHRON_CACHE_SCALE = 1;
+
+/* Levels of detail of the isochrone lines.  Level 0 keeps every position,
+   level n drops the positions within ISOCHRON_LOD_TOLERANCE * 4^(n-1)
+   meters of the simplified line. */
+static const int ISOCHRON_LOD_LEVELS = 7;
+static const double ISOCHRON_LOD_TOLERANCE = 50;
+
+static double IsoChronLODTolerance(int lod) {
+  return ldexp(ISOCHRON_LOD_TOLERANCE, 2 * (lod - 1));
+}
+
+/* the coarsest level of detail staying within half a pixel of the
+   positions at this scale */
+static int IsoChronLevelOfDetail(double view_scale_ppm) {
+  double tolerance = 0.5 / view_scale_ppm;
+  int lod = 0;
+  while (lod + 1 < ISOCHRON_LOD_LEVELS &&
+         IsoChronLODTolerance(lod + 1) <= tolerance)
+    lod++;
+  return lod;
+}
+
+static double SegmentDistanceSquare(const wxPoint2DDouble& p,
+                                    const wxPoint2DDouble& a,
+                                    const wxPoint2DDouble& b) {
+  wxPoint2DDouble ab = b - a, ap = p - a;
+  double len = ab.GetVectorLength();
+  double t = len > 0 ? ap.GetDotProduct(ab) / (len * len) : 0;
+  t = wxMax(0, wxMin(1, t));
+  return p.GetDistanceSquare(a + ab * t);
+}
+
+/* Douglas-Peucker simplification of a closed ring, clears keep[] for the
+   points within tolerance of the simplified ring */
+static void SimplifyRing(const std::vector<wxPoint2DDouble>& points,
+                         double tolerance, std::vector<bool>& keep) {
+  size_t n = points.size();
+  if (n < 4) return;
+
+  std::fill(keep.begin(), keep.end(), false);
+
+  // split the ring at the point farthest from the first one
+  size_t far = 0;
+  double fard = -1;
+  for (size_t i = 1; i < n; i++) {
+    double d = points[i].GetDistanceSquare(points[0]);
+    if (d > fard) fard = d, far = i;
+  }
+  keep[0] = keep[far] = true;
+
+  // index n stands for point 0 closing the ring
+  std::vector<std::pair<size_t, size_t>> spans;
+  spans.push_back(std::make_pair(0, far));
+  spans.push_back(std::make_pair(far, n));
+  while (!spans.empty()) {
+    size_t a = spans.back().first, b = spans.back().second;
+    spans.pop_back();
+
+    size_t worst = 0;
+    double worstd = tolerance * tolerance;
+    for (size_t i = a + 1; i < b; i++) {
+      double d = SegmentDistanceSquare(points[i], points[a], points[b % n]);
+      if (d > worstd) worstd = d, worst = i;
+    }
+    if (!worst) continue;
+
+    keep[worst] = true;
+    spans.push_back(std::make_pair(a, worst));
+    spans.push_back(std::make_pair(worst, b));
+  }
+}
+
+void RouteMapOverlay::IsoChronVertexCache::Push(const wxPoint2DDouble& p,
+                                                const wxColour& c) {
+  vertices.push_back(p.m_x);
+  vertices.push_back(p.m_y);
+  colors.push_back(c.Red());
+  colors.push_back(c.Green());
+  colors.push_back(c.Blue());
+  colors.push_back(c.Alpha());
+}
+
+void RouteMapOverlay::CacheIsoRoute(IsoRoute* r, wxColour& grib_color,
+                                    wxColour& climatology_color,
+                                    PlugIn_ViewPort& cvp, int lod) {
+  SkipPosition* s = r->skippoints;
+  if (!s) return;
+
+  wxColour grib_deficient_color = TransparentColor(grib_color);
+  wxColour climatology_deficient_color = TransparentColor(climatology_color);
+
+  std::vector<Position*> ring;
+  std::vector<wxPoint2DDouble> points;
+  Position* p = s->point;
+  do {
+    wxPoint2DDouble pix;
+    GetDoubleCanvasPixLL(&cvp, &pix, p->lat, p->lon);
+    ring.push_back(p);
+    points.push_back(pix);
+    p = p->next;
+  } while (p != s->point);
+
+  std::vector<bool> keep(ring.size(), true);
+  if (lod) SimplifyRing(points, IsoChronLODTolerance(lod), keep);
+
+  IsoChronVertexCache& cache = isochron_cache[lod];
+  size_t n = ring.size();
+  for (size_t i = 0, j; i < n; i = j) {
+    j = i + 1;
+    while (j < n && !keep[j]) j++;
+
+    // draw the simplified segment if any segment it replaces is drawn
+    bool draw = false;
+    for (size_t k = i; k < j && !draw; k++)
+      draw = !ring[k]->copied || !ring[(k + 1) % n]->copied;
+    if (!draw) continue;
+
+    cache.Push(points[i],
+               PositionColor(ring[i], grib_color, climatology_color,
+                             grib_deficient_color,
+                             climatology_deficient_color));
+    cache.Push(points[j % n],
+               PositionColor(ring[j % n], grib_color, climatology_color,
+                             grib_deficient_color,
+                             climatology_deficient_color));
+  }
+
+  /* now cache any children */
+  wxColour cyan(0, 255, 255), magenta(255, 0, 255);
+  for (IsoRouteList::iterator it = r->children.begin(); it != r->children.end();
+       ++it)
+    CacheIsoRoute(*it, cyan, magenta, cvp, lod);
+}
+
+void RouteMapOverlay::IsoChronVertexCache::Truncate(size_t n) {
+  if (n >= isochrons.size()) return;
+
+  size_t last = n ? isochrons[n - 1].second : 0;
+  vertices.resize(2 * last);
+  colors.resize(4 * last);
+  isochrons.resize(n);
+}
+
+static PlugIn_ViewPort IsoChronCacheViewPort(
+    const PlugIn_ViewPort& vp, const RouteMapConfiguration& configuration) {
+  PlugIn_ViewPort cvp = vp;
+  cvp.clat = configuration.StartLat, cvp.clon = configuration.StartLon;
+  cvp.pix_width = cvp.pix_height = 0;
+  cvp.view_scale_ppm = ISOCHRON_CACHE_SCALE;
+  cvp.rotation = cvp.skew = 0;
+  return cvp;
+}
+
+void RouteMapOverlay::RenderIsoChronCache(const IsoChronVertexCache& cache,
+                                          const IsoChron* closest,
+                                          int thickness, piDC& dc,
+                                          PlugIn_ViewPort& vp,
+                                          PlugIn_ViewPort& cvp) {
+  if (cache.isochrons.empty()) return;
+
+  /* Mercator maps the cache onto the view with a similarity transform.
+     Rather than trusting view_scale_ppm and rotation, measure it from two
+     reference points so it matches GetDoubleCanvasPixLL exactly. */
+  double lat0 = cvp.clat, lon0 = cvp.clon;
+  double lat1 = lat0 > 0 ? lat0 - 1 : lat0 + 1;
+  wxPoint2DDouble a0, a1, b0, b1;
+  GetDoubleCanvasPixLL(&cvp, &a0, lat0, lon0);
+  GetDoubleCanvasPixLL(&cvp, &a1, lat1, lon0);
+  GetDoubleCanvasPixLL(&vp, &b0, lat0, lon0);
+  GetDoubleCanvasPixLL(&vp, &b1, lat1, lon0);
+
+  wxPoint2DDouble a = a1 - a0, b = b1 - b0;
+  double alen = a.GetVectorLength();
+  if (alen == 0) return;
+  double scale = b.GetVectorLength() / alen;
+  double angle = atan2(b.m_y, b.m_x) - atan2(a.m_y, a.m_x);
+
+#ifndef __OCPN__ANDROID__
+  if (!dc.GetDC()) {
+    glPushMatrix();
+    glTranslated(b0.m_x, b0.m_y, 0);
+    glRotated(rad2deg(angle), 0, 0, 1);
+    glScaled(scale, scale, 1);
+    glTranslated(-a0.m_x, -a0.m_y, 0);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, cache.vertices.data());
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, cache.colors.data());
+  }
+#endif
+
+  double ca = scale * cos(angle), sa = scale * sin(angle);
+  size_t first = 0;
+  for (size_t i = 0; i < cache.isochrons.size(); i++) {
+    size_t last = cache.isochrons[i].second;
+    if (last == first) continue;
+
+    // the isochrone closest to the selected GRIB time is thicker
+    SetWidth(dc,
+             cache.isochrons[i].first == closest ? thickness * 3 : thickness);
+#ifndef __OCPN__ANDROID__
+    if (!dc.GetDC())
+      glDrawArrays(GL_LINES, first, last - first);
+    else
+#endif
+    {
+      for (size_t v = first; v < last; v += 2) {
+        const float* l = &cache.vertices[2 * v];
+        const unsigned char* c = &cache.colors[4 * v];
+        SetColor(dc, wxColour(c[0], c[1], c[2], c[3]));
+        double x1 = l[0] - a0.m_x, y1 = l[1] - a0.m_y;
+        double x2 = l[2] - a0.m_x, y2 = l[3] - a0.m_y;
+        dc.DrawLine(b0.m_x + ca * x1 - sa * y1, b0.m_y + sa * x1 + ca * y1,
+                    b0.m_x + ca * x2 - sa * y2, b0.m_y + sa * x2 + ca * y2);
+      }
+    }
+    first = last;
+  }
+
+#ifndef __OCPN__ANDROID__
+  if (!dc.GetDC()) {
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glPopMatrix();
+  }
+#endif
+}
+
 void RouteMapOverlay::RenderAlternateRoute(IsoRoute* r, bool each_parent,
                                            piDC& dc, PlugIn_ViewPort& vp) {
   Position* pos = r->skippoints->point;
@@ -396,15 +656,17 @@ static double GetPlatformScaleFactor() {
 void RouteMapOverlay::Render(wxDateTime time, SettingsDialog& settingsdialog,
                              piDC& dc, PlugIn_ViewPort& vp, bool justendroute,
                              const RoutePoint* positionOnRoute) {
+  RoutingTraceSpan trace("Render", "render");
   dc.SetPen(*wxBLACK);                // reset pen
   dc.SetBrush(*wxTRANSPARENT_BRUSH);  // reset brush
   if (!justendroute) {
-    RouteMapConfiguration configuration = GetConfiguration();
+    std::shared_ptr<const RouteMapConfiguration> configuration =
+        GetConfigurationSnapshot();
 
-    if (!std::isnan(configuration.StartLat)) {
+    if (!std::isnan(configuration->StartLat)) {
       wxPoint r;
-      WR_GetCanvasPixLL(&vp, &r, configuration.StartLat,
-                        configuration.StartLon);
+      WR_GetCanvasPixLL(&vp, &r, configuration->StartLat,
+                        configuration->StartLon);
       SetColor(dc, *wxBLUE, true);
       SetWidth(dc, 3, true);
       dc.DrawLine(r.x, r.y - 10, r.x + 10, r.y + 7);
@@ -412,9 +674,9 @@ void RouteMapOverlay::Render(wxDateTime time, SettingsDialog& settingsdialog,
       dc.DrawLine(r.x - 10, r.y + 7, r.x + 10, r.y + 7);
     }
 
-    if (!std::isnan(configuration.EndLat)) {
+    if (!std::isnan(configuration->EndLat)) {
       wxPoint r;
-      WR_GetCanvasPixLL(&vp, &r, configuration.EndLat, configuration.EndLon);
+      WR_GetCanvasPixLL(&vp, &r, configuration->EndLat, configuration->EndLon);
       SetColor(dc, *wxRED, true);
       SetWidth(dc, 3, true);
       dc.DrawLine(r.x - 10, r.y - 10, r.x + 10, r.y + 10);
@@ -433,8 +695,8 @@ void RouteMapOverlay::Render(wxDateTime time, SettingsDialog& settingsdialog,
       /* center display list on start lat/lon */
 
       wxPoint point;
-      WR_GetCanvasPixLL(&vp, &point, configuration.StartLat,
-                        configuration.StartLon);
+      WR_GetCanvasPixLL(&vp, &point, configuration->StartLat,
+                        configuration->StartLon);
 
       glTranslated(point.x, point.y, 0);
       glScalef(vp.view_scale_ppm / NORM_FACTOR, vp.view_scale_ppm / NORM_FACTOR,
@@ -460,7 +722,7 @@ void RouteMapOverlay::Render(wxDateTime time, SettingsDialog& settingsdialog,
 
         glNewList(m_overlaylist, GL_COMPILE);
 
-        nvp.clat = configuration.StartLat, nvp.clon = configuration.StartLon;
+        nvp.clat = configuration->StartLat, nvp.clon = configuration->StartLon;
         nvp.pix_width = nvp.pix_height = 0;
         nvp.view_scale_ppm = NORM_FACTOR;
         nvp.rotation = nvp.skew = 0;
@@ -542,28 +804,60 @@ void RouteMapOverlay::Render(wxDateTime time, SettingsDialog& settingsdialog,
             }
           }
         }
+        // On Mercator only isochrones not yet in the vertex cache at this
+        // level of detail are visited, the rest are drawn from the cache
+        // afterwards
+        bool use_cache = vp.m_projection_type == PI_PROJECTION_MERCATOR &&
+                         vp.view_scale_ppm > 0;
+        int lod = use_cache ? IsoChronLevelOfDetail(vp.view_scale_ppm) : 0;
+        IsoChronVertexCache& cache = isochron_cache[lod];
+        PlugIn_ViewPort cvp = nvp;
+        if (use_cache) cvp = IsoChronCacheViewPort(vp, *configuration);
+        size_t n = 0;
         for (IsoChronList::iterator i = origin.begin(); i != origin.end();
-             ++i) {
+             ++i, ++n) {
+          if (use_cache && n < cache.isochrons.size()) {
+            if (cache.isochrons[n].first == *i) {
+              if (++c == (sizeof routecolors) / (sizeof *routecolors)) c = 0;
+              continue;
+            }
+            cache.Truncate(n);
+          }
           Unlock();
           wxColor grib_color(routecolors[c][0], routecolors[c][1],
                              routecolors[c][2], 224);
           wxColor climatology_color(255 - routecolors[c][0], routecolors[c][2],
                                     routecolors[c][1], 224);
-          // If this is the closest isochrone to the selected GRIB time, use a
-          // thicker line
-          if (time.IsValid() && *i == closestIsochron) {
-            SetWidth(dc, IsoChronThickness * 3);
+          if (use_cache) {
+            for (IsoRouteList::iterator j = (*i)->routes.begin();
+                 j != (*i)->routes.end(); ++j)
+              CacheIsoRoute(*j, grib_color, climatology_color, cvp, lod);
+            cache.isochrons.push_back(
+                std::make_pair(*i, cache.vertices.size() / 2));
           } else {
-            SetWidth(dc, IsoChronThickness);
+            // If this is the closest isochrone to the selected GRIB time,
+            // use a thicker line
+            if (time.IsValid() && *i == closestIsochron) {
+              SetWidth(dc, IsoChronThickness * 3);
+            } else {
+              SetWidth(dc, IsoChronThickness);
+            }
+            for (IsoRouteList::iterator j = (*i)->routes.begin();
+                 j != (*i)->routes.end(); ++j)
+              RenderIsoRoute(*j, time, grib_color, climatology_color, dc,
+                             nvp);
           }
-          for (IsoRouteList::iterator j = (*i)->routes.begin();
-               j != (*i)->routes.end(); ++j)
-            RenderIsoRoute(*j, time, grib_color, climatology_color, dc, nvp);
 
           if (++c == (sizeof routecolors) / (sizeof *routecolors)) c = 0;
           Lock();
         }
+        if (use_cache) cache.Truncate(n);
         Unlock();
+
+        if (use_cache)
+          RenderIsoChronCache(cache,
+                              time.IsValid() ? closestIsochron : nullptr,
+                              IsoChronThickness, dc, vp, cvp);
       }
 
 #ifndef __OCPN__ANDROID__
@@ -635,7 +929,7 @@ void RouteMapOverlay::RenderPolarChangeMarks(bool cursor_route, piDC& dc,
 
   if (!pos) return;
 
-  std::list<PlotData> plot = GetPlotData(cursor_route);
+  std::list<PlotData>& plot = GetPlotData(cursor_route);
   std::list<PlotData>::iterator itt = plot.begin();
   if (itt == plot.end()) {
     return;
@@ -765,7 +1059,7 @@ void RouteMapOverlay::RenderCourse(bool cursor_route, piDC& dc,
 
   Lock();
 
-  bool rte = !GetConfiguration().RouteGUID.IsEmpty();
+  bool rte = !GetConfigurationSnapshot()->RouteGUID.IsEmpty();
   if (cursor_route == true) {
     // never draw comfort if cursor route
     assert(comfortRoute == false);
@@ -791,7 +1085,7 @@ void RouteMapOverlay::RenderCourse(bool cursor_route, piDC& dc,
    * position and in parallel on GetPlotData
    * Thanks Sean for your help :-)
    */
-  std::list<PlotData> plot = GetPlotData(false);
+  std::list<PlotData>& plot = GetPlotData(false);
   std::list<PlotData>::reverse_iterator itt = plot.rbegin();
   std::list<PlotData>::reverse_iterator inext = itt;
 
@@ -835,7 +1129,7 @@ void RouteMapOverlay::RenderBoatOnCourse(bool cursor_route, wxDateTime time,
       cursor_route ? last_cursor_position : last_destination_position;
   if (!pos) return;
 
-  std::list<PlotData> plot = GetPlotData(cursor_route);
+  std::list<PlotData>& plot = GetPlotData(cursor_route);
 
   for (auto it = plot.begin(); it != plot.end();) {
     wxDateTime ittime = it->time;
@@ -889,7 +1183,8 @@ void RouteMapOverlay::RenderWindBarbsOnRoute(piDC& dc, PlugIn_ViewPort& vp,
 
   if (vp.bValid == false) return;
 
-  RouteMapConfiguration configuration = GetConfiguration();
+  std::shared_ptr<const RouteMapConfiguration> configuration =
+      GetConfigurationSnapshot();
 
   // Create a specific viewport at position (0,0)
   // to draw the winds barbs, and then translate it
@@ -897,7 +1192,7 @@ void RouteMapOverlay::RenderWindBarbsOnRoute(piDC& dc, PlugIn_ViewPort& vp,
   // calculate wind barbs along the route by looping
   // over [GetPlotData(false)] list which contains lat,
   // lon, wind info for each points, only if needed.
-  std::list<PlotData> plot = GetPlotData(false);
+  std::list<PlotData>& plot = GetPlotData(false);
 
   // if no route has been calculated by WeatherRouting,
   // then stops the method.
@@ -943,8 +1238,8 @@ void RouteMapOverlay::RenderWindBarbsOnRoute(piDC& dc, PlugIn_ViewPort& vp,
 
   // Draw the wind barbs
   wxPoint point;
-  WR_GetCanvasPixLL(&vp, &point, configuration.StartLat,
-                    configuration.StartLon);
+  WR_GetCanvasPixLL(&vp, &point, configuration->StartLat,
+                    configuration->StartLon);
   wxColour colour;
   if (apparentWind) {
     wxColour blue(20, 83, 186);
@@ -986,169 +1281,145 @@ void RouteMapOverlay::RenderWindBarbsOnRoute(piDC& dc, PlugIn_ViewPort& vp,
 #endif
 }
 
+/* grid cells per tile side of the wind and current overlays */
+static const int OVERLAY_TILE_CELLS = 8;
+
+/* more tiles than this in view means the arrows would be unreadable anyway */
+static const int OVERLAY_MAX_VISIBLE_TILES = 1024;
+
+/* sampled tiles kept across zoom levels before older levels are dropped */
+static const size_t OVERLAY_MAX_CACHED_TILES = 4096;
+
+static bool GetOverlayFieldData(bool current, IsoChron* isochron, Position& p,
+                                RouteMapConfiguration& configuration,
+                                double& W, double& VW) {
+  configuration.grib = isochron->m_Grib;
+  configuration.time = isochron->time;
+  configuration.grib_is_data_deficient = isochron->m_Grib_is_data_deficient;
+  p.grib_is_data_deficient = configuration.grib_is_data_deficient;
+
+  DataMask data_mask;  // can be used to colorize barbs based on data type
+  if (current) return p.GetCurrentData(configuration, W, VW, data_mask);
+  return p.GetWindData(configuration, W, VW, data_mask);
+}
+
 void RouteMapOverlay::RenderWindBarbs(piDC& dc, PlugIn_ViewPort& vp) {
-  if (origin.size() < 2)  // no map to work with
-    return;
+  RenderOverlayField(WIND_OVERLAY, dc, vp);
+}
 
-  if (vp.bValid == false) return;
+void RouteMapOverlay::RenderCurrent(piDC& dc, PlugIn_ViewPort& vp) {
+  RenderOverlayField(CURRENT_OVERLAY, dc, vp);
+}
 
-  RouteMapConfiguration configuration = GetConfiguration();
+void RouteMapOverlay::RenderOverlayField(OverlayField field, piDC& dc,
+                                         PlugIn_ViewPort& vp) {
+  if (vp.bValid == false || !(vp.view_scale_ppm > 0)) return;
+
+  std::shared_ptr<const RouteMapConfiguration> configuration =
+      GetConfigurationSnapshot();
+  double lat0 = configuration->StartLat, lon0 = configuration->StartLon;
 
-  // if zoomed way in, don't cache the arrows for panning, instead we just
-  // render what's onscreen
+  Lock();
+  if (origin.size() < 2) {  // no map to work with
+    Unlock();
+    return;
+  }
   double latmin, latmax, lonmin, lonmax;
   GetLLBounds(latmin, latmax, lonmin, lonmax);
+  wxDateTime time = origin.back()->time;
+  Unlock();
 
-  PlugIn_ViewPort nvp = vp;
-  nvp.clat = configuration.StartLat, nvp.clon = configuration.StartLon;
-  nvp.pix_width = nvp.pix_height = 0;
-  nvp.rotation = nvp.skew = 0;
-
-  wxPoint p1, p2, p3, p4;
-  WR_GetCanvasPixLL(&nvp, &p1, latmin, lonmin);
-  WR_GetCanvasPixLL(&nvp, &p2, latmin, lonmax);
-  WR_GetCanvasPixLL(&nvp, &p3, latmax, lonmin);
-  WR_GetCanvasPixLL(&nvp, &p4, latmax, lonmax);
-
-  wxRect r;
-  r.x = wxMin(wxMin(p1.x, p2.x), wxMin(p3.x, p4.x));
-  r.y = wxMin(wxMin(p1.y, p2.y), wxMin(p3.y, p4.y));
-  r.width = wxMax(wxMax(p1.x, p2.x), wxMax(p3.x, p4.x)) - r.x;
-  r.height = wxMax(wxMax(p1.y, p2.y), wxMax(p3.y, p4.y)) - r.y;
-
-  // we could somehow "append" to the cache as passing occurs when zoomed really
-  // far in rather than making a complete cache... but how complex does it need
-  // to be? quick an dirty, convert to double or integer may overflow
-  bool nocache = (double)r.width * (double)r.height >
-                     (double)(vp.rv_rect.width * vp.rv_rect.height * 4) ||
-                 vp.m_projection_type != PI_PROJECTION_MERCATOR;
-
-  if (nocache || origin.size() != wind_barb_cache_origin_size ||
-      vp.view_scale_ppm != wind_barb_cache_scale ||
-      vp.m_projection_type != wind_barb_cache_projection) {
-    wxStopWatch timer;
-    static double step = 36.0;
-
-    wind_barb_cache_origin_size = origin.size();
-    wind_barb_cache_scale = vp.view_scale_ppm;
-    wind_barb_cache_projection = vp.m_projection_type;
-
-    if (nocache) {
-      r = vp.rv_rect;
-      nvp = vp;
-    }
+  // keep the arrows about this many pixels apart, with cells of a power of
+  // two meters so zooming within a factor of two reuses the same tiles
+  double spacing = field == WIND_OVERLAY ? 36.0 : 80.0;
+  int level = wxMax(0, (int)round(log2(spacing / vp.view_scale_ppm)));
+  double tile_size = ldexp(OVERLAY_TILE_CELLS, level);
+
+  // tiles both in view and within the map
+  double xmin = INFINITY, xmax = -INFINITY, ymin = INFINITY, ymax = -INFINITY;
+  for (int i = 0; i < 4; i++) {
+    wxPoint corner(vp.rv_rect.x + (i & 1) * vp.rv_rect.width,
+                   vp.rv_rect.y + (i >> 1) * vp.rv_rect.height);
+    double lat, lon, x, y;
+    GetCanvasLLPix(&vp, corner, &lat, &lon);
+    toSM(lat, lon, lat0, lon0, &x, &y);
+    xmin = wxMin(xmin, x), xmax = wxMax(xmax, x);
+    ymin = wxMin(ymin, y), ymax = wxMax(ymax, y);
+  }
 
-    Lock();
+  double mx1, my1, mx2, my2;
+  toSM(latmin, lonmin, lat0, lon0, &mx1, &my1);
+  toSM(latmax, lonmax, lat0, lon0, &mx2, &my2);
+  xmin = wxMax(xmin, wxMin(mx1, mx2)), xmax = wxMin(xmax, wxMax(mx1, mx2));
+  ymin = wxMax(ymin, wxMin(my1, my2)), ymax = wxMin(ymax, wxMax(my1, my2));
+  if (!(xmin <= xmax && ymin <= ymax)) return;
 
-    wxPoint p;
-    WR_GetCanvasPixLL(&nvp, &p, configuration.StartLat, configuration.StartLon);
-    int xoff = p.x % (int)step, yoff = p.y % (int)step;
+  int tx1 = floor(xmin / tile_size), tx2 = floor(xmax / tile_size);
+  int ty1 = floor(ymin / tile_size), ty2 = floor(ymax / tile_size);
+  if ((double)(tx2 - tx1 + 1) * (ty2 - ty1 + 1) > OVERLAY_MAX_VISIBLE_TILES)
+    return;
 
-    IsoChronList::iterator it = origin.end();
-    it--;
-    for (double x = r.x + xoff; x < r.x + r.width; x += step) {
-      for (double y = r.y + yoff; y < r.y + r.height; y += step) {
-        double lat, lon;
-        GetCanvasLLPix(&nvp, wxPoint(x, y), &lat, &lon);
-
-        Position p(lat, configuration.positive_longitudes
-                            ? positive_degrees(lon)
-                            : lon);
-
-        // find the first isochrone we are outside of using the isochrone from
-        // the last point as an initial guess to reduce the amount of expensive
-        // Contains calls
-        if (!(*it)->Contains(p)) {
-          do {
-            if (++it == origin.end()) {  // don't plot outside map
-              it--;
-              goto skip;
-            }
-          } while (!(*it)->Contains(p));
-          it--;
-        } else
-          for (it--; it != origin.begin(); it--)
-            if (!(*it)->Contains(p)) break;
-
-        {
-          double W1, VW1, W2, VW2;
-          DataMask data_mask1,
-              data_mask2;  // can be used to colorize barbs based on data type
-          bool v1, v2;
-          // now it is the isochrone before p, so we find the two closest
-          // postions
-          Position* p1 = (*it)->ClosestPosition(lat, lon);
-          configuration.grib = (*it)->m_Grib;
-          configuration.time = (*it)->time;
-          configuration.grib_is_data_deficient =
-              (*it)->m_Grib_is_data_deficient;
-          p.grib_is_data_deficient = configuration.grib_is_data_deficient;
-          v1 = p.GetWindData(configuration, W1, VW1, data_mask1);
-
-          it++;
-          Position* p2 = (*it)->ClosestPosition(lat, lon);
-          configuration.grib = (*it)->m_Grib;
-          configuration.time = (*it)->time;
-          configuration.grib_is_data_deficient =
-              (*it)->m_Grib_is_data_deficient;
-          p.grib_is_data_deficient = configuration.grib_is_data_deficient;
-          v2 = p.GetWindData(configuration, W2, VW2, data_mask2);
-          if (!v1 || !v2) {
-            // not valid data
-            goto skip;
-          }
-          // now polar interpolation of the two wind positions
-          double d1 = p.Distance(p1), d2 = p.Distance(p2);
-          double d = d1 / (d1 + d2);
-#if 0
-                double W1r = deg2rad(W1), W2r = deg2rad(W2);
-                double W1x = VW1*cos(W1r), W1y = VW1*sin(W1r);
-                double W2x = VW2*cos(W2r), W2y = VW2*sin(W2r);
-                double Wx = d*W1x + (1-d)*W2x, Wy = d*W1y + (1-d)*W2y;
-                double W = rad2deg(atan2(Wy, Wx));
-#else
-          while (W1 - W2 > 180) W1 -= 360;
-          while (W2 - W1 > 180) W2 -= 360;
-          double W = d * W1 + (1 - d) * W2;
-#endif
-          double VW = d * VW1 + (1 - d) * VW2;
+  LineBuffer buffer;
+  {
+    wxMutexLocker lock(m_OverlayTileMutex);
+
+    // whatever was requested for this field before is out of view now
+    m_OverlayTileRequests.erase(
+        std::remove_if(m_OverlayTileRequests.begin(),
+                       m_OverlayTileRequests.end(),
+                       [field](const OverlayTileKey& key) {
+                         return key.field == field;
+                       }),
+        m_OverlayTileRequests.end());
+
+    if (m_OverlayTiles.size() > OVERLAY_MAX_CACHED_TILES) {
+      for (auto it = m_OverlayTiles.begin(); it != m_OverlayTiles.end();)
+        if (it->first.field == field && it->first.level != level)
+          it = m_OverlayTiles.erase(it);
+        else
+          ++it;
+    }
 
-          g_LineBufferOverlay.pushWindArrowWithBarbs(
-              wind_barb_cache, x, y, VW, deg2rad(W) + nvp.rotation, lat < 0);
+    for (int tx = tx1; tx <= tx2; tx++)
+      for (int ty = ty1; ty <= ty2; ty++) {
+        OverlayTileKey key = {field, level, tx, ty};
+        auto it = m_OverlayTiles.find(key);
+        // stale tiles are still drawn until sampled again
+        if (it == m_OverlayTiles.end() ||
+            (!it->second.complete && it->second.time != time))
+          m_OverlayTileRequests.push_back(key);
+        if (it == m_OverlayTiles.end()) continue;
+
+        for (const OverlayArrow& arrow : it->second.arrows) {
+          wxPoint2DDouble p;
+          GetDoubleCanvasPixLL(&vp, &p, arrow.lat, arrow.lon);
+          if (field == WIND_OVERLAY)
+            g_LineBufferOverlay.pushWindArrowWithBarbs(
+                buffer, p.m_x, p.m_y, arrow.speed,
+                deg2rad(arrow.direction) + vp.rotation, arrow.lat < 0);
+          else
+            g_LineBufferOverlay.pushSingleArrow(
+                buffer, p.m_x, p.m_y, arrow.speed,
+                deg2rad(arrow.direction + 180) + vp.rotation, arrow.lat < 0);
         }
-      skip:;
       }
-    }
-
-    Unlock();
 
-    // evaluate performance, and "cheat" by spacing the barbes more in
-    // subsequent frames if peformance is inadequate
-    long time = timer.Time();
-    if (nocache && time > 100 &&
-        step < 300)  // 100 milliseconds is unacceptable per frame
-      step *= 1.5;
-    else if (time < 10 && step > 40)  // reset step
-      step /= 1.5;
-
-    wind_barb_cache.Finalize();
+    if (!m_OverlayTileRequests.empty()) {
+      if (!m_OverlayTileThread) {
+        m_OverlayTileThread = new OverlayTileThread(*this);
+        m_OverlayTileThread->Run();
+      }
+      m_OverlayTileCondition.Signal();
+    }
   }
+  buffer.Finalize();
 
-  wxColour colour(180, 140, 14);
-
-  wxPoint point;
-  WR_GetCanvasPixLL(&vp, &point, configuration.StartLat,
-                    configuration.StartLon);
+  wxColour colour =
+      field == WIND_OVERLAY ? wxColour(180, 140, 14) : wxColour(0, 0, 0);
 
   if (dc.GetDC()) dc.SetPen(wxPen(colour, 2));
 #if defined(ocpnUSE_GL) && !defined(__OCPN__ANDROID__)
   else {
-    if (!nocache) {
-      glPushMatrix();
-      glTranslated(point.x, point.y, 0);
-      glRotated(vp.rotation * 180 / M_PI, 0, 0, 1);
-    }
-
     glColor3ub(colour.Red(), colour.Green(), colour.Blue());
     //      Enable anti-aliased lines, at best quality
     glEnable(GL_BLEND);
@@ -1157,228 +1428,120 @@ void RouteMapOverlay::RenderWindBarbs(piDC& dc, PlugIn_ViewPort& vp) {
   }
 #endif
 
-  if (dc.GetDC()) {
-    if (nocache)
-      wind_barb_cache.draw(dc.GetDC());
-    else {
-      LineBuffer tb;
-      tb.pushTransformedBuffer(wind_barb_cache, point.x, point.y, vp.rotation);
-      tb.Finalize();
-      tb.draw(dc.GetDC());
-    }
-  } else
-    wind_barb_cache.draw(nullptr);
+  buffer.draw(dc.GetDC());
 
 #if defined(ocpnUSE_GL) && !defined(__OCPN__ANDROID__)
-  if (!dc.GetDC()) {
-    glDisableClientState(GL_VERTEX_ARRAY);
-
-    if (!nocache) glPopMatrix();
-  }
+  if (!dc.GetDC()) glDisableClientState(GL_VERTEX_ARRAY);
 #endif
 }
 
-void RouteMapOverlay::RenderCurrent(piDC& dc, PlugIn_ViewPort& vp) {
-  if (origin.size() < 2)  // no map to work with
-    return;
-
-  if (vp.bValid == false) return;
-
-  RouteMapConfiguration configuration = GetConfiguration();
-
-  // if zoomed way in, don't cache the arrows for panning, instead we just
-  // render what's onscreen
-  double latmin, latmax, lonmin, lonmax;
-  GetLLBounds(latmin, latmax, lonmin, lonmax);
+bool RouteMapOverlay::NextOverlayTileRequest(OverlayTileKey& key) {
+  wxMutexLocker lock(m_OverlayTileMutex);
+  if (m_OverlayTileRequests.empty()) {
+    // time out now and then so the thread notices when it is deleted
+    m_OverlayTileCondition.WaitTimeout(250);
+    if (m_OverlayTileRequests.empty()) return false;
+  }
 
-  PlugIn_ViewPort nvp = vp;
-  nvp.clat = configuration.StartLat, nvp.clon = configuration.StartLon;
-  nvp.pix_width = nvp.pix_height = 0;
-  nvp.rotation = nvp.skew = 0;
-
-  wxPoint p1, p2, p3, p4;
-  WR_GetCanvasPixLL(&nvp, &p1, latmin, lonmin);
-  WR_GetCanvasPixLL(&nvp, &p2, latmin, lonmax);
-  WR_GetCanvasPixLL(&nvp, &p3, latmax, lonmin);
-  WR_GetCanvasPixLL(&nvp, &p4, latmax, lonmax);
-
-  wxRect r;
-  r.x = wxMin(wxMin(p1.x, p2.x), wxMin(p3.x, p4.x));
-  r.y = wxMin(wxMin(p1.y, p2.y), wxMin(p3.y, p4.y));
-  r.width = wxMax(wxMax(p1.x, p2.x), wxMax(p3.x, p4.x)) - r.x;
-  r.height = wxMax(wxMax(p1.y, p2.y), wxMax(p3.y, p4.y)) - r.y;
-
-  // we could somehow "append" to the cache as passing occurs when zoomed really
-  // far in rather than making a complete cache... but how complex does it need
-  // to be? quick an dirty, convert to double or integer may overflow
-  bool nocache = (double)r.width * (double)r.height >
-                     (double)(vp.rv_rect.width * vp.rv_rect.height * 9) ||
-                 vp.m_projection_type != PI_PROJECTION_MERCATOR;
-
-  if (nocache || origin.size() != current_cache_origin_size ||
-      vp.view_scale_ppm != current_cache_scale ||
-      vp.m_projection_type != current_cache_projection) {
-    wxStopWatch timer;
-    static double step = 80.0;
-
-    current_cache_origin_size = origin.size();
-    current_cache_scale = vp.view_scale_ppm;
-    current_cache_projection = vp.m_projection_type;
-
-    if (nocache) {
-      r = vp.rv_rect;
-      nvp = vp;
-    }
+  key = m_OverlayTileRequests.front();
+  m_OverlayTileRequests.pop_front();
+  return true;
+}
 
-    Lock();
+void RouteMapOverlay::SampleOverlayTile(const OverlayTileKey& key) {
+  RouteMapConfiguration configuration = *GetConfigurationSnapshot();
+  bool current = key.field == CURRENT_OVERLAY;
+  double cell = ldexp(1, key.level);
 
-    wxPoint p;
-    WR_GetCanvasPixLL(&nvp, &p, configuration.StartLat, configuration.StartLon);
-    int xoff = p.x % (int)step, yoff = p.y % (int)step;
+  OverlayTile tile;
+  tile.complete = true;
 
-    IsoChronList::iterator it = origin.end();
-    it--;
-    for (double x = r.x + xoff; x < r.x + r.width; x += step) {
-      for (double y = r.y + yoff; y < r.y + r.height; y += step) {
-        double lat, lon;
-        GetCanvasLLPix(&nvp, wxPoint(x, y), &lat, &lon);
-
-        Position p(lat, configuration.positive_longitudes
-                            ? positive_degrees(lon)
-                            : lon);
-
-        // find the first isochrone we are outside of using the isochrone from
-        // the last point as an initial guess to reduce the amount of expensive
-        // Contains calls
-        if (!(*it)->Contains(p)) {
-          do {
-            if (++it == origin.end()) {  // don't plot outside map
-              it--;
-              goto skip;
-            }
-          } while (!(*it)->Contains(p));
-          it--;
-        } else
-          for (it--; it != origin.begin(); it--)
-            if (!(*it)->Contains(p)) break;
-
-        {
-          double W1, VW1, W2, VW2;
-          DataMask data_mask1,
-              data_mask2;  // can be used to colorize barbs based on data type
-
-          // now it is the isochrone before p, so we find the two closest
-          // postions
-          Position* p1 = (*it)->ClosestPosition(lat, lon);
-          configuration.grib = (*it)->m_Grib;
-          configuration.time = (*it)->time;
-          configuration.grib_is_data_deficient =
-              (*it)->m_Grib_is_data_deficient;
-          p.grib_is_data_deficient = configuration.grib_is_data_deficient;
-          bool v1, v2;
-
-          v1 = p.GetCurrentData(configuration, W1, VW1, data_mask1);
-
-          it++;
-          Position* p2 = (*it)->ClosestPosition(lat, lon);
-          configuration.grib = (*it)->m_Grib;
-          configuration.time = (*it)->time;
-          configuration.grib_is_data_deficient =
-              (*it)->m_Grib_is_data_deficient;
-          p.grib_is_data_deficient = configuration.grib_is_data_deficient;
-          v2 = p.GetCurrentData(configuration, W2, VW2, data_mask2);
-          if (!v1 || !v2) {
-            goto skip;
-          }
-#if 0
-                // XX climatology angle is to not from
-                if ((data_mask1 & Position::CLIMATOLOGY_CURRENT))
-                    W1 += 180.0;
-                if ((data_mask2 & Position::CLIMATOLOGY_CURRENT))
-                    W2 += 180.0;
-#endif
-
-          // now polar interpolation of the two wind positions
-          double d1 = p.Distance(p1), d2 = p.Distance(p2);
-          double d = d1 / (d1 + d2);
-#if 0
-                double W1r = deg2rad(W1), W2r = deg2rad(W2);
-                double W1x = VW1*cos(W1r), W1y = VW1*sin(W1r);
-                double W2x = VW2*cos(W2r), W2y = VW2*sin(W2r);
-                double Wx = d*W1x + (1-d)*W2x, Wy = d*W1y + (1-d)*W2y;
-                double W = rad2deg(atan2(Wy, Wx));
-#else
-          while (W1 - W2 > 180) W1 -= 360;
-          while (W2 - W1 > 180) W2 -= 360;
-          double W = d * W1 + (1 - d) * W2;
-#endif
-          double VW = d * VW1 + (1 - d) * VW2;
+  Lock();
+  unsigned int generation;
+  {
+    // Clear() increments it under the tile mutex only
+    wxMutexLocker lock(m_OverlayTileMutex);
+    generation = m_OverlayTileGeneration;
+  }
+  if (origin.size() < 2) {
+    Unlock();
+    return;
+  }
+  tile.time = origin.back()->time;
 
-          g_LineBufferOverlay.pushSingleArrow(current_cache, x, y, VW,
-                                              deg2rad(W + 180) + nvp.rotation,
-                                              lat < 0);
+  IsoChronList::iterator it = origin.end();
+  it--;
+  for (int i = 0; i < OVERLAY_TILE_CELLS; i++) {
+    for (int j = 0; j < OVERLAY_TILE_CELLS; j++) {
+      double x = (key.x * OVERLAY_TILE_CELLS + i) * cell;
+      double y = (key.y * OVERLAY_TILE_CELLS + j) * cell;
+      double lat, lon;
+      fromSM(x, y, configuration.StartLat, configuration.StartLon, &lat, &lon);
+
+      Position p(lat, configuration.positive_longitudes
+                          ? positive_degrees(lon)
+                          : heading_resolve(lon));
+
+      // find the first isochrone we are outside of using the isochrone from
+      // the last point as an initial guess to reduce the amount of expensive
+      // Contains calls
+      if (!(*it)->Contains(p)) {
+        do
+          ++it;
+        while (it != origin.end() && !(*it)->Contains(p));
+        it--;
+        if (it == std::prev(origin.end())) {  // don't plot outside map
+          tile.complete = false;
+          continue;
         }
-      skip:;
-      }
+      } else
+        for (it--; it != origin.begin(); it--)
+          if (!(*it)->Contains(p)) break;
+
+      double W1, VW1, W2, VW2;
+      // now it is the isochrone before p, so we find the two closest
+      // postions
+      Position* p1 = (*it)->ClosestPosition(p.lat, p.lon);
+      bool v1 = GetOverlayFieldData(current, *it, p, configuration, W1, VW1);
+
+      it++;
+      Position* p2 = (*it)->ClosestPosition(p.lat, p.lon);
+      bool v2 = GetOverlayFieldData(current, *it, p, configuration, W2, VW2);
+      if (!v1 || !v2) continue;  // not valid data
+
+      // now polar interpolation of the two positions
+      double d1 = p.Distance(p1), d2 = p.Distance(p2);
+      double d = d1 / (d1 + d2);
+      while (W1 - W2 > 180) W1 -= 360;
+      while (W2 - W1 > 180) W2 -= 360;
+
+      OverlayArrow arrow;
+      arrow.lat = lat, arrow.lon = lon;
+      arrow.direction = d * W1 + (1 - d) * W2;
+      arrow.speed = d * VW1 + (1 - d) * VW2;
+      tile.arrows.push_back(arrow);
     }
-
-    Unlock();
-
-    // evaluate performance, and "cheat" by spacing the barbes more in
-    // subsequent frames if peformance is inadequate
-    long time = timer.Time();
-    if (nocache && time > 100 &&
-        step < 600.)  // 100 milliseconds is unacceptable per frame
-      step *= 1.5;
-    else if (time < 10 && step > 90.)  // reset step
-      step /= 1.5;
-
-    current_cache.Finalize();
   }
+  Unlock();
 
-  wxColour colour(0, 0, 0);
-
-  wxPoint point;
-  WR_GetCanvasPixLL(&vp, &point, configuration.StartLat,
-                    configuration.StartLon);
-
-  if (dc.GetDC()) dc.SetPen(wxPen(colour, 2));
-#if defined(ocpnUSE_GL) && !defined(__OCPN__ANDROID__)
-  else {
-    if (!nocache) {
-      glPushMatrix();
-      glTranslated(point.x, point.y, 0);
-      glRotated(vp.rotation * 180 / M_PI, 0, 0, 1);
-    }
+  wxMutexLocker lock(m_OverlayTileMutex);
+  if (generation != m_OverlayTileGeneration) return;  // isochrones cleared
+  m_OverlayTiles[key] = std::move(tile);
 
-    glColor3ub(colour.Red(), colour.Green(), colour.Blue());
-    //      Enable anti-aliased lines, at best quality
-    glEnable(GL_BLEND);
-    glLineWidth(2);
-    glEnableClientState(GL_VERTEX_ARRAY);
+  // redraw once the requested tiles are done, and now and then during a long
+  // queue so the tiles merge into view as they complete
+  if (m_OverlayTileRequests.empty() || m_OverlayTileRefresh.Time() > 500) {
+    m_OverlayTileRefresh.Start();
+    wxTheApp->CallAfter([]() { RequestRefresh(GetOCPNCanvasWindow()); });
   }
-#endif
-
-  if (dc.GetDC()) {
-    if (nocache)
-      current_cache.draw(dc.GetDC());
-    else {
-      LineBuffer tb;
-      tb.pushTransformedBuffer(current_cache, point.x,
-                               dc.GetDC()->GetSize().y - point.y, vp.rotation);
-      tb.Finalize();
-      tb.draw(dc.GetDC());
-    }
-  } else
-    current_cache.draw(nullptr);
+}
 
-#if defined(ocpnUSE_GL) && !defined(__OCPN__ANDROID__)
-  if (!dc.GetDC()) {
-    glDisableClientState(GL_VERTEX_ARRAY);
+void RouteMapOverlay::DeleteOverlayTileThread() {
+  if (!m_OverlayTileThread) return;
 
-    if (!nocache) glPopMatrix();
-  }
-#endif
+  m_OverlayTileThread->Delete();
+  delete m_OverlayTileThread;
+  m_OverlayTileThread = nullptr;
 }
 
 void RouteMapOverlay::GetLLBounds(double& latmin, double& latmax,
@@ -1401,6 +1564,7 @@ void RouteMapOverlay::GetLLBounds(double& latmin, double& latmax,
 }
 
 void RouteMapOverlay::RequestGrib(wxDateTime time) {
+  RoutingTraceSpan trace("RequestGrib", "grib");
   Json::Value v;
   time = time.FromUTC();
   v["Day"] = time.GetDay();
@@ -1422,11 +1586,14 @@ void RouteMapOverlay::RequestGrib(wxDateTime time) {
 std::list<PlotData>& RouteMapOverlay::GetPlotData(bool cursor_route) {
   std::list<PlotData>& plotdata =
       cursor_route ? last_cursor_plotdata : last_destination_plotdata;
-  if (!cursor_route && clear_destination_plotdata) {
+  if (clear_destination_plotdata) {
+    // the last step of the route may now have a different duration
     clear_destination_plotdata = false;
-    plotdata.clear();
+    last_destination_plotdata.clear();
+    m_LegPlotData.clear();
   }
   if (plotdata.empty()) {
+    m_RouteInfoCache[cursor_route].valid = false;
     Position* next =
         cursor_route ? last_cursor_position : last_destination_position;
 
@@ -1449,6 +1616,15 @@ std::list<PlotData>& RouteMapOverlay::GetPlotData(bool cursor_route) {
       itp = it;
       itp--;
 
+      auto cached = m_LegPlotData.find(next);
+      if (cached != m_LegPlotData.end()) {
+        plotdata.push_front(cached->second);
+        it = itp;
+        next = pos;
+        pos = pos->parent;
+        continue;
+      }
+
       configuration.grib = (*it)->m_Grib;
       configuration.time = (*it)->time;
       // printf("grib time %p %d\n", configuration.grib, configuration.time);
@@ -1459,8 +1635,10 @@ std::list<PlotData>& RouteMapOverlay::GetPlotData(bool cursor_route) {
       double dt = configuration.UsedDeltaTime;
       data.time = (*it)->time;
 
-      if (pos->GetPlotData(next, dt, configuration, data))
+      if (pos->GetPlotData(next, dt, configuration, data)) {
+        m_LegPlotData[next] = data;
         plotdata.push_front(data);
+      }
 
       it = itp;
       next = pos;
@@ -1475,99 +1653,85 @@ std::list<PlotData>& RouteMapOverlay::GetPlotData(bool cursor_route) {
 double RouteMapOverlay::RouteInfo(enum RouteInfoType type, bool cursor_route) {
   std::list<PlotData>& plotdata = GetPlotData(cursor_route);
 
-  double total = 0, count = 0, lat0 = 0, lon0 = 0;
-  int comfort = 0, current_comfort = 0;
-  for (std::list<PlotData>::iterator it = plotdata.begin();
+  /* every metric is computed in one pass and kept until the plot data
+     changes, the route list asks for a dozen of them per route */
+  RouteInfoCache& cache = m_RouteInfoCache[cursor_route];
+  bool finished = Finished();
+  if (!cache.valid || cache.finished != finished) {
+    RouteInfo(plotdata, cache.info);
+    cache.valid = true;
+    cache.finished = finished;
+  }
+  return cache.info[type];
+}
+
+void RouteMapOverlay::RouteInfo(const std::list<PlotData>& plotdata,
+                                double info[ROUTE_INFO_TYPES]) {
+  for (int i = 0; i < ROUTE_INFO_TYPES; i++) info[i] = 0;
+
+  double count = 0, lat0 = 0, lon0 = 0;
+  int comfort = 0;
+  for (std::list<PlotData>::const_iterator it = plotdata.begin();
        it != plotdata.end(); it++) {
-    switch (type) {
-      case DISTANCE: {
-        if (it != plotdata.begin())
-          total += DistGreatCircle_Plugin(lat0, lon0, it->lat, it->lon);
-
-        lat0 = it->lat;
-        lon0 = it->lon;
-      } break;
-      case AVGSPEED:
-        total += it->stw;
-        break;
-      case MAXSPEED:
-        if (total < it->stw) total = it->stw;
-        break;
-      case AVGSPEEDGROUND:
-        total += it->sog;
-        break;
-      case MAXSPEEDGROUND:
-        if (total < it->sog) total = it->sog;
-        break;
-      case AVGWIND:
-        total += it->twsOverWater;
-        break;
-      case MAXWIND:
-        if (total < it->twsOverWater) total = it->twsOverWater;
-        break;
-      case MAXWINDGUST:
-        if (total < it->VW_GUST) total = it->VW_GUST;
-        break;
-      case AVGCURRENT:
-        total += it->currentSpeed;
-        break;
-      case MAXCURRENT:
-        if (total < it->currentSpeed) total = it->currentSpeed;
-        break;
-      case AVGSWELL:
-        total += it->WVHT;
-        break;
-      case MAXSWELL:
-        if (total < it->WVHT) total = it->WVHT;
-        break;
-      case PERCENTAGE_UPWIND:
-        if (fabs(heading_resolve(it->ctw - it->twdOverWater)) < 90) total++;
-        break;
-      case PORT_STARBOARD:
-        if (heading_resolve(it->ctw - it->twdOverWater) > 0) total++;
-        break;
-      // CUSTOMIZATION
-      // Comfort on route
-      case COMFORT:
-        current_comfort = sailingConditionLevel(*it);
-        if (current_comfort > comfort) comfort = current_comfort;
-        break;
-      default:
-        break;
-    }
+    if (it != plotdata.begin())
+      info[DISTANCE] += DistGreatCircle_Plugin(lat0, lon0, it->lat, it->lon);
+    lat0 = it->lat;
+    lon0 = it->lon;
+
+    info[AVGSPEED] += it->stw;
+    if (info[MAXSPEED] < it->stw) info[MAXSPEED] = it->stw;
+    info[AVGSPEEDGROUND] += it->sog;
+    if (info[MAXSPEEDGROUND] < it->sog) info[MAXSPEEDGROUND] = it->sog;
+    info[AVGWIND] += it->twsOverWater;
+    if (info[MAXWIND] < it->twsOverWater) info[MAXWIND] = it->twsOverWater;
+    if (info[MAXWINDGUST] < it->VW_GUST) info[MAXWINDGUST] = it->VW_GUST;
+    info[AVGCURRENT] += it->currentSpeed;
+    if (info[MAXCURRENT] < it->currentSpeed)
+      info[MAXCURRENT] = it->currentSpeed;
+    info[AVGSWELL] += it->WVHT;
+    if (info[MAXSWELL] < it->WVHT) info[MAXSWELL] = it->WVHT;
+
+    double relative_wind = heading_resolve(it->ctw - it->twdOverWater);
+    if (fabs(relative_wind) < 90) info[PERCENTAGE_UPWIND]++;
+    if (relative_wind > 0) info[PORT_STARBOARD]++;
+
+    // CUSTOMIZATION
+    // Comfort on route
+    int current_comfort = sailingConditionLevel(*it);
+    if (current_comfort > comfort) comfort = current_comfort;
+
     count++;
   }
 
   /* fixup data */
-  switch (type) {
-    case TACKS:
-      return plotdata.size() ? plotdata.back().tacks : 0;
-    case JIBES:
-      return plotdata.size() ? plotdata.back().jibes : 0;
-    case DISTANCE:
-      if (total == 0)
-        total = NAN;
-      else if (Finished()) {
-        RouteMapConfiguration configuration = GetConfiguration();
-        total += DistGreatCircle_Plugin(lat0, lon0, configuration.EndLat,
-                                        configuration.EndLon);
-      }
-      return total;
-    case COMFORT:
-      return comfort;
-    case PERCENTAGE_UPWIND:
-    case PORT_STARBOARD:
-      total *= 100.0;
-    case AVGSPEED:
-    case AVGSPEEDGROUND:
-    case AVGWIND:
-    case AVGCURRENT:
-    case AVGSWELL:
-      total /= count;
-    default:
-      break;
-  }
-  return total;
+  if (plotdata.size()) {
+    info[TACKS] = plotdata.back().tacks;
+    info[JIBES] = plotdata.back().jibes;
+  }
+
+  if (info[DISTANCE] == 0)
+    info[DISTANCE] = NAN;
+  else if (Finished()) {
+    std::shared_ptr<const RouteMapConfiguration> configuration =
+        GetConfigurationSnapshot();
+    info[DISTANCE] += DistGreatCircle_Plugin(
+        lat0, lon0, configuration->EndLat, configuration->EndLon);
+  }
+
+  info[COMFORT] = comfort;
+
+  info[PERCENTAGE_UPWIND] *= 100.0;
+  info[PORT_STARBOARD] *= 100.0;
+  const RouteInfoType averages[] = {PERCENTAGE_UPWIND, PORT_STARBOARD,
+                                    AVGSPEED,          AVGSPEEDGROUND,
+                                    AVGWIND,           AVGCURRENT,
+                                    AVGSWELL};
+  for (RouteInfoType type : averages) info[type] /= count;
+}
+
+void RouteMapOverlay::InvalidateRouteInfo() {
+  m_RouteInfoCache[0].valid = false;
+  m_RouteInfoCache[1].valid = false;
 }
 
 /* how many cyclone tracks did we cross? which month? */
@@ -1604,7 +1768,414 @@ void RouteMapOverlay::Clear() {
   // clear_cursor_plotdata = false;
   last_cursor_plotdata.clear();
   last_destination_plotdata.clear();
+  m_LegPlotData.clear();
+  InvalidateRouteInfo();
+  m_SnapshotFileName = wxEmptyString;
+  m_SnapshotFingerprint = 0;
+  {
+    wxMutexLocker lock(m_OverlayTileMutex);
+    m_OverlayTiles.clear();
+    m_OverlayTileRequests.clear();
+    m_OverlayTileGeneration++;
+  }
+  isochron_cache.clear();
+  m_UpdateOverlay = true;
+}
+
+/* Binary route map snapshots.  Values are written in host byte order, the
+   byte order marker lets a different host reject the file. Bump the version
+   whenever the layout changes. */
+static const char SNAPSHOT_MAGIC[8] = {'W', 'R', 'S', 'N',
+                                      'A', 'P', '\r', '\n'};
+static const uint32_t SNAPSHOT_VERSION = 2;
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+static const int64_t SNAPSHOT_INVALID_TIME = INT64_MIN;
+
+template <typename T>
+static void SnapshotPut(std::vector<char>& buffer, const T& value) {
+  const char* p = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), p, p + sizeof(T));
+}
+
+static void SnapshotPutTime(std::vector<char>& buffer, const wxDateTime& t) {
+  SnapshotPut<int64_t>(buffer, t.IsValid() ? t.GetValue().GetValue()
+                                           : SNAPSHOT_INVALID_TIME);
+}
+
+static void SnapshotPutRoutePoint(std::vector<char>& buffer,
+                                  const RoutePoint& p) {
+  SnapshotPut(buffer, p.lat);
+  SnapshotPut(buffer, p.lon);
+  SnapshotPut<int32_t>(buffer, p.polar);
+  SnapshotPut<int32_t>(buffer, p.tacks);
+  SnapshotPut<int32_t>(buffer, p.jibes);
+  SnapshotPut<int32_t>(buffer, p.sail_plan_changes);
+  SnapshotPut<uint8_t>(buffer, p.grib_is_data_deficient);
+  SnapshotPut<uint32_t>(buffer, static_cast<uint32_t>(p.data_mask));
+}
+
+/* positions are numbered in the order they are written, parents always
+   belong to an earlier isochrone so they are numbered first */
+static void SnapshotPutPosition(
+    std::vector<char>& buffer, const Position* p,
+    std::unordered_map<const Position*, int32_t>& index) {
+  auto parent = index.find(p->parent);
+  SnapshotPut<int32_t>(buffer, parent == index.end() ? -1 : parent->second);
+  SnapshotPutRoutePoint(buffer, *p);
+  SnapshotPut(buffer, p->parent_heading);
+  SnapshotPut(buffer, p->parent_bearing);
+  SnapshotPut<uint8_t>(buffer, p->propagated | p->copied << 1);
+
+  int32_t id = index.size();
+  index[p] = id;
+}
+
+static void SnapshotPutRoute(
+    std::vector<char>& buffer, const IsoRoute* route,
+    std::unordered_map<const Position*, int32_t>& index) {
+  SnapshotPut<int32_t>(buffer, route->direction);
+
+  uint32_t count = 0;
+  Position* p = route->skippoints->point;
+  do {
+    count++;
+    p = p->next;
+  } while (p != route->skippoints->point);
+
+  SnapshotPut(buffer, count);
+  do {
+    SnapshotPutPosition(buffer, p, index);
+    p = p->next;
+  } while (p != route->skippoints->point);
+
+  SnapshotPut<uint32_t>(buffer, route->children.size());
+  for (IsoRoute* child : route->children)
+    SnapshotPutRoute(buffer, child, index);
+}
+
+static void SnapshotPutPlotData(std::vector<char>& buffer,
+                                const PlotData& data) {
+  SnapshotPutRoutePoint(buffer, data);
+  SnapshotPutTime(buffer, data.time);
+  const double values[] = {data.delta, data.sog, data.cog, data.stw, data.ctw,
+      data.hdg, data.twsOverWater, data.twdOverWater, data.twsOverGround,
+      data.twdOverGround, data.currentSpeed, data.currentDir, data.WVHT,
+      data.WVDIR, data.WVREL, data.WVPER, data.VW_GUST, data.cloud_cover,
+      data.rain_mm_per_hour, data.air_temp, data.sea_surface_temp, data.cape,
+      data.relative_humidity, data.air_pressure, data.reflectivity};
+  for (double value : values) SnapshotPut(buffer, value);
+}
+
+/* Bounds checked reading of a snapshot.  Reading past the end yields zeroes
+   and clears ok, so callers only need to test ok once per record. */
+class SnapshotReader {
+public:
+  SnapshotReader(const std::vector<char>& buffer)
+      : m_Buffer(buffer), m_Offset(0), ok(true) {}
+
+  template <typename T>
+  T Get() {
+    T value = T();
+    if (m_Offset + sizeof(T) > m_Buffer.size()) {
+      ok = false;
+      return value;
+    }
+    memcpy(&value, &m_Buffer[m_Offset], sizeof(T));
+    m_Offset += sizeof(T);
+    return value;
+  }
+
+  wxDateTime GetTime() {
+    int64_t t = Get<int64_t>();
+    return t == SNAPSHOT_INVALID_TIME ? wxDateTime()
+                                      : wxDateTime(wxLongLong(t));
+  }
+
+  void GetRoutePoint(RoutePoint& p) {
+    p.lat = Get<double>();
+    p.lon = Get<double>();
+    p.polar = Get<int32_t>();
+    p.tacks = Get<int32_t>();
+    p.jibes = Get<int32_t>();
+    p.sail_plan_changes = Get<int32_t>();
+    p.grib_is_data_deficient = Get<uint8_t>();
+    p.data_mask = static_cast<DataMask>(Get<uint32_t>());
+  }
+
+  /* returns null if the record is truncated or its parent is unknown */
+  Position* GetPosition(const std::vector<Position*>& positions) {
+    int32_t parent = Get<int32_t>();
+    RoutePoint rp;
+    GetRoutePoint(rp);
+    double parent_heading = Get<double>();
+    double parent_bearing = Get<double>();
+    uint8_t flags = Get<uint8_t>();
+    if (!ok || parent < -1 || parent >= (int32_t)positions.size())
+      return nullptr;
+
+    Position* p = new Position(
+        rp.lat, rp.lon, parent == -1 ? nullptr : positions[parent],
+        parent_heading, parent_bearing, rp.polar, rp.tacks, rp.jibes,
+        rp.sail_plan_changes, rp.data_mask, rp.grib_is_data_deficient);
+    p->propagated = flags & 1;
+    p->copied = flags & 2;
+    return p;
+  }
+
+  IsoRoute* GetRoute(std::vector<Position*>& positions) {
+    int32_t direction = Get<int32_t>();
+    uint32_t count = Get<uint32_t>();
+    if (!ok || count == 0) return nullptr;
+
+    Position* first = nullptr;
+    for (uint32_t i = 0; i < count; i++) {
+      Position* p = GetPosition(positions);
+      if (!p) {
+        if (first) DeletePoints(first);
+        return nullptr;
+      }
+      if (first) {
+        p->prev = first->prev;
+        p->next = first;
+        first->prev->next = p;
+        first->prev = p;
+      } else {
+        first = p;
+        p->prev = p->next = p;
+      }
+      positions.push_back(p);
+    }
+
+    IsoRoute* route = new IsoRoute(first->BuildSkipList(), direction);
+    uint32_t children = Get<uint32_t>();
+    for (uint32_t i = 0; ok && i < children; i++) {
+      IsoRoute* child = GetRoute(positions);
+      if (!child) break;
+      child->parent = route;
+      route->children.push_back(child);
+    }
+    if (!ok || route->children.size() != children) {
+      delete route;
+      return nullptr;
+    }
+    return route;
+  }
+
+  void GetPlotData(PlotData& data) {
+    GetRoutePoint(data);
+    data.time = GetTime();
+    double* values[] = {&data.delta, &data.sog, &data.cog, &data.stw, &data.ctw,
+        &data.hdg, &data.twsOverWater, &data.twdOverWater, &data.twsOverGround,
+        &data.twdOverGround, &data.currentSpeed, &data.currentDir, &data.WVHT,
+        &data.WVDIR, &data.WVREL, &data.WVPER, &data.VW_GUST, &data.cloud_cover,
+        &data.rain_mm_per_hour, &data.air_temp, &data.sea_surface_temp,
+        &data.cape, &data.relative_humidity, &data.air_pressure,
+        &data.reflectivity};
+    for (double* value : values) *value = Get<double>();
+  }
+
+private:
+  const std::vector<char>& m_Buffer;
+  size_t m_Offset;
+
+public:
+  bool ok;
+};
+
+bool RouteMapOverlay::SaveSnapshot(const wxString& filename,
+                                   uint64_t fingerprint) {
+  std::vector<char> buffer;
+  buffer.insert(buffer.end(), SNAPSHOT_MAGIC,
+                SNAPSHOT_MAGIC + sizeof SNAPSHOT_MAGIC);
+  SnapshotPut(buffer, SNAPSHOT_VERSION);
+  SnapshotPut(buffer, SNAPSHOT_BYTE_ORDER);
+  SnapshotPut(buffer, fingerprint);
+
+  SnapshotPut<uint8_t>(buffer, ReachedDestination());
+  SnapshotPutTime(buffer, m_EndTime);
+  std::list<PlotData>& plotdata = GetPlotData(false);
+
+  std::unordered_map<const Position*, int32_t> index;
+  Lock();
+
+  SnapshotPut<uint32_t>(buffer, origin.size());
+  for (IsoChron* isochron : origin) {
+    SnapshotPutTime(buffer, isochron->time);
+    SnapshotPut(buffer, isochron->delta);
+    SnapshotPut<uint8_t>(buffer, isochron->m_Grib_is_data_deficient);
+    SnapshotPut<int64_t>(buffer, isochron->m_Grib
+                                     ? isochron->m_Grib->m_Reference_Time
+                                     : SNAPSHOT_INVALID_TIME);
+    SnapshotPut<uint32_t>(buffer,
+                          isochron->m_Grib ? isochron->m_Grib->m_ID : 0);
+    SnapshotPut<uint32_t>(buffer, isochron->routes.size());
+    for (IsoRoute* route : isochron->routes)
+      SnapshotPutRoute(buffer, route, index);
+  }
+
+  SnapshotPut<uint8_t>(buffer, destination_position != nullptr);
+  if (destination_position)
+    SnapshotPutPosition(buffer, destination_position, index);
+  Unlock();
+
+  SnapshotPut<uint32_t>(buffer, plotdata.size());
+  for (const PlotData& data : plotdata) SnapshotPutPlotData(buffer, data);
+
+  wxFile file;
+  if (!file.Create(filename, true) ||
+      file.Write(buffer.data(), buffer.size()) != buffer.size())
+    return false;
+
+  m_SnapshotFileName = filename;
+  m_SnapshotFingerprint = fingerprint;
+  return true;
+}
+
+void RouteMapOverlay::DeleteSnapshot() {
+  if (!m_SnapshotFileName.IsEmpty() &&
+      wxFileName::FileExists(m_SnapshotFileName))
+    wxRemoveFile(m_SnapshotFileName);
+  m_SnapshotFileName = wxEmptyString;
+  m_SnapshotFingerprint = 0;
+}
+
+bool RouteMapOverlay::LoadSnapshot(const wxString& filename,
+                                   uint64_t fingerprint, wxString& error) {
+  /* read the whole file in one go, parsing is what takes the time */
+  wxFile file;
+  std::vector<char> buffer;
+  if (!file.Open(filename) || file.Length() < 0) {
+    error = _("Failed to open snapshot file: ") + filename;
+    return false;
+  }
+  buffer.resize(file.Length());
+  if (file.Read(buffer.data(), buffer.size()) != (ssize_t)buffer.size()) {
+    error = _("Failed to read snapshot file: ") + filename;
+    return false;
+  }
+
+  SnapshotReader reader(buffer);
+  char magic[sizeof SNAPSHOT_MAGIC];
+  for (char& c : magic) c = reader.Get<char>();
+  if (!reader.ok || memcmp(magic, SNAPSHOT_MAGIC, sizeof magic)) {
+    error = _("Not a weather routing snapshot: ") + filename;
+    return false;
+  }
+  if (reader.Get<uint32_t>() != SNAPSHOT_VERSION ||
+      reader.Get<uint32_t>() != SNAPSHOT_BYTE_ORDER) {
+    error = _("Unsupported snapshot version or byte order: ") + filename;
+    return false;
+  }
+  if (reader.Get<uint64_t>() != fingerprint) {
+    error = _("Snapshot of a different configuration: ") + filename;
+    return false;
+  }
+
+  bool reached_destination = reader.Get<uint8_t>();
+  wxDateTime endtime = reader.GetTime();
+
+  IsoChronList isochrones;
+  std::vector<Position*> positions;
+  Shared_GribRecordSet nogrib;
+  wxDateTime gribtime;
+  uint32_t gribid = 0;
+  uint32_t count = reader.Get<uint32_t>();
+  for (uint32_t i = 0; reader.ok && i < count; i++) {
+    wxDateTime time = reader.GetTime();
+    double delta = reader.Get<double>();
+    bool grib_is_data_deficient = reader.Get<uint8_t>();
+    int64_t reference_time = reader.Get<int64_t>();
+    uint32_t id = reader.Get<uint32_t>();
+    // the GRIB was requested for the time of the first step which used one
+    if (!gribtime.IsValid() && reference_time != SNAPSHOT_INVALID_TIME) {
+      gribtime = time;
+      gribid = id;
+    }
+    uint32_t routecount = reader.Get<uint32_t>();
+
+    IsoRouteList routes;
+    for (uint32_t j = 0; reader.ok && j < routecount; j++) {
+      IsoRoute* route = reader.GetRoute(positions);
+      if (route)
+        routes.push_back(route);
+      else
+        reader.ok = false;
+    }
+    isochrones.push_back(
+        new IsoChron(routes, time, delta, nogrib, grib_is_data_deficient));
+  }
+
+  Position* destination = nullptr;
+  if (reader.ok && reader.Get<uint8_t>()) {
+    destination = reader.GetPosition(positions);
+    if (!destination) reader.ok = false;
+  }
+
+  std::list<PlotData> plotdata;
+  count = reader.Get<uint32_t>();
+  for (uint32_t i = 0; reader.ok && i < count; i++) {
+    PlotData data;
+    reader.GetPlotData(data);
+    plotdata.push_back(data);
+  }
+
+  bool rejected = !reader.ok || isochrones.empty();
+  if (rejected)
+    error = _("Corrupt snapshot file: ") + filename;
+  else if (gribtime.IsValid()) {
+    // without a GRIB loaded for the start there is nothing to compare with
+    Lock();
+    m_NewGrib = nullptr;
+    m_SharedNewGrib.SetGribRecordSet(0);
+    Unlock();
+    RequestGrib(gribtime);
+    Lock();
+    rejected = m_NewGrib && m_NewGrib->m_ID != gribid;
+    if (rejected)
+      error = _("Snapshot computed with a different GRIB: ") + filename;
+    m_NewGrib = nullptr;
+    m_SharedNewGrib.SetGribRecordSet(0);
+    Unlock();
+  }
+  if (rejected) {
+    for (IsoChron* isochron : isochrones) delete isochron;
+    delete destination;
+    return false;
+  }
+
+  std::shared_ptr<const RouteMapConfiguration> configuration =
+      GetConfigurationSnapshot();
+
+  Lock();
+  Clear();
+  origin.swap(isochrones);
+  delete destination_position;
+  destination_position = destination;
+  last_destination_plotdata.swap(plotdata);
+  InvalidateRouteInfo();
+  m_EndTime = endtime;
+  SetRestored(reached_destination);
+  m_SnapshotFileName = filename;
+  m_SnapshotFingerprint = fingerprint;
+  Unlock();
+
+  last_destination_position =
+      destination
+          ? destination
+          : ClosestPosition(configuration->EndLat, configuration->EndLon);
+
+  // the GRIB is gone, so keep the restored legs for cursor routes
+  if (last_destination_position) {
+    std::list<Position*> route = last_destination_position->BuildRoute();
+    if (route.size() == last_destination_plotdata.size() + 1) {
+      std::list<Position*>::iterator next = route.begin();
+      for (const PlotData& data : last_destination_plotdata)
+        m_LegPlotData[*++next] = data;
+    }
+  }
+  m_bUpdated = true;
   m_UpdateOverlay = true;
+  return true;
 }
 
 void RouteMapOverlay::UpdateCursorPosition() {
@@ -1691,7 +2262,7 @@ void RouteMapOverlay::UpdateDestination() {
     m_EndTime = wxDateTime();  // invalid
   }
 
-  if (last_last_destination_position != last_destination_position) {
+  if (last_last_destination_position != last_destination_position || done) {
     // we can't clear because we are inside a worker thread
     // and there's a race with GetPlotData
     clear_destination_plotdata = true;
@@ -1709,13 +2280,14 @@ Position* RouteMapOverlay::getClosestRoutePositionFromCursor(
    * the weather route based on the cursor position
    */
 
-  RouteMapConfiguration configuration = GetConfiguration();
+  std::shared_ptr<const RouteMapConfiguration> configuration =
+      GetConfigurationSnapshot();
   const double normalizedCursorLon =
-      configuration.positive_longitudes ? positive_degrees(cursorLon)
+      configuration->positive_longitudes ? positive_degrees(cursorLon)
                                         : cursorLon;
 
   double dist = INFINITY;
-  std::list<PlotData> plot = GetPlotData(false);
+  std::list<PlotData>& plot = GetPlotData(false);
   bool found = false;
   posData.time = wxInvalidDateTime;
   for (const auto& it : plot) {
@@ -36,7 +36,8 @@ WeatherData::WeatherData(RoutePoint* position)
       twsOverWater(0),
       currentDir(0),
       currentSpeed(0),
-      swell(0) {}
+      swell(0),
+      dayLight(DayLightStatus::Day) {}
 
 /* get data from a position for plotting */
 bool RoutePoint::GetPlotData(RoutePoint* next, double dt,
@@ -146,11 +147,11 @@ bool BoatData::GetBoatSpeedForPolar(RouteMapConfiguration& configuration,
                                     double twa, double ctw, DataMask& data_mask,
                                     bool bound, const char* caller) {
   if (newpolar < 0 ||
-      newpolar >= static_cast<int>(configuration.boat.Polars.size())) {
+      newpolar >= static_cast<int>(configuration.boat->Polars.size())) {
     // Sanity check - invalid polar index.
     return false;
   }
-  Polar& polar = configuration.boat.Polars[newpolar];
+  const Polar& polar = configuration.boat->Polars[newpolar];
   PolarSpeedStatus polar_status;
   bool used_grib = false;  // true if grib data was used, false if climatology.
   bool using_motor = false;  // true if motor is being used instead of sailing
@@ -230,12 +231,7 @@ bool BoatData::GetBoatSpeedForPolar(RouteMapConfiguration& configuration,
   }
 
   if (configuration.NightCumulativeEfficiency != 1.0) {
-    // Determine if it's day or night at the current position and time.
-    DayLightStatus dayLightStatus =
-        SunCalculator::GetInstance().GetDayLightStatus(
-            weather_data.lat, weather_data.lon, configuration.time);
-
-    if (dayLightStatus == DayLightStatus::Night) {
+    if (weather_data.dayLight == DayLightStatus::Night) {
       if (!using_motor) {
         // Apply day/night efficiency factor only if not motoring.
         // Skip night efficiency when motoring as engine power is consistent.
@@ -257,7 +253,8 @@ bool BoatData::GetBoatSpeedForPolar(RouteMapConfiguration& configuration,
 
 bool WeatherData::ReadWeatherDataAndCheckConstraints(
     RouteMapConfiguration& configuration, RoutePoint* position,
-    DataMask& data_mask, PropagationError& error_code, bool end) {
+    DataMask& data_mask, PropagationError& error_code, bool end,
+    bool lookup_daylight) {
   if (!ConstraintChecker::CheckSwellConstraint(configuration, lat, lon, swell,
                                                error_code)) {
     return false;
@@ -268,9 +265,14 @@ bool WeatherData::ReadWeatherDataAndCheckConstraints(
   }
 
   // Read wind and current data
-  if (!WeatherDataProvider::ReadWindAndCurrents(
-          configuration, position, twdOverGround, twsOverGround, twdOverWater,
-          twsOverWater, currentDir, currentSpeed, atlas, data_mask)) {
+  bool read;
+  {
+    RoutingPhaseTimer timer(configuration.profile, RoutingProfile::WEATHER);
+    read = WeatherDataProvider::ReadWindAndCurrents(
+        configuration, position, twdOverGround, twsOverGround, twdOverWater,
+        twsOverWater, currentDir, currentSpeed, atlas, data_mask);
+  }
+  if (!read) {
     error_code = PROPAGATION_WIND_DATA_FAILED;
     if (!end) {
       wxString txt = _("No wind data for this position at that time");
@@ -281,6 +283,15 @@ bool WeatherData::ReadWeatherDataAndCheckConstraints(
     return false;
   }
 
+  // The reverse pass of a bidirectional route sails with the wind and
+  // current reversed.
+  if (configuration.ReverseTime) {
+    twdOverGround = positive_degrees(twdOverGround + 180);
+    twdOverWater = positive_degrees(twdOverWater + 180);
+    currentDir = positive_degrees(currentDir + 180);
+    for (int i = 0; i < 8; i++) atlas.W[i] = positive_degrees(atlas.W[i] + 180);
+  }
+
   // Check if wind exceeds configured maximum limit (safety limit)
   if (!ConstraintChecker::CheckMaxTrueWindConstraint(
           configuration, twsOverWater, error_code)) {
@@ -296,6 +307,12 @@ bool WeatherData::ReadWeatherDataAndCheckConstraints(
     return false;
   }
 
+  if (lookup_daylight && configuration.NightCumulativeEfficiency != 1.0) {
+    // Determine if it's day or night at the current position and time.
+    dayLight = SunCalculator::GetInstance().GetDayLightStatus(
+        lat, lon, configuration.time);
+  }
+
   return true;
 }
 
@@ -305,9 +322,10 @@ bool BoatData::GetBestPolarAndBoatSpeed(RouteMapConfiguration& configuration,
                                         double parent_heading,
                                         DataMask& data_mask, int polar,
                                         int& newpolar, double& timeseconds) {
+  RoutingPhaseTimer timer(configuration.profile, RoutingProfile::POLAR);
   Reset();
   PolarSpeedStatus status;
-  newpolar = configuration.boat.FindBestPolarForCondition(
+  newpolar = configuration.boat->FindBestPolarForCondition(
       polar, weather_data.twsOverWater, twa, weather_data.swell,
       configuration.OptimizeTacking, &status);
   bool inside_polar_bounds = true;
@@ -581,15 +599,21 @@ double RoutePoint::PropagateToPoint(double dlat, double dlon,
   }
 
   /* landfall test if we are within 60 miles (otherwise it's very slow) */
-  if (configuration.DetectLand && dist < 60 && CrossesLand(dlat, dlon)) {
-    if (!end) configuration.land_crossing = true;
-    return NAN;
+  if (configuration.DetectLand && dist < 60) {
+    RoutingPhaseTimer timer(configuration.profile, RoutingProfile::LAND);
+    if (CrossesLand(dlat, dlon)) {
+      if (!end) configuration.land_crossing = true;
+      return NAN;
+    }
   }
 
   /* Boundary test */
-  if (configuration.DetectBoundary && EntersBoundary(dlat, dlon)) {
-    if (!end) configuration.boundary_crossing = true;
-    return NAN;
+  if (configuration.DetectBoundary) {
+    RoutingPhaseTimer timer(configuration.profile, RoutingProfile::BOUNDARY);
+    if (EntersBoundary(dlat, dlon)) {
+      if (!end) configuration.boundary_crossing = true;
+      return NAN;
+    }
   }
 
   /* crosses cyclone track(s)? */
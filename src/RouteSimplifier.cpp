@@ -29,13 +29,76 @@
 #include "georef.h"
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cmath>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+/* Runs iterations of a parallel loop until there are none left. */
+void RunIterations(std::atomic<size_t>& next, size_t count,
+                   const std::function<void(size_t)>& body) {
+  for (size_t i = next++; i < count; i = next++) body(i);
+}
+
+class SimplifierThread : public wxThread {
+public:
+  SimplifierThread(std::atomic<size_t>& next, size_t count,
+                   const std::function<void(size_t)>& body)
+      : wxThread(wxTHREAD_JOINABLE),
+        m_next(next),
+        m_count(count),
+        m_body(body) {
+    Create();
+  }
+
+  void* Entry() override {
+    RunIterations(m_next, m_count, m_body);
+    return 0;
+  }
+
+private:
+  std::atomic<size_t>& m_next;
+  size_t m_count;
+  const std::function<void(size_t)>& m_body;
+};
+
+/* Records the time of every position of a route and of its children, not
+   only of those in its skip list. */
+void IndexPositionTimes(
+    IsoRoute* route, const wxTimeSpan& timeFromStart,
+    std::unordered_map<const Position*, wxTimeSpan>& positionTimes) {
+  if (!route || !route->skippoints) return;
+  Position* pos = route->skippoints->point;
+  do {
+    positionTimes.emplace(pos, timeFromStart);
+    pos = pos->next;
+  } while (pos != route->skippoints->point);
+  for (IsoRoute* child : route->children)
+    IndexPositionTimes(child, timeFromStart, positionTimes);
+}
+
+}  // namespace
 
 RouteSimplifier::RouteSimplifier(RouteMapOverlay* routemap)
     : m_routemap(routemap) {
   if (routemap) {
     m_configuration = routemap->GetConfiguration();
     m_originalRoute = ExtractPositionsFromRouteMap(routemap);
+
+    // Index the isochrone of each position, the durations look up many.
+    const IsoChronList& isochrones = routemap->GetIsoChronList();
+    if (!isochrones.empty() && isochrones.front()) {
+      wxDateTime startTime = isochrones.front()->time;
+      for (const IsoChron* isochron : isochrones) {
+        if (!isochron) continue;
+        for (IsoRoute* route : isochron->routes)
+          IndexPositionTimes(route, isochron->time - startTime,
+                             m_positionTimes);
+      }
+    }
   }
 }
 
@@ -295,6 +358,13 @@ SimplificationResult RouteSimplifier::Simplify(
   // Total duration of the entire route after simplification.
   wxTimeSpan totalSimplifiedDuration = wxTimeSpan(0);
 
+  // Simplify the segments in parallel, they do not depend on each other.
+  std::vector<std::list<Position*>> simplifiedSegments(segments.size());
+  ParallelFor(segments.size(), params.threads, [&](size_t i) {
+    if (segments[i].points.size() >= 3)
+      simplifiedSegments[i] = SimplifySegment(segments[i], epsilon);
+  });
+
   // Process each segment.
   for (size_t i = 0; i < segments.size(); ++i) {
     RouteSegment& segment = segments[i];
@@ -316,123 +386,12 @@ SimplificationResult RouteSimplifier::Simplify(
       continue;
     }
 
-    // Apply Douglas-Peucker simplification to this segment.
-    std::list<Position*> simplifiedSegment = segment.points;
-    ApplyDouglasPeucker(simplifiedSegment, epsilon);
-
+    std::list<Position*>& simplifiedSegment = simplifiedSegments[i];
     wxLogGeneric(
         wxLOG_Debug,
         "RouteSimplifier: Segment %zu simplified from %zu to %zu points", i,
         originalSegmentSize, simplifiedSegment.size());
 
-    // Validate simplified segment can be sailed.
-    wxLogGeneric(wxLOG_Debug,
-                 "RouteSimplifier: Validating simplified segment %zu with "
-                 "RhumbLinePropagateToPoint",
-                 i);
-
-    // Only apply RhumbLinePropagateToPoint if simplification actually reduced
-    // the number of points.
-    if (simplifiedSegment.size() < segment.points.size()) {
-      std::list<Position*> validatedSegment;
-      validatedSegment.push_back(
-          simplifiedSegment.front());  // Always start with the first point
-
-      auto it = simplifiedSegment.begin();
-      auto next = std::next(it);
-
-      while (next != simplifiedSegment.end()) {
-        Position* start = *it;
-        Position* end = *next;
-
-        // Maximum segment length in nautical miles.
-        const double maxSegmentLength = 30.0;
-
-        // Calculate direct distance.
-        double distance =
-            DistGreatCircle_Plugin(start->lat, start->lon, end->lat, end->lon);
-
-        // For longer segments, use RhumbLinePropagateToPoint to validate.
-        if (distance > maxSegmentLength) {
-          std::vector<RoutePoint*> intermediatePoints;
-          // Use the data mask from the starting point.
-          DataMask data_mask = start->data_mask;
-          double totalDistance = 0.0;
-          double averageSpeed = 0.0;
-
-          // Create a copy of the configuration to use for validation.
-          RouteMapConfiguration tempConfig = m_configuration;
-
-          wxLogGeneric(
-              wxLOG_Debug,
-              "RouteSimplifier: Segment from (%.6f,%.6f) to (%.6f,%.6f) "
-              "distance=%.1f nm, validating with RhumbLinePropagateToPoint",
-              start->lat, start->lon, end->lat, end->lon, distance);
-
-          // Try to propagate along the rhumb line.
-          double propagationTime = start->RhumbLinePropagateToPoint(
-              end->lat, end->lon, tempConfig, intermediatePoints, data_mask,
-              totalDistance, averageSpeed, maxSegmentLength);
-
-          if (!std::isnan(propagationTime)) {
-            wxLogGeneric(wxLOG_Debug,
-                         "RouteSimplifier: Validated rhumb line segment: "
-                         "%.1f nm, %.1f knots avg",
-                         totalDistance, averageSpeed);
-
-            // Add all intermediate waypoints to our validated segment.
-            for (size_t j = 0; j < intermediatePoints.size(); j++) {
-              RoutePoint* rp = intermediatePoints[j];
-
-              // Convert RoutePoint to Position.
-              // Skip the first point as it's already in our route.
-              if (j > 0 || rp->lat != start->lat || rp->lon != start->lon) {
-                Position* pos = new Position(rp->lat, rp->lon);
-                // Set parent to maintain route structure.
-                pos->parent = validatedSegment.back();
-                pos->polar = rp->polar;
-                pos->tacks = rp->tacks;
-                pos->jibes = rp->jibes;
-                pos->sail_plan_changes = rp->sail_plan_changes;
-                pos->data_mask = rp->data_mask;
-                // Add to our list for later cleanup.
-                m_newPositions.push_back(pos);
-                validatedSegment.push_back(pos);
-              }
-
-              // Clean up RoutePoint since we converted it to Position.
-              delete rp;
-            }
-          } else {
-            // If rhumb line propagation failed, fall back to direct connection.
-            wxLogGeneric(
-                wxLOG_Debug,
-                "RouteSimplifier: Rhumb line propagation failed, using direct "
-                "connection");
-            validatedSegment.push_back(end);
-          }
-        } else {
-          // For shorter segments, just add the endpoint directly.
-          validatedSegment.push_back(end);
-        }
-
-        // Move to next segment.
-        it = next;
-        ++next;
-      }
-
-      // Replace simplified segment with validated segment if it's reasonable.
-      if (!validatedSegment.empty() &&
-          validatedSegment.size() <= segment.points.size() * 0.8) {
-        wxLogGeneric(
-            wxLOG_Debug,
-            "RouteSimplifier: Using validated segment with %zu points (vs "
-            "original %zu)",
-            validatedSegment.size(), segment.points.size());
-        simplifiedSegment = validatedSegment;
-      }
-    }
-
     // Calculate time for simplified segment.
     wxTimeSpan segmentSimplifiedDuration =
         CalculateRouteDuration(simplifiedSegment);
@@ -488,6 +447,122 @@ SimplificationResult RouteSimplifier::Simplify(
   return result;
 }
 
+std::list<Position*> RouteSimplifier::SimplifySegment(
+    const RouteSegment& segment, double epsilon) {
+  // Apply Douglas-Peucker simplification to this segment.
+  std::list<Position*> simplifiedSegment = segment.points;
+  ApplyDouglasPeucker(simplifiedSegment, epsilon);
+
+  // Validate simplified segment can be sailed.
+  wxLogGeneric(wxLOG_Debug,
+               "RouteSimplifier: Validating simplified segment with "
+               "RhumbLinePropagateToPoint");
+
+  // Only apply RhumbLinePropagateToPoint if simplification actually reduced
+  // the number of points.
+  if (simplifiedSegment.size() < segment.points.size()) {
+    std::list<Position*> validatedSegment;
+    validatedSegment.push_back(
+        simplifiedSegment.front());  // Always start with the first point
+
+    auto it = simplifiedSegment.begin();
+    auto next = std::next(it);
+
+    while (next != simplifiedSegment.end()) {
+      Position* start = *it;
+      Position* end = *next;
+
+      // Maximum segment length in nautical miles.
+      const double maxSegmentLength = 30.0;
+
+      // Calculate direct distance.
+      double distance =
+          DistGreatCircle_Plugin(start->lat, start->lon, end->lat, end->lon);
+
+      // For longer segments, use RhumbLinePropagateToPoint to validate.
+      if (distance > maxSegmentLength) {
+        std::vector<RoutePoint*> intermediatePoints;
+        // Use the data mask from the starting point.
+        DataMask data_mask = start->data_mask;
+        double totalDistance = 0.0;
+        double averageSpeed = 0.0;
+
+        // Create a copy of the configuration to use for validation.
+        RouteMapConfiguration tempConfig = m_configuration;
+
+        wxLogGeneric(
+            wxLOG_Debug,
+            "RouteSimplifier: Segment from (%.6f,%.6f) to (%.6f,%.6f) "
+            "distance=%.1f nm, validating with RhumbLinePropagateToPoint",
+            start->lat, start->lon, end->lat, end->lon, distance);
+
+        // Try to propagate along the rhumb line.
+        double propagationTime = start->RhumbLinePropagateToPoint(
+            end->lat, end->lon, tempConfig, intermediatePoints, data_mask,
+            totalDistance, averageSpeed, maxSegmentLength);
+
+        if (!std::isnan(propagationTime)) {
+          wxLogGeneric(wxLOG_Debug,
+                       "RouteSimplifier: Validated rhumb line segment: "
+                       "%.1f nm, %.1f knots avg",
+                       totalDistance, averageSpeed);
+
+          // Add all intermediate waypoints to our validated segment.
+          for (size_t j = 0; j < intermediatePoints.size(); j++) {
+            RoutePoint* rp = intermediatePoints[j];
+
+            // Convert RoutePoint to Position.
+            // Skip the first point as it's already in our route.
+            if (j > 0 || rp->lat != start->lat || rp->lon != start->lon) {
+              Position* pos = new Position(rp->lat, rp->lon);
+              // Set parent to maintain route structure.
+              pos->parent = validatedSegment.back();
+              pos->polar = rp->polar;
+              pos->tacks = rp->tacks;
+              pos->jibes = rp->jibes;
+              pos->sail_plan_changes = rp->sail_plan_changes;
+              pos->data_mask = rp->data_mask;
+              // Add to our list for later cleanup.
+              AddNewPosition(pos);
+              validatedSegment.push_back(pos);
+            }
+
+            // Clean up RoutePoint since we converted it to Position.
+            delete rp;
+          }
+        } else {
+          // If rhumb line propagation failed, fall back to direct connection.
+          wxLogGeneric(
+              wxLOG_Debug,
+              "RouteSimplifier: Rhumb line propagation failed, using direct "
+              "connection");
+          validatedSegment.push_back(end);
+        }
+      } else {
+        // For shorter segments, just add the endpoint directly.
+        validatedSegment.push_back(end);
+      }
+
+      // Move to next segment.
+      it = next;
+      ++next;
+    }
+
+    // Replace simplified segment with validated segment if it's reasonable.
+    if (!validatedSegment.empty() &&
+        validatedSegment.size() <= segment.points.size() * 0.8) {
+      wxLogGeneric(
+          wxLOG_Debug,
+          "RouteSimplifier: Using validated segment with %zu points (vs "
+          "original %zu)",
+          validatedSegment.size(), segment.points.size());
+      simplifiedSegment = validatedSegment;
+    }
+  }
+
+  return simplifiedSegment;
+}
+
 std::list<Position*> RouteSimplifier::BuildValidatedRoute(
     const std::list<Position*>& candidateRoute) {
   std::list<Position*> validatedRoute;
@@ -518,8 +593,78 @@ std::list<Position*> RouteSimplifier::BuildValidatedRoute(
   return validatedRoute;
 }
 
+bool RouteSimplifier::SegmentKey::operator<(const SegmentKey& other) const {
+  return std::tie(start, end, time) <
+         std::tie(other.start, other.end, other.time);
+}
+
+RouteSimplifier::SegmentKey RouteSimplifier::MakeSegmentKey(
+    const Position* start, const Position* end) const {
+  SegmentKey key;
+  key.start = start;
+  key.end = end;
+  key.time = m_configuration.time.IsValid() ? m_configuration.time.GetValue()
+                                            : wxLongLong(0);
+  return key;
+}
+
+void RouteSimplifier::AddNewPosition(Position* pos) {
+  wxMutexLocker lock(m_mutex);
+  m_newPositions.push_back(pos);
+}
+
+void RouteSimplifier::ParallelFor(size_t count, int threads,
+                                  const std::function<void(size_t)>& body) {
+  std::atomic<size_t> next(0);
+  if (threads <= 0) threads = wxThread::GetCPUCount();
+  size_t used = std::min(count, static_cast<size_t>(std::max(threads, 1)));
+
+  std::vector<SimplifierThread*> workers;
+  for (size_t i = 1; i < used; i++) {
+    SimplifierThread* thread = new SimplifierThread(next, count, body);
+    if (thread->Run() != wxTHREAD_NO_ERROR) {
+      delete thread;
+      break;
+    }
+    workers.push_back(thread);
+  }
+
+  // The calling thread takes its share of the iterations too.
+  RunIterations(next, count, body);
+
+  for (SimplifierThread* thread : workers) {
+    thread->Wait();
+    delete thread;
+  }
+}
+
 bool RouteSimplifier::ValidateSegment(Position* start, Position* end,
                                       Position*& validatedEnd) {
+  SegmentKey key = MakeSegmentKey(start, end);
+  {
+    wxMutexLocker lock(m_mutex);
+    auto found = m_segmentValidations.find(key);
+    if (found != m_segmentValidations.end()) {
+      m_memoHits++;
+      validatedEnd = found->second.validatedEnd;
+      return found->second.valid;
+    }
+  }
+
+  // Validate outside the lock, at worst two threads validate it both.
+  Position* checkedEnd = nullptr;
+  bool valid = CheckSegment(start, end, checkedEnd);
+  {
+    wxMutexLocker lock(m_mutex);
+    m_segmentValidations[key] = SegmentValidation{valid, checkedEnd};
+    m_memoMisses++;
+  }
+  validatedEnd = checkedEnd;
+  return valid;
+}
+
+bool RouteSimplifier::CheckSegment(Position* start, Position* end,
+                                   Position*& validatedEnd) {
   // First check segment distance - if it's too long, it likely needs
   // intermediate points
   double distance =
@@ -620,7 +765,7 @@ bool RouteSimplifier::ValidateSegmentWithDetailedPropagation(
           bestPosition->parent_heading, bestPosition->parent_bearing,
           bestPosition->polar, bestPosition->tacks, bestPosition->jibes,
           bestPosition->sail_plan_changes, bestPosition->data_mask);
-      m_newPositions.push_back(validatedEnd);
+      AddNewPosition(validatedEnd);
       return true;
     }
   }
@@ -906,30 +1051,9 @@ wxTimeSpan RouteSimplifier::FindPositionTime(
     return wxTimeSpan(-1);
   }
 
-  // Search through each isochrone to find the one containing our position
-  for (const IsoChron* isochron : isochrones) {
-    if (!isochron) continue;
-
-    // Check each route within this isochrone
-    for (IsoRoute* route : isochron->routes) {
-      if (!route || !route->skippoints) continue;
-
-      // Check each position in this route
-      SkipPosition* skippos = route->skippoints;
-      do {
-        if (skippos->point == position) {
-          // Found the position! Return the time difference from start
-          wxTimeSpan timeFromStart = isochron->time - startTime;
-          wxLogGeneric(wxLOG_Debug,
-                       "RouteSimplifier: Found position at time %s (offset %s)",
-                       isochron->time.Format("%H:%M:%S"),
-                       timeFromStart.Format("%D days %H:%M:%S"));
-          return timeFromStart;
-        }
-        skippos = skippos->next;
-      } while (skippos != route->skippoints);
-    }
-  }
+  // Look up the isochrone the position was propagated in
+  auto found = m_positionTimes.find(position);
+  if (found != m_positionTimes.end()) return found->second;
 
   // If not found by pointer, try geometric containment check
   // This handles destination positions that are interpolated within isochrone
@@ -1006,57 +1130,45 @@ wxTimeSpan RouteSimplifier::FindPositionTimeByParentChain(
     parentChain.push_back(current);
 
     // Check if this position exists in any isochrone
-    for (const IsoChron* isochron : isochrones) {
-      if (!isochron) continue;
-
-      for (IsoRoute* route : isochron->routes) {
-        if (!route || !route->skippoints) continue;
-
-        SkipPosition* skippos = route->skippoints;
-        do {
-          if (skippos->point == current) {
-            // Found a parent position in the isochrones!
-            wxTimeSpan parentTime = isochron->time - startTime;
-
-            // If this is the position we're looking for, return its time
-            if (current == position) {
-              wxLogGeneric(
-                  wxLOG_Debug,
-                  "RouteSimplifier: Found position in parent chain at time %s",
-                  parentTime.Format("%D days %H:%M:%S"));
-              return parentTime;
-            }
+    auto found = m_positionTimes.find(current);
+    if (found != m_positionTimes.end()) {
+      // Found a parent position in the isochrones!
+      wxTimeSpan parentTime = found->second;
 
-            // Otherwise, estimate the time by using the average delta time
-            // from the parent to the target position
-            int stepsFromParent = parentChain.size() - 1;
-            if (stepsFromParent > 0 && isochrones.size() >= 2) {
-              // Calculate average delta time between isochrones
-              auto it1 = isochrones.begin();
-              auto it2 = std::next(it1);
-              wxTimeSpan avgDelta = (*it2)->time - (*it1)->time;
-
-              wxTimeSpan estimatedTime =
-                  parentTime + avgDelta * stepsFromParent;
-              wxLogGeneric(
-                  wxLOG_Debug,
-                  "RouteSimplifier: Estimated time for position: parent time "
-                  "%s + %d steps * %s = %s",
-                  parentTime.Format("%D days %H:%M:%S"), stepsFromParent,
-                  avgDelta.Format("%D days %H:%M:%S"),
-                  estimatedTime.Format("%D days %H:%M:%S"));
-              return estimatedTime;
-            }
+      // If this is the position we're looking for, return its time
+      if (current == position) {
+        wxLogGeneric(
+            wxLOG_Debug,
+            "RouteSimplifier: Found position in parent chain at time %s",
+            parentTime.Format("%D days %H:%M:%S"));
+        return parentTime;
+      }
 
-            // If we can't estimate, just return the parent time
-            wxLogGeneric(wxLOG_Debug,
-                         "RouteSimplifier: Using parent time %s for position",
-                         parentTime.Format("%D days %H:%M:%S"));
-            return parentTime;
-          }
-          skippos = skippos->next;
-        } while (skippos != route->skippoints);
+      // Otherwise, estimate the time by using the average delta time
+      // from the parent to the target position
+      int stepsFromParent = parentChain.size() - 1;
+      if (stepsFromParent > 0 && isochrones.size() >= 2) {
+        // Calculate average delta time between isochrones
+        auto it1 = isochrones.begin();
+        auto it2 = std::next(it1);
+        wxTimeSpan avgDelta = (*it2)->time - (*it1)->time;
+
+        wxTimeSpan estimatedTime = parentTime + avgDelta * stepsFromParent;
+        wxLogGeneric(
+            wxLOG_Debug,
+            "RouteSimplifier: Estimated time for position: parent time "
+            "%s + %d steps * %s = %s",
+            parentTime.Format("%D days %H:%M:%S"), stepsFromParent,
+            avgDelta.Format("%D days %H:%M:%S"),
+            estimatedTime.Format("%D days %H:%M:%S"));
+        return estimatedTime;
       }
+
+      // If we can't estimate, just return the parent time
+      wxLogGeneric(wxLOG_Debug,
+                   "RouteSimplifier: Using parent time %s for position",
+                   parentTime.Format("%D days %H:%M:%S"));
+      return parentTime;
     }
 
     current = current->parent;
@@ -1153,12 +1265,39 @@ RouteSimplifier::FindAlternateRoutesWithFewerManeuvers(
     return alternateRoutes;
   }
 
+  // The Pareto optimal endpoints do not depend on the maneuver durations,
+  // find them once for all the penalties below.
+  Position* dest = m_routemap->GetLastDestination();
+  if (!dest) {
+    return alternateRoutes;
+  }
+  std::vector<RouteCandidate> frontier =
+      FindParetoAlternates(params, isochrones);
+
+  auto addAlternate = [&](const RouteStats& alternate) {
+    // Check if it's sufficiently different from existing routes.
+    for (const RouteStats& existing : alternateRoutes) {
+      // Consider it a duplicate if it has the same number of maneuvers
+      // and similar duration.
+      if (alternate.totalManeuvers == existing.totalManeuvers &&
+          (alternate.totalDuration - existing.totalDuration)
+                  .Abs()
+                  .GetSeconds()
+                  .ToDouble() <
+              0.01 * existing.totalDuration.GetSeconds().ToDouble()) {
+        return;
+      }
+    }
+    alternateRoutes.push_back(alternate);
+  };
+
   // Define a series of increasing maneuver durations to try.
   // These are the penalties we will apply to tacking, jibing, and sail
   // changes.
   std::vector<double> maneuverDurations = {10.0, 30.0, 60.0, 120.0, 240.0};
 
-  // For each penalty factor, revisit isochrones to find an alternate route.
+  // For each penalty factor, pick the endpoint of the frontier which is the
+  // fastest once the maneuvers are charged.
   for (double maneuverDuration : maneuverDurations) {
     if (alternateRoutes.size() >= maxRoutes) break;
 
@@ -1175,58 +1314,36 @@ RouteSimplifier::FindAlternateRoutesWithFewerManeuvers(
         "%.1f seconds",
         maneuverDuration);
 
-    // Look for alternate routes in the existing isochrones to the last
-    // destination (either the exact destination or the closest to the
-    // destination). We don't want to recompute isochrones (expensive), we
-    // analyze the ones we already have but pretend the maneuver penalties were
-    // higher.
-    if (!isochrones.empty()) {
-      Position* dest = m_routemap->GetLastDestination();
-      if (!dest) {
-        continue;
-      }
-      // Find alternate paths through existing isochrones.
-      RouteStats alternate;
-      bool found = FindAlternatePathThroughIsochrones(
-          params, isochrones, routeConfig, dest, alternate);
+    // We don't want to recompute isochrones (expensive), we analyze the ones
+    // we already have but pretend the maneuver penalties were higher.
+    RouteStats alternate;
+    bool found =
+        FindAlternatePathThroughIsochrones(frontier, routeConfig, alternate);
 
-      if (!found || alternate.totalManeuvers >= originalRoute.totalManeuvers) {
-        wxLogGeneric(
-            wxLOG_Debug,
-            "RouteSimplifier: maneuver time %.1f. Found: %d, Maneuvers: %d, "
-            "Original: %d",
-            maneuverDuration, found, alternate.totalManeuvers,
-            originalRoute.totalManeuvers);
-        continue;
-      }
-      wxLogGeneric(wxLOG_Debug,
-                   "RouteSimplifier: Found alternate route: "
-                   "%d tacks, %d jibes, %d sail changes, delta: %s",
-                   alternate.totalManeuvers, alternate.totalTacks,
-                   alternate.totalJibes, alternate.totalSailChanges,
-                   (alternate.totalDuration - originalRoute.totalDuration)
-                       .Format("%D days %H:%M:%S"));
-
-      // Check if it's sufficiently different from existing routes.
-      bool isDuplicate = false;
-      for (const RouteStats& existing : alternateRoutes) {
-        // Consider it a duplicate if it has the same number of maneuvers
-        // and similar duration.
-        if (alternate.totalManeuvers == existing.totalManeuvers &&
-            (alternate.totalDuration - existing.totalDuration)
-                    .Abs()
-                    .GetSeconds()
-                    .ToDouble() <
-                0.01 * existing.totalDuration.GetSeconds().ToDouble()) {
-          isDuplicate = true;
-          break;
-        }
-      }
-
-      if (!isDuplicate) {
-        alternateRoutes.push_back(alternate);
-      }
+    if (!found || alternate.totalManeuvers >= originalRoute.totalManeuvers) {
+      wxLogGeneric(
+          wxLOG_Debug,
+          "RouteSimplifier: maneuver time %.1f. Found: %d, Maneuvers: %d, "
+          "Original: %d",
+          maneuverDuration, found, alternate.totalManeuvers,
+          originalRoute.totalManeuvers);
+      continue;
     }
+    wxLogGeneric(wxLOG_Debug,
+                 "RouteSimplifier: Found alternate route: "
+                 "%d tacks, %d jibes, %d sail changes, delta: %s",
+                 alternate.totalTacks, alternate.totalJibes,
+                 alternate.totalSailChanges,
+                 (alternate.totalDuration - originalRoute.totalDuration)
+                     .Format("%D days %H:%M:%S"));
+    addAlternate(alternate);
+  }
+
+  // The last point of the frontier has the fewest maneuvers within the
+  // duration penalty, whatever a maneuver costs.
+  if (!frontier.empty() && alternateRoutes.size() < maxRoutes &&
+      frontier.back().Maneuvers() < originalRoute.totalManeuvers) {
+    addAlternate(BuildAlternateRoute(frontier.back()));
   }
 
   // Sort the alternate routes by increasing time
@@ -1240,13 +1357,10 @@ RouteSimplifier::FindAlternateRoutesWithFewerManeuvers(
   return alternateRoutes;
 }
 
-bool RouteSimplifier::FindAlternatePathThroughIsochrones(
-    const SimplificationParams& params, const IsoChronList& isochrones,
-    const RouteMapConfiguration& config, Position* destination,
-    RouteStats& result) {
-  if (isochrones.empty() || !destination) {
-    return false;
-  }
+std::vector<RouteSimplifier::RouteCandidate>
+RouteSimplifier::FindParetoAlternates(const SimplificationParams& params,
+                                      const IsoChronList& isochrones) {
+  std::vector<RouteCandidate> frontier;
 
   // Get the original route's destination coordinates.
   Position* originalDestination = nullptr;
@@ -1254,125 +1368,175 @@ bool RouteSimplifier::FindAlternatePathThroughIsochrones(
     originalDestination = m_originalRoute.back();
   }
 
-  if (!originalDestination) {
-    return false;
+  if (isochrones.empty() || !isochrones.back() || !originalDestination) {
+    return frontier;
   }
 
-  // Get the original route duration for comparison.
-  wxTimeSpan originalRouteDuration = CalculateRouteDuration(m_originalRoute);
-  if (originalRouteDuration <= 0) {
-    return false;
+  // Collect the positions in the last isochrone near the destination.
+  std::vector<Position*> positions;
+  for (IsoRoute* route : isochrones.back()->routes) {
+    if (!route || !route->skippoints) continue;
+
+    Position* pos = route->skippoints->point;
+    do {
+      if (DistGreatCircle_Plugin(pos->lat, pos->lon, originalDestination->lat,
+                                 originalDestination->lon) <=
+          5.0) {  // 5 nautical miles threshold
+        positions.push_back(pos);
+      }
+      pos = pos->next;
+    } while (pos != route->skippoints->point);
   }
 
-  // Start with the final isochrone and examine all possible endpoints.
-  const IsoChron* lastIsochron = isochrones.back();
-  if (!lastIsochron) return false;
+  // The maneuver counts of a position are cumulative along its parents, and
+  // the time it was reached is indexed, so the cost of each endpoint is known
+  // without building its route. Only the final legs are sailed, in parallel.
+  std::vector<RouteCandidate> candidates(positions.size());
+  ParallelFor(positions.size(), params.threads, [&](size_t i) {
+    Position* pos = positions[i];
+    RouteCandidate& candidate = candidates[i];
+    candidate.pos = nullptr;
+
+    auto found = m_positionTimes.find(pos);
+    if (found == m_positionTimes.end()) return;
+
+    double seconds = 0;
+    if (DistGreatCircle_Plugin(pos->lat, pos->lon, originalDestination->lat,
+                               originalDestination->lon) > 0.1) {
+      seconds = PropagateToDestination(pos, originalDestination);
+      if (std::isnan(seconds) || std::isinf(seconds)) return;
+    }
 
-  // Track the best candidate found.
-  Position* bestCandidate = nullptr;
-  int fewestManeuvers = INT_MAX;
-  wxTimeSpan bestDuration = wxTimeSpan(-1);
+    candidate.pos = pos;
+    candidate.seconds = found->second.GetSeconds().ToDouble() + seconds;
+    candidate.tacks = pos->tacks;
+    candidate.jibes = pos->jibes;
+    candidate.sailChanges = pos->sail_plan_changes;
+  });
 
-  // Analyze all possible positions in the last isochrone.
-  for (IsoRoute* route : lastIsochron->routes) {
-    if (!route || !route->skippoints) continue;
+  candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                  [](const RouteCandidate& candidate) {
+                                    return !candidate.pos;
+                                  }),
+                   candidates.end());
+  if (candidates.empty()) return frontier;
 
-    SkipPosition* skippos = route->skippoints;
-    do {
-      Position* pos = skippos->point;
-      if (!pos) {
-        skippos = skippos->next;
-        continue;
-      }
+  // Get the original route duration for comparison.
+  double originalSeconds =
+      CalculateRouteDuration(m_originalRoute).GetSeconds().ToDouble();
+  if (originalSeconds <= 0) return frontier;
 
-      // If this position can reach the destination, consider it.
-      double distance =
-          DistGreatCircle_Plugin(pos->lat, pos->lon, originalDestination->lat,
-                                 originalDestination->lon);
+  size_t reached = candidates.size();
+  frontier = ParetoFrontier(std::move(candidates), originalSeconds,
+                            params.maxDurationPenaltyPercent);
 
-      // Skip positions too far from destination.
-      if (distance > 5.0) {  // 5 nautical miles threshold
-        skippos = skippos->next;
-        continue;
-      }
+  wxLogGeneric(wxLOG_Debug,
+               "RouteSimplifier: %zu of %zu endpoints reach the destination, "
+               "%zu are Pareto optimal",
+               reached, positions.size(), frontier.size());
+  return frontier;
+}
 
-      // Build the candidate route from this position.
-      std::list<Position*> candidateRoute = pos->BuildRoute();
-
-      // Add final connection to exact destination if needed.
-      if (distance > 0.1) {  // If not practically at the destination already.
-        // Try to validate the final segment.
-        RouteMapConfiguration tempConfig = config;
-        double heading;
-        DataMask data_mask = DataMask::NONE;
-        double time = pos->PropagateToPoint(
-            originalDestination->lat, originalDestination->lon, tempConfig,
-            heading, data_mask, true);
-
-        // Skip if we can't reach the destination
-        if (std::isnan(time) || std::isinf(time)) {
-          skippos = skippos->next;
-          continue;
-        }
+std::vector<RouteSimplifier::RouteCandidate> RouteSimplifier::ParetoFrontier(
+    std::vector<RouteCandidate> candidates, double originalSeconds,
+    double maxDurationPenaltyPercent) {
+  std::sort(candidates.begin(), candidates.end(),
+            [](const RouteCandidate& a, const RouteCandidate& b) {
+              if (a.seconds != b.seconds) return a.seconds < b.seconds;
+              return a.Maneuvers() < b.Maneuvers();
+            });
+  double maxSeconds = originalSeconds * (1 + maxDurationPenaltyPercent);
 
-        // Create a position at the destination with copied maneuver counts.
-        Position* finalPos =
-            new Position(originalDestination->lat, originalDestination->lon);
-        finalPos->parent = pos;
-        finalPos->tacks = pos->tacks;
-        finalPos->jibes = pos->jibes;
-        finalPos->sail_plan_changes = pos->sail_plan_changes;
-        m_newPositions.push_back(finalPos);
-        candidateRoute.push_back(finalPos);
-      }
+  // Sweep by arrival time, keeping each candidate with fewer maneuvers than
+  // all faster ones.
+  std::vector<RouteCandidate> frontier;
+  int fewestManeuvers = INT_MAX;
+  for (const RouteCandidate& candidate : candidates) {
+    if (candidate.seconds > maxSeconds) break;
+    if (candidate.Maneuvers() < fewestManeuvers) {
+      frontier.push_back(candidate);
+      fewestManeuvers = candidate.Maneuvers();
+    }
+  }
+  return frontier;
+}
 
-      // Count maneuvers and calculate duration.
-      int tacks = 0, jibes = 0, sailChanges = 0;
-      const Position* prevPos = nullptr;
-      for (const Position* p : candidateRoute) {
-        if (prevPos) {
-          if (p->tacks > prevPos->tacks) tacks++;
-          if (p->jibes > prevPos->jibes) jibes++;
-          if (p->sail_plan_changes > prevPos->sail_plan_changes) sailChanges++;
-        }
-        prevPos = p;
-      }
-      int totalManeuvers = tacks + jibes + sailChanges;
+bool RouteSimplifier::FindAlternatePathThroughIsochrones(
+    const std::vector<RouteCandidate>& frontier,
+    const RouteMapConfiguration& config, RouteStats& result) {
+  // Minimize the arrival time plus the maneuver penalties.
+  const RouteCandidate* best = nullptr;
+  double bestCost = INFINITY;
+  for (const RouteCandidate& candidate : frontier) {
+    double cost = candidate.seconds + config.TackingTime * candidate.tacks +
+                  config.JibingTime * candidate.jibes +
+                  config.SailPlanChangeTime * candidate.sailChanges;
+    if (cost < bestCost) {
+      best = &candidate;
+      bestCost = cost;
+    }
+  }
 
-      // Calculate route duration.
-      wxTimeSpan routeDuration = CalculateRouteDuration(candidateRoute);
-      if (routeDuration <= 0) {
-        continue;
-      }
-      double durationPenaltyPercent =
-          (routeDuration.GetSeconds().ToDouble() -
-           originalRouteDuration.GetSeconds().ToDouble()) /
-          originalRouteDuration.GetSeconds().ToDouble();
-
-      // Only consider if time penalty is acceptable.
-      if (durationPenaltyPercent <= params.maxDurationPenaltyPercent) {
-        // Update best candidate if this has fewer maneuvers or same but less
-        // time.
-        if (totalManeuvers < fewestManeuvers ||
-            (totalManeuvers == fewestManeuvers &&
-             routeDuration < bestDuration)) {
-          bestCandidate = pos;
-          fewestManeuvers = totalManeuvers;
-          bestDuration = routeDuration;
-
-          // Store these values for the result.
-          result.waypoints = candidateRoute;
-          result.totalDuration = routeDuration;
-          result.totalTacks = tacks;
-          result.totalJibes = jibes;
-          result.totalSailChanges = sailChanges;
-          result.totalManeuvers = totalManeuvers;
-        }
-      }
+  if (!best) return false;
+  result = BuildAlternateRoute(*best);
+  return true;
+}
 
-      skippos = skippos->next;
-    } while (skippos != route->skippoints);
+RouteSimplifier::RouteStats RouteSimplifier::BuildAlternateRoute(
+    const RouteCandidate& candidate) {
+  RouteStats stats;
+  Position* pos = candidate.pos;
+  Position* originalDestination = m_originalRoute.back();
+
+  // Build the candidate route from this position.
+  stats.waypoints = pos->BuildRoute();
+
+  // Add final connection to exact destination if needed.
+  if (DistGreatCircle_Plugin(pos->lat, pos->lon, originalDestination->lat,
+                             originalDestination->lon) > 0.1) {
+    // Create a position at the destination with copied maneuver counts.
+    Position* finalPos =
+        new Position(originalDestination->lat, originalDestination->lon);
+    finalPos->parent = pos;
+    finalPos->tacks = pos->tacks;
+    finalPos->jibes = pos->jibes;
+    finalPos->sail_plan_changes = pos->sail_plan_changes;
+    AddNewPosition(finalPos);
+    stats.waypoints.push_back(finalPos);
   }
 
-  return bestCandidate != nullptr;
+  stats.totalDuration =
+      wxTimeSpan::Seconds(static_cast<long>(std::lround(candidate.seconds)));
+  stats.totalTacks = candidate.tacks;
+  stats.totalJibes = candidate.jibes;
+  stats.totalSailChanges = candidate.sailChanges;
+  stats.totalManeuvers = candidate.Maneuvers();
+  return stats;
+}
+
+double RouteSimplifier::PropagateToDestination(Position* pos,
+                                               Position* destination) {
+  SegmentKey key = MakeSegmentKey(pos, destination);
+  {
+    wxMutexLocker lock(m_mutex);
+    auto found = m_destinationTimes.find(key);
+    if (found != m_destinationTimes.end()) {
+      m_memoHits++;
+      return found->second;
+    }
+  }
+
+  // The maneuver penalties do not change whether the destination can be
+  // reached from a position, so the alternate route searches share this.
+  RouteMapConfiguration tempConfig = m_configuration;
+  double heading;
+  DataMask data_mask = DataMask::NONE;
+  double time = pos->PropagateToPoint(destination->lat, destination->lon,
+                                      tempConfig, heading, data_mask, true);
+  {
+    wxMutexLocker lock(m_mutex);
+    m_destinationTimes[key] = time;
+    m_memoMisses++;
+  }
+  return time;
 }
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#include "RoutingProfile.h"
+
+void RoutingProfile::Clear() {
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    m_Seconds[i] = 0;
+    m_Calls[i] = 0;
+  }
+}
+
+void RoutingProfile::Add(const RoutingProfile& profile) {
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    m_Seconds[i] += profile.m_Seconds[i];
+    m_Calls[i] += profile.m_Calls[i];
+  }
+}
+
+const char* RoutingProfile::PhaseName(Phase phase) {
+  switch (phase) {
+    case PROPAGATE:
+      return "propagate";
+    case MERGE:
+      return "merge";
+    case WEATHER:
+      return "weather";
+    case POLAR:
+      return "polar";
+    case LAND:
+      return "land";
+    case BOUNDARY:
+      return "boundary";
+    case GRIB_WAIT:
+      return "grib_wait";
+    case CHECK_SWELL:
+      return "check_swell";
+    case CHECK_MAX_LATITUDE:
+      return "check_max_latitude";
+    case CHECK_MAX_TRUE_WIND:
+      return "check_max_true_wind";
+    case CHECK_MAX_APPARENT_WIND:
+      return "check_max_apparent_wind";
+    case CHECK_WIND_VS_CURRENT:
+      return "check_wind_vs_current";
+    case CHECK_MAX_COURSE_ANGLE:
+      return "check_max_course_angle";
+    case CHECK_MAX_DIVERTED_COURSE:
+      return "check_max_diverted_course";
+    case CHECK_CORRIDOR:
+      return "check_corridor";
+    case CHECK_HEURISTIC_BOUND:
+      return "check_heuristic_bound";
+    case CHECK_CYCLONE_TRACK:
+      return "check_cyclone_track";
+    default:
+      return "";
+  }
+}
+
+bool RoutingProfile::Timed(Phase phase) {
+  switch (phase) {
+    case CHECK_MAX_LATITUDE:
+    case CHECK_MAX_TRUE_WIND:
+    case CHECK_MAX_APPARENT_WIND:
+    case CHECK_WIND_VS_CURRENT:
+    case CHECK_MAX_COURSE_ANGLE:
+    case CHECK_MAX_DIVERTED_COURSE:
+    case CHECK_HEURISTIC_BOUND:
+      return false;
+    default:
+      return true;
+  }
+}
+
+wxString RoutingProfile::ToString() const {
+  wxString str;
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    Phase phase = Phase(i);
+    if (!m_Calls[i]) continue;
+    if (!str.empty()) str += ", ";
+    if (Timed(phase))
+      str += wxString::Format("%s %.3fs/%ld", PhaseName(phase), m_Seconds[i],
+                              m_Calls[i]);
+    else
+      str += wxString::Format("%s %ld", PhaseName(phase), m_Calls[i]);
+  }
+  return str;
+}
+
+void RoutingProfile::toJson(Json::Value& json) const {
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    Json::Value& value = json[PhaseName(Phase(i))];
+    if (Timed(Phase(i))) value["seconds"] = m_Seconds[i];
+    value["calls"] = Json::Int64(m_Calls[i]);
+  }
+}
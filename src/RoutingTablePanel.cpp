@@ -21,13 +21,16 @@
 #include <wx/filedlg.h>
 #include <wx/msgdlg.h>
 #include <wx/filename.h>
-#include <wx/textfile.h>
 #include <wx/grid.h>
 #include <wx/notebook.h>
 #include <wx/zipstrm.h>
 #include <wx/wfstream.h>
 
+#include <wx/thread.h>
+
 #include <list>
+#include <memory>
+#include <vector>
 #include <cfloat>
 
 #include "Utilities.h"
@@ -576,14 +579,532 @@ static wxColor GetTimeOfDayColor(const wxDateTime& dateTime, double lat,
   }
 }
 
+/*
+ * Grid table of the detailed weather table.
+ *
+ * Rather than storing a string and an attribute for every cell, the table
+ * keeps a copy of the route's plot data and formats a cell when the grid asks
+ * for it, so only the rows on screen are ever formatted. The time-of-day
+ * colors need the sun elevation at each point and are computed ahead by a
+ * background thread, or on demand for rows it has not reached yet.
+ */
+class RoutingTablePanel::WeatherTable : public wxGridTableBase {
+public:
+  WeatherTable()
+      : m_useLocalTime(false),
+        m_highlightedRow(-1),
+        m_colorThread(nullptr),
+        m_colLabels(COL_COUNT) {}
+  ~WeatherTable() { StopColorThread(); }
+
+  /**
+   * Replaces the rows of the table and notifies the grid of the new row
+   * count.
+   *
+   * @param plotData Plot data of the route, one row per point.
+   * @param configuration Configuration of the route, for the sail plans.
+   * @param routemap Route the plot data belongs to, for the comfort levels.
+   * @param useLocalTime Whether to show the ETA in local time.
+   */
+  void SetPlotData(const std::list<PlotData>& plotData,
+                   std::shared_ptr<const RouteMapConfiguration> configuration,
+                   const RouteMapOverlay& routemap, bool useLocalTime);
+
+  /** Gets the plot data of a row. */
+  const PlotData& GetPlotData(int row) const { return m_rows[row].data; }
+
+  /** Sets the row blended with the highlight color, -1 for none. */
+  void SetHighlightedRow(int row) { m_highlightedRow = row; }
+
+  int GetNumberRows() override { return m_rows.size(); }
+  int GetNumberCols() override { return COL_COUNT; }
+  bool IsEmptyCell(int row, int col) override {
+    return FormatCell(row, col, nullptr).empty();
+  }
+  wxString GetValue(int row, int col) override {
+    return FormatCell(row, col, nullptr);
+  }
+  void SetValue(int row, int col, const wxString& value) override {}
+  wxString GetColLabelValue(int col) override { return m_colLabels[col]; }
+  void SetColLabelValue(int col, const wxString& label) override {
+    m_colLabels[col] = label;
+  }
+  wxGridCellAttr* GetAttr(int row, int col,
+                          wxGridCellAttr::wxAttrKind kind) override;
+
+  /**
+   * Formats a cell of the table.
+   *
+   * @param row Grid row number.
+   * @param col Grid column number.
+   * @param bgColor If not null, set to the background color of the cell, or
+   * to an invalid color when the cell uses the default background.
+   * @return The text of the cell.
+   */
+  wxString FormatCell(int row, int col, wxColour* bgColor);
+
+private:
+  /** Computes the time-of-day colors of the rows in the background. */
+  class ColorThread : public wxThread {
+  public:
+    ColorThread(WeatherTable& table)
+        : wxThread(wxTHREAD_JOINABLE), m_table(table) {
+      Create();
+    }
+
+    void* Entry() override {
+      for (size_t row = 0; row < m_table.m_rows.size() && !TestDestroy();
+           row++)
+        m_table.GetRowTimeOfDayColor(row);
+      return 0;
+    }
+
+  private:
+    WeatherTable& m_table;
+  };
+
+  struct Row {
+    PlotData data;
+    double distance;  // Cumulative distance from the start in nm
+    int comfort;      // Sailing condition level
+  };
+
+  /** Marks a time-of-day color which has not been computed yet. */
+  static constexpr wxUint32 PENDING_COLOR = 0xFFFFFFFF;
+
+  wxColour GetRowTimeOfDayColor(int row);
+  void StopColorThread();
+
+  std::vector<Row> m_rows;
+  std::shared_ptr<const RouteMapConfiguration> m_configuration;
+  bool m_useLocalTime;
+  int m_highlightedRow;
+
+  // Time-of-day colors as RGB values, shared with the color thread
+  std::vector<wxUint32> m_timeOfDayColors;
+  wxMutex m_timeOfDayMutex;
+  ColorThread* m_colorThread;
+
+  std::vector<wxString> m_colLabels;
+};
+
+void RoutingTablePanel::WeatherTable::SetPlotData(
+    const std::list<PlotData>& plotData,
+    std::shared_ptr<const RouteMapConfiguration> configuration,
+    const RouteMapOverlay& routemap, bool useLocalTime) {
+  // The color thread reads the rows, stop it before replacing them
+  StopColorThread();
+
+  int oldRows = m_rows.size();
+  m_rows.clear();
+  m_rows.reserve(plotData.size());
+  double distance = 0;
+  for (const PlotData& data : plotData) {
+    if (!m_rows.empty()) {
+      const PlotData& prev = m_rows.back().data;
+      distance +=
+          DistGreatCircle_Plugin(prev.lat, prev.lon, data.lat, data.lon);
+    }
+    m_rows.push_back({data, distance, routemap.sailingConditionLevel(data)});
+  }
+
+  m_configuration = configuration;
+  m_useLocalTime = useLocalTime;
+  m_highlightedRow = -1;
+  m_timeOfDayColors.assign(m_rows.size(), PENDING_COLOR);
+
+  wxGrid* grid = GetView();
+  int rows = m_rows.size();
+  if (grid && rows < oldRows) {
+    wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_DELETED, rows,
+                           oldRows - rows);
+    grid->ProcessTableMessage(msg);
+  } else if (grid && rows > oldRows) {
+    wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                           rows - oldRows);
+    grid->ProcessTableMessage(msg);
+  }
+
+  if (m_rows.empty()) return;
+  m_colorThread = new ColorThread(*this);
+  if (m_colorThread->Run() != wxTHREAD_NO_ERROR) {
+    // The colors are still computed on demand
+    delete m_colorThread;
+    m_colorThread = nullptr;
+  }
+}
+
+void RoutingTablePanel::WeatherTable::StopColorThread() {
+  if (!m_colorThread) return;
+
+  m_colorThread->Delete();
+  delete m_colorThread;
+  m_colorThread = nullptr;
+}
+
+wxColour RoutingTablePanel::WeatherTable::GetRowTimeOfDayColor(int row) {
+  wxUint32 rgb;
+  {
+    wxMutexLocker lock(m_timeOfDayMutex);
+    rgb = m_timeOfDayColors[row];
+  }
+
+  if (rgb == PENDING_COLOR) {
+    // Both threads may compute the same row, the result is the same
+    const PlotData& data = m_rows[row].data;
+    rgb = GetTimeOfDayColor(data.time, data.lat, data.lon).GetRGB();
+    wxMutexLocker lock(m_timeOfDayMutex);
+    m_timeOfDayColors[row] = rgb;
+  }
+
+  wxColour color;
+  color.SetRGB(rgb);
+  return color;
+}
+
+wxGridCellAttr* RoutingTablePanel::WeatherTable::GetAttr(
+    int row, int col, wxGridCellAttr::wxAttrKind kind) {
+  if (row < 0 || row >= (int)m_rows.size() || col < 0 || col >= COL_COUNT)
+    return nullptr;
+
+  wxColour bgColor;
+  FormatCell(row, col, &bgColor);
+  wxGridCellAttr* attr = nullptr;
+  if (bgColor.IsOk()) {
+    attr = new wxGridCellAttr();
+    attr->SetTextColour(GetTextColorForBackground(bgColor));
+  }
+
+  if (row == m_highlightedRow) {
+    if (!bgColor.IsOk() && GetView())
+      bgColor = GetView()->GetDefaultCellBackgroundColour();
+    if (!attr) attr = new wxGridCellAttr();
+
+    // Blend a semi-transparent yellow highlight with the background
+    wxColour highlightColor(255, 255, 0, 128);
+    bgColor = wxColour((bgColor.Red() + highlightColor.Red()) / 2,
+                       (bgColor.Green() + highlightColor.Green()) / 2,
+                       (bgColor.Blue() + highlightColor.Blue()) / 2);
+  }
+
+  if (attr) attr->SetBackgroundColour(bgColor);
+  return attr;
+}
+
+wxString RoutingTablePanel::WeatherTable::FormatCell(int row, int col,
+                                                     wxColour* bgColor) {
+  if (bgColor) *bgColor = wxColour();
+  if (row < 0 || row >= (int)m_rows.size()) return wxEmptyString;
+
+  const PlotData& data = m_rows[row].data;
+  wxColour color;
+  wxString value;
+
+  switch (col) {
+    case COL_LEG_NUMBER:
+      value = wxString::Format("%d", row + 1);
+      if (bgColor) color = GetRowTimeOfDayColor(row);
+      break;
+
+    case COL_ETA: {
+      // ETA column - actual date/time of arrival at this point
+      // Check for API 1.20 which has toUsrDateTimeFormat_Plugin function
+#if OCPN_API_VERSION_MAJOR > 1 || \
+    (OCPN_API_VERSION_MAJOR == 1 && OCPN_API_VERSION_MINOR >= 20)
+      value = toUsrDateTimeFormat_Plugin(data.time);
+#else
+      // Fallback for earlier API versions - format time with proper timezone
+      // label
+      if (m_useLocalTime) {
+        value = data.time.FromUTC().Format("%Y-%m-%d %H:%M %Z");
+      } else {
+        value = data.time.Format("%Y-%m-%d %H:%M UTC");
+      }
+#endif
+      if (bgColor) color = GetRowTimeOfDayColor(row);
+      break;
+    }
+
+    case COL_ENROUTE:
+      if (row == 0) {
+        value = _("Start");
+      } else {
+        // Cumulative time from the start
+        wxTimeSpan totalDuration = data.time.Subtract(m_rows[0].data.time);
+        int days = totalDuration.GetDays();
+        if (days > 0) {
+          value = wxString::Format("%dd %02d:%02d", days,
+                                   totalDuration.GetHours() % 24,
+                                   totalDuration.GetMinutes() % 60);
+        } else {
+          value = wxString::Format("%02d:%02d", totalDuration.GetHours(),
+                                   totalDuration.GetMinutes() % 60);
+        }
+      }
+      if (bgColor) color = GetRowTimeOfDayColor(row);
+      break;
+
+    case COL_LEG_DISTANCE:
+      value = row == 0 ? wxString(_("0.0"))
+                       : FormatDistance(m_rows[row].distance);
+      break;
+
+    case COL_WIND_SOURCE:
+      if (data.data_mask == DataMask::NONE) break;
+      if (data.data_mask & DataMask::GRIB_WIND) {
+        value = _("GRIB");
+      } else if (data.data_mask & DataMask::CLIMATOLOGY_WIND) {
+        value = _("Climatology");
+      }
+      color = GetWindSourceColor(data.data_mask);
+      break;
+
+    case COL_CURRENT_SOURCE:
+      if (data.data_mask == DataMask::NONE) break;
+      if (data.data_mask & DataMask::GRIB_CURRENT) {
+        value = _("GRIB");
+      } else if (data.data_mask & DataMask::CLIMATOLOGY_CURRENT) {
+        value = _("Climatology");
+      }
+      color = GetCurrentSourceColor(data.data_mask);
+      break;
+
+    case COL_SOG:
+      if (!std::isnan(data.sog)) value = FormatSpeed(data.sog);
+      break;
+
+    case COL_COG:
+      if (!std::isnan(data.cog))
+        value = wxString::Format("%.0f\u00B0", positive_degrees(data.cog));
+      break;
+
+    case COL_STW:
+      if (std::isnan(data.stw)) break;
+      value = FormatSpeed(data.stw);
+      // Color-code the STW cell and add (M) when the vessel is motoring
+      if (data.data_mask & DataMask::MOTOR_USED) {
+        value += " (M)";
+        color = wxColour(173, 216, 230);  // Light blue for motor
+      }
+      break;
+
+    case COL_CTW:
+      if (!std::isnan(data.ctw))
+        value = wxString::Format("%.0f\u00B0", positive_degrees(data.ctw));
+      break;
+
+    case COL_HDG:
+      if (!std::isnan(data.hdg))
+        value = wxString::Format("%.0f\u00B0", positive_degrees(data.hdg));
+      break;
+
+    case COL_AWS:
+    case COL_AWA: {
+      if (std::isnan(data.stw) || std::isnan(data.twdOverWater) ||
+          std::isnan(data.twsOverWater))
+        break;
+      double apparentWindSpeed = Polar::VelocityApparentWind(
+          data.stw, data.twdOverWater - data.ctw, data.twsOverWater);
+      if (col == COL_AWS) {
+        // Color the AWS cell based on apparent wind speed
+        if (!std::isnan(apparentWindSpeed)) {
+          value = FormatSpeed(apparentWindSpeed);
+          color = GetWindSpeedColor(apparentWindSpeed);
+        }
+        break;
+      }
+      double apparentWindAngle = Polar::DirectionApparentWind(
+          apparentWindSpeed, data.stw, data.twdOverWater - data.ctw,
+          data.twsOverWater);
+      if (!std::isnan(apparentWindAngle)) {
+        // Color the AWA cell: green for starboard tack, red for port tack
+        bool isStarboardTack =
+            (apparentWindAngle > 0 && apparentWindAngle < 180);
+        value = wxString::Format("%.0f\u00B0", apparentWindAngle);
+        color = isStarboardTack ? wxColour(0, 255, 0) : wxColour(255, 0, 0);
+      }
+      break;
+    }
+
+    case COL_TWD:
+      if (!std::isnan(data.twdOverWater))
+        value = wxString::Format("%.0f\u00B0",
+                                 positive_degrees(data.twdOverWater));
+      break;
+
+    case COL_TWA:
+      // True wind angle relative to boat course
+      if (!std::isnan(data.twdOverWater) && !std::isnan(data.ctw)) {
+        double twa = heading_resolve(data.twdOverWater - data.ctw);
+        bool isStarboardTack = (twa > 0 && twa < 180);
+        if (twa > 180) twa = 360 - twa;
+
+        // Color the TWA cell: green for starboard tack, red for port tack
+        value = wxString::Format("%.0f\u00B0", twa);
+        color = isStarboardTack ? wxColour(0, 255, 0) : wxColour(255, 0, 0);
+      }
+      break;
+
+    case COL_TWS:
+      if (!std::isnan(data.twsOverWater)) {
+        value = FormatSpeed(data.twsOverWater);
+        color = GetWindSpeedColor(data.twsOverWater);
+      }
+      break;
+
+    case COL_SAIL_PLAN:
+      if (data.polar >= 0 &&
+          data.polar < (int)m_configuration->boat->Polars.size()) {
+        // Display the polar/sail plan name from the FileName field, just the
+        // filename without path and extension
+        value = wxFileNameFromPath(
+            m_configuration->boat->Polars[data.polar].FileName);
+        int pos = value.Find('.');
+        if (pos != wxNOT_FOUND) value = value.Left(pos);
+
+        // Light amber color to identify new sail plan changes (not
+        // cumulative)
+        if (row > 0 && m_rows[row - 1].data.polar != data.polar)
+          color = wxColour(255, 230, 160);
+      } else {
+        value = _("Unknown");
+      }
+      break;
+
+    case COL_WIND_GUST:
+      if (!std::isnan(data.VW_GUST)) {
+        value = FormatSpeed(data.VW_GUST);
+        color = GetWindSpeedColor(data.VW_GUST);
+      }
+      break;
+
+    case COL_CLOUD:
+      // Cloud cover (range 0-100%)
+      if (!std::isnan(data.cloud_cover)) {
+        value = wxString::Format("%.1f%%", data.cloud_cover);
+        color = GetCloudColor(data.cloud_cover);
+      }
+      break;
+
+    case COL_RAIN:
+      if (!std::isnan(data.rain_mm_per_hour)) {
+        value = wxString::Format("%.2f mm/h", data.rain_mm_per_hour);
+        color = GetPrecipitationColor(data.rain_mm_per_hour);
+      }
+      break;
+
+    case COL_AIR_TEMP:
+      if (!std::isnan(data.air_temp)) {
+        value = FormatTemperature(data.air_temp);
+        color = GetAirTempColor(data.air_temp - 273.15);
+      }
+      break;
+
+    case COL_SEA_TEMP:
+      if (!std::isnan(data.sea_surface_temp)) {
+        value = FormatTemperature(data.sea_surface_temp);
+        color = GetSeaTempColor(data.sea_surface_temp);
+      }
+      break;
+
+    case COL_REL_HUMIDITY:
+      // Relative humidity (range 0-100%)
+      if (!std::isnan(data.relative_humidity)) {
+        value = wxString::Format("%.2f%%", data.relative_humidity);
+        color = GetCloudColor(data.relative_humidity);
+      }
+      break;
+
+    case COL_AIR_PRESSURE:
+      // Air pressure with proper conversion from Pascals to hectoPascals
+      if (!std::isnan(data.air_pressure)) {
+        value = FormatPressure(data.air_pressure);
+        color = GetPressureColor(data.air_pressure / 100.0);
+      }
+      break;
+
+    case COL_CAPE:
+      if (!std::isnan(data.cape)) {
+        value = wxString::Format("%.2f J/kg", data.cape);
+        color = GetCAPEColor(data.cape);
+      }
+      break;
+
+    case COL_REFLECTIVITY:
+      if (!std::isnan(data.reflectivity)) {
+        value = wxString::Format("%.1f dBZ", data.reflectivity);
+        color = GetReflectivityColor(data.reflectivity);
+      }
+      break;
+
+    case COL_CURRENT_SPEED:
+      if (!std::isnan(data.currentSpeed) && data.currentSpeed > 0)
+        value = FormatSpeed(data.currentSpeed);
+      break;
+
+    case COL_CURRENT_DIR:
+      if (!std::isnan(data.currentSpeed) && data.currentSpeed > 0 &&
+          !std::isnan(data.currentDir))
+        value =
+            wxString::Format("%.0f\u00B0", positive_degrees(data.currentDir));
+      break;
+
+    case COL_CURRENT_ANGLE:
+      // Current angle relative to COG with color coding
+      if (!std::isnan(data.currentSpeed) && data.currentSpeed > 0 &&
+          !std::isnan(data.currentDir) && !std::isnan(data.cog)) {
+        double currentAngle = CalculateCurrentAngle(data.currentDir, data.cog);
+        value = wxString::Format("%.0f\u00B0", currentAngle);
+        color = GetCurrentEffectColor(currentAngle, data.currentSpeed);
+      }
+      break;
+
+    case COL_WAVE_HEIGHT:
+      // Significant wave height
+      if (!std::isnan(data.WVHT) && data.WVHT > 0) {
+        value = wxString::Format("%.1f m", data.WVHT);
+        color = GetWaveHeightColor(data.WVHT);
+      }
+      break;
+
+    case COL_WAVE_DIRECTION:
+      if (!std::isnan(data.WVDIR) && data.WVDIR >= 0)
+        value = wxString::Format("%.0f\u00B0", positive_degrees(data.WVDIR));
+      break;
+
+    case COL_WAVE_REL:
+      // Wave direction relative to boat heading with color coding
+      if (!std::isnan(data.WVREL)) {
+        double displayAngle = positive_degrees(data.WVREL);
+        value = wxString::Format("%.0f\u00B0", displayAngle);
+        color = GetWaveRelativeColor(displayAngle);
+      }
+      break;
+
+    case COL_WAVE_PERIOD:
+      if (!std::isnan(data.WVPER) && data.WVPER > 0)
+        value = wxString::Format("%.1f s", data.WVPER);
+      break;
+
+    case COL_COMFORT: {
+      int comfortLevel = m_rows[row].comfort;
+      value = RouteMapOverlay::sailingConditionText(comfortLevel);
+      color = RouteMapOverlay::sailingConditionColor(comfortLevel);
+      break;
+    }
+  }
+
+  if (bgColor) *bgColor = color;
+  return value;
+}
+
 RoutingTablePanel::RoutingTablePanel(wxWindow* parent,
                                      WeatherRouting& weatherRouting,
                                      RouteMapOverlay* routemap)
     : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize,
               wxBORDER_NONE),
       m_RouteMap(routemap),
-      m_WeatherRouting(weatherRouting),
-      m_highlightedRow(-1) {
+      m_WeatherRouting(weatherRouting) {
   // Set the panel background color immediately
   SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE));
 
@@ -601,10 +1122,12 @@ RoutingTablePanel::RoutingTablePanel(wxWindow* parent,
   m_tableTab = new wxPanel(m_notebook, wxID_ANY);
   wxBoxSizer* tableSizer = new wxBoxSizer(wxVERTICAL);
 
-  // Create the grid with the columns we need
+  // Create the grid with the columns we need, its cells are formatted on
+  // demand by the table
   m_gridWeatherTable =
       new wxGrid(m_tableTab, wxID_ANY, wxDefaultPosition, wxDefaultSize);
-  m_gridWeatherTable->CreateGrid(0, COL_COUNT);
+  m_weatherTable = new WeatherTable();
+  m_gridWeatherTable->SetTable(m_weatherTable, true);
 
   // Set column labels
   m_gridWeatherTable->SetColLabelValue(COL_LEG_NUMBER, _("Leg #"));
@@ -644,9 +1167,7 @@ RoutingTablePanel::RoutingTablePanel(wxWindow* parent,
   m_gridWeatherTable->SetColLabelValue(COL_CURRENT_ANGLE, _("Curr Angle"));
 
   // Auto size all columns initially
-  for (int i = 0; i < COL_COUNT; i++) {
-    m_gridWeatherTable->AutoSizeColumn(i);
-  }
+  AutoSizeColumns();
 
   // Add components to sizer
   tableSizer->Add(m_gridWeatherTable, 1, wxEXPAND | wxALL, 5);
@@ -729,411 +1250,53 @@ void RoutingTablePanel::SetColorScheme(PI_ColorScheme cs) {
   Update();
 }
 
-// Helper function to set cell value with colored background
-void RoutingTablePanel::setCellWithColor(int row, int col,
-                                         const wxString& value,
-                                         const wxColor& bgColor) {
-  m_gridWeatherTable->SetCellValue(row, col, value);
-  wxGridCellAttr* attr = new wxGridCellAttr();
-  attr->SetBackgroundColour(bgColor);
-  attr->SetTextColour(GetTextColorForBackground(bgColor));
-  m_gridWeatherTable->SetAttr(row, col, attr);
-}
+void RoutingTablePanel::AutoSizeColumns() {
+  // Rows measured per column, spread evenly over the table
+  const int sampleRows = 64;
+  // Margin on both sides of the text, as wxGrid::AutoSizeColumn()
+  const int margin = 8;
 
-// Helper function to set cell value with time-of-day background color
-void RoutingTablePanel::setCellWithTimeOfDayColor(int row, int col,
-                                                  const wxString& value,
-                                                  const wxDateTime& dateTime,
-                                                  double lat, double lon) {
-  wxColor timeColor = GetTimeOfDayColor(dateTime, lat, lon);
-  setCellWithColor(row, col, value, timeColor);
-}
+  int rows = m_gridWeatherTable->GetNumberRows();
+  int step = wxMax(1, rows / sampleRows);
+  wxClientDC dc(m_gridWeatherTable->GetGridWindow());
 
-// Helper function to format and display sail plan information
-void RoutingTablePanel::handleSailPlanCell(
-    int row, const PlotData& data, const RouteMapConfiguration& configuration,
-    const PlotData* prevData) {
-  wxString sailPlanName;
-
-  if (data.polar >= 0 && data.polar < (int)configuration.boat.Polars.size()) {
-    // Display the polar/sail plan name from the FileName field
-    sailPlanName = configuration.boat.Polars[data.polar].FileName;
-    // Extract just the filename without path and extension
-    sailPlanName = wxFileNameFromPath(sailPlanName);
-    // Remove extension if present
-    int pos = sailPlanName.Find('.');
-    if (pos != wxNOT_FOUND) sailPlanName = sailPlanName.Left(pos);
-
-    // Apply coloring to identify new sail plan changes (not cumulative)
-    if (prevData && prevData->polar != data.polar) {
-      // Light amber color for sail changes
-      setCellWithColor(row, COL_SAIL_PLAN, sailPlanName,
-                       wxColour(255, 230, 160));
-    } else {
-      m_gridWeatherTable->SetCellValue(row, COL_SAIL_PLAN, sailPlanName);
-    }
-  } else {
-    m_gridWeatherTable->SetCellValue(row, COL_SAIL_PLAN, _("Unknown"));
-  }
+  m_gridWeatherTable->BeginBatch();
+  for (int col = 0; col < COL_COUNT; col++) {
+    dc.SetFont(m_gridWeatherTable->GetLabelFont());
+    int width =
+        dc.GetTextExtent(m_gridWeatherTable->GetColLabelValue(col)).GetWidth();
+
+    dc.SetFont(m_gridWeatherTable->GetDefaultCellFont());
+    auto measure = [&](int row) {
+      wxString value = m_gridWeatherTable->GetCellValue(row, col);
+      width = wxMax(width, dc.GetTextExtent(value).GetWidth());
+    };
+    for (int row = 0; row < rows; row += step) measure(row);
+    // The last row has the widest leg number and distance
+    if (rows > 0) measure(rows - 1);
+    m_gridWeatherTable->SetColSize(col, width + 2 * margin);
+  }
+  m_gridWeatherTable->EndBatch();
 }
 
 void RoutingTablePanel::PopulateTable() {
-  // Get plot data from the route
-  std::list<PlotData> plotData = m_RouteMap->GetPlotData(false);
-  // Clear existing grid content and set new size
-  if (m_gridWeatherTable->GetNumberRows() > 0)
-    m_gridWeatherTable->DeleteRows(0, m_gridWeatherTable->GetNumberRows());
-
-  m_gridWeatherTable->AppendRows(plotData.size());
-
-  // Hide the row labels (leftmost column with numbers)
-  m_gridWeatherTable->SetRowLabelSize(0);
-
-  // Get configuration for formatting
-  RouteMapConfiguration configuration = m_RouteMap->GetConfiguration();
+  // Get plot data from the route, the table keeps a copy and formats the
+  // cells from it when they are drawn
+  std::list<PlotData>& plotData = m_RouteMap->GetPlotData(false);
   bool useLocalTime =
       m_WeatherRouting.m_SettingsDialog.m_cbUseLocalTime->GetValue();
+  m_weatherTable->SetPlotData(plotData, m_RouteMap->GetConfigurationSnapshot(),
+                              *m_RouteMap, useLocalTime);
 
-  // Fill the grid with data
-  int row = 0;
-  wxDateTime startTime;  // Starting time for cumulative duration
-  wxDateTime prevTime;   // Previous point's time for leg duration calculation
-  PlotData prevData;     // For calculating leg distances
-  bool firstPoint = true;
-  double cumulativeDistance = 0.0;  // Track total distance
-
-  for (const PlotData& data : plotData) {
-    // Populate the leg number column with time-of-day background color
-    setCellWithTimeOfDayColor(row, COL_LEG_NUMBER,
-                              wxString::Format("%d", row + 1), data.time,
-                              data.lat, data.lon);
-
-    // ETA column - actual date/time of arrival at this point
-    // Check for API 1.20 which has toUsrDateTimeFormat_Plugin function
-    wxString timeString;
-#if OCPN_API_VERSION_MAJOR > 1 || \
-    (OCPN_API_VERSION_MAJOR == 1 && OCPN_API_VERSION_MINOR >= 20)
-    timeString = toUsrDateTimeFormat_Plugin(data.time);
-#else
-    // Fallback for earlier API versions - format time with proper timezone
-    // label
-    wxDateTime displayTime = data.time;
-    if (useLocalTime) {
-      displayTime = data.time.FromUTC();
-    }
-    if (useLocalTime) {
-      timeString = displayTime.Format("%Y-%m-%d %H:%M %Z");
-    } else {
-      timeString = displayTime.Format("%Y-%m-%d %H:%M UTC");
-    }
-#endif
-    // ETA column with time-of-day background color
-    setCellWithTimeOfDayColor(row, COL_ETA, timeString, data.time, data.lat,
-                              data.lon);
-
-    // Store the first point's time to calculate total time from start
-    if (firstPoint) {
-      startTime = data.time;
-      // Total Time column with time-of-day background color
-      setCellWithTimeOfDayColor(row, COL_ENROUTE, _("Start"), data.time,
-                                data.lat, data.lon);
-      m_gridWeatherTable->SetCellValue(row, COL_LEG_DISTANCE, _("0.0"));
-      firstPoint = false;
-    } else {
-      // Calculate leg distance between current and previous point
-      double legDistance = DistGreatCircle_Plugin(prevData.lat, prevData.lon,
-                                                  data.lat, data.lon);
-      cumulativeDistance += legDistance;  // Add to total distance
-
-      // Calculate cumulative time from start
-      wxTimeSpan totalDuration = data.time.Subtract(startTime);
-      int days = totalDuration.GetDays();
-      wxString totalDurationString;
-
-      if (days > 0) {
-        totalDurationString = wxString::Format("%dd %02d:%02d", days,
-                                               totalDuration.GetHours() % 24,
-                                               totalDuration.GetMinutes() % 60);
-      } else {
-        totalDurationString =
-            wxString::Format("%02d:%02d", totalDuration.GetHours(),
-                             totalDuration.GetMinutes() % 60);
-      }
-
-      // Set the cumulative duration in EnRoute column with time-of-day
-      // background color
-      setCellWithTimeOfDayColor(row, COL_ENROUTE, totalDurationString,
-                                data.time, data.lat, data.lon);
-
-      // Set the cumulative distance in Distance column using unit conversion
-      m_gridWeatherTable->SetCellValue(row, COL_LEG_DISTANCE,
-                                       FormatDistance(cumulativeDistance));
-    }
-
-    if (data.data_mask != DataMask::NONE) {
-      // Wind
-      wxString windSource;
-      if (data.data_mask & DataMask::GRIB_WIND) {
-        windSource = _("GRIB");
-      } else if (data.data_mask & DataMask::CLIMATOLOGY_WIND) {
-        windSource = _("Climatology");
-      } else {
-        windSource = wxEmptyString;
-      }
-      wxColor windSourceColor = GetWindSourceColor(data.data_mask);
-      setCellWithColor(row, COL_WIND_SOURCE, windSource, windSourceColor);
-      wxGridCellAttr* attr = new wxGridCellAttr();
-      attr->SetTextColour(GetTextColorForBackground(windSourceColor));
-      m_gridWeatherTable->SetAttr(row, COL_WIND_SOURCE, attr);
-
-      // Current
-      wxString currentSource;
-      if (data.data_mask & DataMask::GRIB_CURRENT) {
-        currentSource = _("GRIB");
-      } else if (data.data_mask & DataMask::CLIMATOLOGY_CURRENT) {
-        currentSource = _("Climatology");
-      } else {
-        currentSource = wxEmptyString;
-      }
-      wxColor currSourceColor = GetCurrentSourceColor(data.data_mask);
-      setCellWithColor(row, COL_CURRENT_SOURCE, currentSource, currSourceColor);
-      attr = new wxGridCellAttr();
-      attr->SetTextColour(GetTextColorForBackground(currSourceColor));
-      m_gridWeatherTable->SetAttr(row, COL_CURRENT_SOURCE, attr);
-    }
-
-    // Speeds and directions - check for NaN values
-    if (!std::isnan(data.sog)) {
-      m_gridWeatherTable->SetCellValue(row, COL_SOG, FormatSpeed(data.sog));
-    }
-
-    if (!std::isnan(data.cog)) {
-      m_gridWeatherTable->SetCellValue(
-          row, COL_COG,
-          wxString::Format("%.0f\u00B0", positive_degrees(data.cog)));
-    }
-
-    if (!std::isnan(data.stw)) {
-      // Check if vessel is motoring and color-code the STW cell accordingly
-      if (data.data_mask & DataMask::MOTOR_USED) {
-        // Use a distinct motor color (light blue) to indicate motoring
-        setCellWithColor(row, COL_STW, FormatSpeed(data.stw),
-                         wxColour(173, 216, 230));  // Light blue for motor
-
-        // Add visual indicator to make motoring more obvious
-        wxString motorValue =
-            FormatSpeed(data.stw) + " (M)";  // Add (M) for Motor
-        m_gridWeatherTable->SetCellValue(row, COL_STW, motorValue);
-
-        // Set cell attribute with background color (setCellWithColor already
-        // does this, but we need to override the value)
-        wxGridCellAttr* attr = new wxGridCellAttr();
-        attr->SetBackgroundColour(wxColour(173, 216, 230));
-        attr->SetTextColour(GetTextColorForBackground(wxColour(173, 216, 230)));
-        m_gridWeatherTable->SetAttr(row, COL_STW, attr);
-      } else {
-        // Standard STW display for sailing
-        m_gridWeatherTable->SetCellValue(row, COL_STW, FormatSpeed(data.stw));
-      }
-    }
-
-    if (!std::isnan(data.ctw)) {
-      m_gridWeatherTable->SetCellValue(
-          row, COL_CTW,
-          wxString::Format("%.0f\u00B0", positive_degrees(data.ctw)));
-    }
-
-    if (!std::isnan(data.hdg)) {
-      m_gridWeatherTable->SetCellValue(
-          row, COL_HDG,
-          wxString::Format("%.0f\u00B0", positive_degrees(data.hdg)));
-    }
-
-    // Wind data
-    if (!std::isnan(data.stw) && !std::isnan(data.twdOverWater) &&
-        !std::isnan(data.twsOverWater)) {
-      double apparentWindSpeed = Polar::VelocityApparentWind(
-          data.stw, data.twdOverWater - data.ctw, data.twsOverWater);
-      double apparentWindAngle = Polar::DirectionApparentWind(
-          apparentWindSpeed, data.stw, data.twdOverWater - data.ctw,
-          data.twsOverWater);
-      if (!std::isnan(apparentWindSpeed)) {
-        // Apply coloring to AWS cell based on apparent wind speed
-        wxColor awsColor = GetWindSpeedColor(apparentWindSpeed);
-        setCellWithColor(row, COL_AWS, FormatSpeed(apparentWindSpeed),
-                         awsColor);
-        wxGridCellAttr* attr = new wxGridCellAttr();
-        attr->SetTextColour(GetTextColorForBackground(awsColor));
-        m_gridWeatherTable->SetAttr(row, COL_AWS, attr);
-      }
-
-      if (!std::isnan(apparentWindAngle)) {
-        // Color the AWA cell: green for starboard tack, red for port tack
-        bool isStarboardTack =
-            (apparentWindAngle > 0 && apparentWindAngle < 180);
-        wxColor awaColor =
-            isStarboardTack ? wxColour(0, 255, 0) : wxColour(255, 0, 0);
-        setCellWithColor(row, COL_AWA,
-                         wxString::Format("%.0f\u00B0", apparentWindAngle),
-                         awaColor);
-      }
-    }
-
-    if (!std::isnan(data.twdOverWater)) {
-      m_gridWeatherTable->SetCellValue(
-          row, COL_TWD,
-          wxString::Format("%.0f\u00B0", positive_degrees(data.twdOverWater)));
-
-      // Calculate true wind angle relative to boat course
-      if (!std::isnan(data.ctw)) {
-        double twa = heading_resolve(data.twdOverWater - data.ctw);
-        bool isStarboardTack = (twa > 0 && twa < 180);
-        if (twa > 180) twa = 360 - twa;
-
-        // Color the TWA cell: green for starboard tack, red for port tack
-        wxColor twaColor =
-            isStarboardTack ? wxColour(0, 255, 0) : wxColour(255, 0, 0);
-
-        setCellWithColor(row, COL_TWA, wxString::Format("%.0f\u00B0", twa),
-                         twaColor);
-      }
-    }
-
-    // Set the TWS value and apply color based on wind speed
-    if (!std::isnan(data.twsOverWater)) {
-      setCellWithColor(row, COL_TWS, FormatSpeed(data.twsOverWater),
-                       GetWindSpeedColor(data.twsOverWater));
-    }
-
-    handleSailPlanCell(row, data, configuration, row > 0 ? &prevData : nullptr);
-
-    if (!std::isnan(data.VW_GUST)) {
-      setCellWithColor(row, COL_WIND_GUST, FormatSpeed(data.VW_GUST),
-                       GetWindSpeedColor(data.VW_GUST));
-    }
-
-    // Cloud cover (range 0-100%)
-    if (!std::isnan(data.cloud_cover)) {
-      setCellWithColor(row, COL_CLOUD,
-                       wxString::Format("%.1f%%", data.cloud_cover),
-                       GetCloudColor(data.cloud_cover));
-    }
-
-    // Rain (mm/h)
-    if (!std::isnan(data.rain_mm_per_hour)) {
-      setCellWithColor(row, COL_RAIN,
-                       wxString::Format("%.2f mm/h", data.rain_mm_per_hour),
-                       GetPrecipitationColor(data.rain_mm_per_hour));
-    }
-
-    // Air temperature
-    if (!std::isnan(data.air_temp)) {
-      setCellWithColor(row, COL_AIR_TEMP, FormatTemperature(data.air_temp),
-                       GetAirTempColor(data.air_temp - 273.15));
-    }
-
-    // Sea temperature
-    if (!std::isnan(data.sea_surface_temp)) {
-      setCellWithColor(row, COL_SEA_TEMP,
-                       FormatTemperature(data.sea_surface_temp),
-                       GetSeaTempColor(data.sea_surface_temp));
-    }
-
-    // Relative humidity (range 0-100%)
-    if (!std::isnan(data.relative_humidity)) {
-      setCellWithColor(row, COL_REL_HUMIDITY,
-                       wxString::Format("%.2f%%", data.relative_humidity),
-                       GetCloudColor(data.relative_humidity));
-    }
-
-    // Air pressure with proper conversion from Pascals to hectoPascals
-    if (!std::isnan(data.air_pressure)) {
-      double hPa = data.air_pressure / 100.0;  // Convert from Pa to hPa
-      setCellWithColor(row, COL_AIR_PRESSURE, FormatPressure(data.air_pressure),
-                       GetPressureColor(hPa));
-    }
-
-    // CAPE
-    if (!std::isnan(data.cape)) {
-      setCellWithColor(row, COL_CAPE, wxString::Format("%.2f J/kg", data.cape),
-                       GetCAPEColor(data.cape));
-    }
-
-    // Reflectivity
-    if (!std::isnan(data.reflectivity)) {
-      setCellWithColor(row, COL_REFLECTIVITY,
-                       wxString::Format("%.1f dBZ", data.reflectivity),
-                       GetReflectivityColor(data.reflectivity));
-    }
-
-    // Current data
-    if (!std::isnan(data.currentSpeed) && data.currentSpeed > 0) {
-      m_gridWeatherTable->SetCellValue(row, COL_CURRENT_SPEED,
-                                       FormatSpeed(data.currentSpeed));
-
-      if (!std::isnan(data.currentDir)) {
-        m_gridWeatherTable->SetCellValue(
-            row, COL_CURRENT_DIR,
-            wxString::Format("%.0f\u00B0", positive_degrees(data.currentDir)));
-
-        // Calculate current angle relative to COG if COG is available
-        if (!std::isnan(data.cog)) {
-          double currentAngle =
-              CalculateCurrentAngle(data.currentDir, data.cog);
-
-          // Display current angle with color coding
-          wxString currentAngleStr =
-              wxString::Format("%.0f\u00B0", currentAngle);
-          wxColor effectColor =
-              GetCurrentEffectColor(currentAngle, data.currentSpeed);
-          setCellWithColor(row, COL_CURRENT_ANGLE, currentAngleStr,
-                           effectColor);
-        }
-      }
-    }
-
-    // Significant wave height
-    if (!std::isnan(data.WVHT) && data.WVHT > 0) {
-      setCellWithColor(row, COL_WAVE_HEIGHT,
-                       wxString::Format("%.1f m", data.WVHT),
-                       GetWaveHeightColor(data.WVHT));
-    }
-    if (!std::isnan(data.WVDIR) && data.WVDIR >= 0) {
-      m_gridWeatherTable->SetCellValue(
-          row, COL_WAVE_DIRECTION,
-          wxString::Format("%.0f\u00B0", positive_degrees(data.WVDIR)));
-    }
-    if (!std::isnan(data.WVREL)) {
-      // Display wave direction relative to boat heading with color coding
-      double displayAngle = positive_degrees(data.WVREL);
-      setCellWithColor(row, COL_WAVE_REL,
-                       wxString::Format("%.0f\u00B0", displayAngle),
-                       GetWaveRelativeColor(displayAngle));
-    }
-    if (!std::isnan(data.WVPER) && data.WVPER > 0) {
-      m_gridWeatherTable->SetCellValue(row, COL_WAVE_PERIOD,
-                                       wxString::Format("%.1f s", data.WVPER));
-    }
-
-    // Sailing comfort level
-    int comfortLevel = m_RouteMap->sailingConditionLevel(data);
-    wxString comfortText = m_RouteMap->sailingConditionText(comfortLevel);
-    setCellWithColor(row, COL_COMFORT, comfortText,
-                     m_RouteMap->sailingConditionColor(comfortLevel));
-
-    // Store current data as previous for the next iteration
-    prevData = data;
-    prevTime = data.time;
-    row++;
-  }
+  // Hide the row labels (leftmost column with numbers)
+  m_gridWeatherTable->SetRowLabelSize(0);
+  m_gridWeatherTable->ForceRefresh();
 
   // Auto-size all columns for better display
-  for (int i = 0; i < COL_COUNT; i++) {
-    m_gridWeatherTable->AutoSizeColumn(i);
-  }
+  AutoSizeColumns();
 
-  // Reset highlight state
-  m_highlightedRow = -1;
+  // Reset highlight state, the new rows are not highlighted yet
+  m_lastTimelineTime = wxDateTime();
 
   // Apply highlight if timeline time is valid
   wxDateTime timelineTime =
@@ -1158,41 +1321,19 @@ void RoutingTablePanel::UpdateTimeHighlight(wxDateTime timelineTime) {
 
   m_lastTimelineTime = timelineTime;
 
-  // Get plot data from the route
-  std::list<PlotData> plotData = m_RouteMap->GetPlotData(false);
-  if (plotData.empty()) {
+  int rows = m_weatherTable->GetNumberRows();
+  if (rows == 0) {
     return;
   }
 
-  // First, restore the previous highlighted row to its original colors if
-  // needed
-  if (m_highlightedRow >= 0 &&
-      m_highlightedRow < m_gridWeatherTable->GetNumberRows()) {
-    // Check if we have stored colors for this row
-    if (m_originalCellColors.find(m_highlightedRow) !=
-        m_originalCellColors.end()) {
-      size_t numCols = static_cast<size_t>(m_gridWeatherTable->GetNumberCols());
-      for (size_t col = 0; col < numCols; col++) {
-        if (col < m_originalCellColors[m_highlightedRow].size()) {
-          // Restore the original color
-          m_gridWeatherTable->SetCellBackgroundColour(
-              m_highlightedRow, col,
-              m_originalCellColors[m_highlightedRow][col]);
-        }
-      }
-      // Remove the stored colors for this row as they've been restored
-      m_originalCellColors.erase(m_highlightedRow);
-    }
-  }
-
   // Find the row with ETA closest to the timeline time
   int closestRow = -1;
   wxTimeSpan minDifference;
 
-  int row = 0;
-  for (const PlotData& data : plotData) {
+  for (int row = 0; row < rows; row++) {
     // Calculate the time difference between ETA of this point and timeline time
-    wxTimeSpan difference = timelineTime - data.time;
+    wxTimeSpan difference =
+        timelineTime - m_weatherTable->GetPlotData(row).time;
     // Use absolute value for comparison
     difference = wxTimeSpan(difference.GetSeconds().Abs());
 
@@ -1201,41 +1342,13 @@ void RoutingTablePanel::UpdateTimeHighlight(wxDateTime timelineTime) {
       minDifference = difference;
       closestRow = row;
     }
-    row++;
   }
 
-  // If we found a closest row, highlight it
-  if (closestRow >= 0 && closestRow < m_gridWeatherTable->GetNumberRows()) {
-    m_highlightedRow = closestRow;
-
-    // Store the original colors before highlighting
-    m_originalCellColors[closestRow] = std::vector<wxColour>();
-    m_originalCellColors[closestRow].reserve(
-        m_gridWeatherTable->GetNumberCols());
+  // The table blends the highlight into the colors of the row when drawn
+  m_weatherTable->SetHighlightedRow(closestRow);
 
-    // Store the cast value outside the loop to avoid repeatedly calling it
-    size_t numCols = static_cast<size_t>(m_gridWeatherTable->GetNumberCols());
-    for (size_t col = 0; col < numCols; col++) {
-      // Store the original background color
-      wxColour originalBg =
-          m_gridWeatherTable->GetCellBackgroundColour(closestRow, col);
-      m_originalCellColors[closestRow].push_back(originalBg);
-
-      // Semi-transparent yellow highlight color
-      wxColour highlightColor(255, 255, 0, 128);
-
-      // Blend highlight with current background - simple 50% blend
-      wxColour blendedColor((originalBg.Red() + highlightColor.Red()) / 2,
-                            (originalBg.Green() + highlightColor.Green()) / 2,
-                            (originalBg.Blue() + highlightColor.Blue()) / 2);
-
-      m_gridWeatherTable->SetCellBackgroundColour(closestRow, col,
-                                                  blendedColor);
-    }
-
-    // Scroll to ensure the highlighted row is visible
-    m_gridWeatherTable->MakeCellVisible(closestRow, 0);
-  }
+  // Scroll to ensure the highlighted row is visible
+  m_gridWeatherTable->MakeCellVisible(closestRow, 0);
 
   // Refresh the grid to show the changes
   m_gridWeatherTable->Refresh();
@@ -1383,7 +1496,7 @@ RoutingTablePanel::SummaryData RoutingTablePanel::CalculateSummaryData() {
   SummaryData summary = {};
 
   // Get plot data from the route
-  std::list<PlotData> plotData = m_RouteMap->GetPlotData(false);
+  std::list<PlotData>& plotData = m_RouteMap->GetPlotData(false);
   if (plotData.empty()) {
     return summary;
   }
@@ -1648,7 +1761,8 @@ void RoutingTablePanel::UpdateSummary() {
 void RoutingTablePanel::ExportToExcel() {
   wxFileDialog saveFileDialog(
       this, _("Export table to Excel"), "", "routing_table.xlsx",
-      "Excel files (*.xlsx)|*.xlsx|Excel 97-2003 (*.xls)|*.xls",
+      "Excel files (*.xlsx)|*.xlsx|Excel 97-2003 (*.xls)|*.xls|"
+      "CSV files (*.csv)|*.csv",
       wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
 
   if (saveFileDialog.ShowModal() == wxID_CANCEL) {
@@ -1659,7 +1773,9 @@ void RoutingTablePanel::ExportToExcel() {
   wxString extension = wxFileName(filename).GetExt().Lower();
 
   bool success = false;
-  if (extension == "xlsx" || extension == "xls") {
+  if (extension == "csv") {
+    success = WriteCSV(filename);
+  } else if (extension == "xlsx" || extension == "xls") {
     success = WriteExcelXML(filename);
   } else {
     // Default to .xlsx if no extension specified
@@ -1698,21 +1814,16 @@ wxString RoutingTablePanel::EscapeXML(const wxString& text) {
   return escaped;
 }
 
-RoutingTablePanel::CellStyle RoutingTablePanel::GetCellStyle(int row, int col) {
-  CellStyle style;
-
-  if (row >= 0 && row < m_gridWeatherTable->GetNumberRows() && col >= 0 &&
-      col < m_gridWeatherTable->GetNumberCols()) {
-    // Use public methods to get cell attributes
-    style.bgColor = m_gridWeatherTable->GetCellBackgroundColour(row, col);
-    style.textColor = m_gridWeatherTable->GetCellTextColour(row, col);
-
-    // Get font information
-    wxFont cellFont = m_gridWeatherTable->GetCellFont(row, col);
-    style.isBold = cellFont.GetWeight() == wxFONTWEIGHT_BOLD;
+wxString RoutingTablePanel::GetExportCell(int row, int col, CellStyle& style) {
+  wxColour bgColor;
+  wxString value = m_weatherTable->FormatCell(row, col, &bgColor);
+  if (bgColor.IsOk()) {
+    style = CellStyle(bgColor, GetTextColorForBackground(bgColor));
+  } else {
+    style = CellStyle(m_gridWeatherTable->GetDefaultCellBackgroundColour(),
+                      m_gridWeatherTable->GetDefaultCellTextColour());
   }
-
-  return style;
+  return value;
 }
 
 int RoutingTablePanel::GetOrCreateStyleId(const CellStyle& style) {
@@ -1727,27 +1838,14 @@ int RoutingTablePanel::GetOrCreateStyleId(const CellStyle& style) {
   return styleId;
 }
 
-wxString RoutingTablePanel::CreateStylesXMLWithColors() {
-  // Clear and rebuild styles for this export
-  m_styles.clear();
-  m_styleMap.clear();
-
-  // Add default style
-  CellStyle defaultStyle(*wxWHITE, *wxBLACK, false);
-  GetOrCreateStyleId(defaultStyle);
-
-  // Add header style
-  CellStyle headerStyle(wxColour(211, 211, 211), *wxBLACK, true);
-  GetOrCreateStyleId(headerStyle);
-
-  // Scan all cells to build style collection
-  for (int row = 0; row < m_gridWeatherTable->GetNumberRows(); row++) {
-    for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-      CellStyle cellStyle = GetCellStyle(row, col);
-      GetOrCreateStyleId(cellStyle);
-    }
-  }
+// Helper function to write text to a stream as UTF-8
+static bool WriteUTF8(wxOutputStream& out, const wxString& text) {
+  wxCharBuffer buffer = text.ToUTF8();
+  out.Write(buffer.data(), buffer.length());
+  return out.IsOk();
+}
 
+bool RoutingTablePanel::WriteStylesXML(wxOutputStream& out) {
   wxString xml =
       "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
       "<styleSheet "
@@ -1805,10 +1903,10 @@ wxString RoutingTablePanel::CreateStylesXMLWithColors() {
   xml += "</cellXfs>\n";
 
   xml += "</styleSheet>";
-  return xml;
+  return WriteUTF8(out, xml);
 }
 
-wxString RoutingTablePanel::CreateWorksheetXMLWithColors() {
+bool RoutingTablePanel::WriteWorksheetXML(wxOutputStream& out) {
   wxString xml =
       "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
       "<worksheet "
@@ -1828,33 +1926,26 @@ wxString RoutingTablePanel::CreateWorksheetXMLWithColors() {
         cellRef, headerStyleId, header);
   }
   xml += "</row>\n";
+  if (!WriteUTF8(out, xml)) return false;
 
-  // Data rows
+  // Data rows, written one at a time so only a row is held in memory
   for (int row = 0; row < m_gridWeatherTable->GetNumberRows(); row++) {
-    xml += wxString::Format("<row r=\"%d\">\n", row + 2);
+    xml = wxString::Format("<row r=\"%d\">\n", row + 2);
     for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
       wxString cellRef = GetCellReference(row + 2, col + 1);
-      wxString value = EscapeXML(m_gridWeatherTable->GetCellValue(row, col));
-
-      // Get the style for this cell
-      CellStyle cellStyle = GetCellStyle(row, col);
+      CellStyle cellStyle;
+      wxString value = EscapeXML(GetExportCell(row, col, cellStyle));
       int styleId = GetOrCreateStyleId(cellStyle);
 
-      if (value.IsEmpty()) {
-        xml += wxString::Format(
-            "<c r=\"%s\" t=\"inlineStr\" s=\"%d\"><is><t></t></is></c>\n",
-            cellRef, styleId);
-      } else {
-        xml += wxString::Format(
-            "<c r=\"%s\" t=\"inlineStr\" s=\"%d\"><is><t>%s</t></is></c>\n",
-            cellRef, styleId, value);
-      }
+      xml += wxString::Format(
+          "<c r=\"%s\" t=\"inlineStr\" s=\"%d\"><is><t>%s</t></is></c>\n",
+          cellRef, styleId, value);
     }
     xml += "</row>\n";
+    if (!WriteUTF8(out, xml)) return false;
   }
 
-  xml += "</sheetData>\n</worksheet>";
-  return xml;
+  return WriteUTF8(out, "</sheetData>\n</worksheet>");
 }
 
 wxString RoutingTablePanel::GetCellReference(int row, int col) {
@@ -1964,113 +2055,45 @@ bool RoutingTablePanel::WriteXLSX(const wxString& filename) {
   zipStream.Write(buffer.data(), buffer.length());
   zipStream.CloseEntry();
 
-  // Create xl/styles.xml with colors
-  wxString styles = CreateStylesXMLWithColors();
-  zipStream.PutNextEntry("xl/styles.xml");
-  buffer = styles.ToUTF8();
-  zipStream.Write(buffer.data(), buffer.length());
-  zipStream.CloseEntry();
+  // Create xl/worksheets/sheet1.xml with actual data and colors. The
+  // styles used by the cells are collected while it is written, so
+  // xl/styles.xml follows it.
+  m_styles.clear();
+  m_styleMap.clear();
+  GetOrCreateStyleId(CellStyle(*wxWHITE, *wxBLACK, false));  // Default style
+  GetOrCreateStyleId(CellStyle(wxColour(211, 211, 211), *wxBLACK, true));
 
-  // Create xl/worksheets/sheet1.xml with actual data and colors
-  wxString worksheet = CreateWorksheetXMLWithColors();
   zipStream.PutNextEntry("xl/worksheets/sheet1.xml");
-  buffer = worksheet.ToUTF8();
-  zipStream.Write(buffer.data(), buffer.length());
+  bool written = WriteWorksheetXML(zipStream);
+  zipStream.CloseEntry();
+
+  zipStream.PutNextEntry("xl/styles.xml");
+  written = written && WriteStylesXML(zipStream);
   zipStream.CloseEntry();
 
   // Properly close the streams
-  bool success = zipStream.Close();
+  bool success = zipStream.Close() && written;
   fileStream.Close();
 
   return success;
 }
 
-wxString RoutingTablePanel::CreateStylesXML() {
-  return "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
-         "<styleSheet "
-         "xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/"
-         "main\">\n"
-         "<fonts count=\"2\">\n"
-         "<font><sz val=\"11\"/><name val=\"Calibri\"/></font>\n"
-         "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/></font>\n"
-         "</fonts>\n"
-         "<fills count=\"3\">\n"
-         "<fill><patternFill patternType=\"none\"/></fill>\n"
-         "<fill><patternFill patternType=\"gray125\"/></fill>\n"
-         "<fill><patternFill patternType=\"solid\"><fgColor "
-         "rgb=\"FFD3D3D3\"/></patternFill></fill>\n"
-         "</fills>\n"
-         "<borders count=\"2\">\n"
-         "<border><left/><right/><top/><bottom/><diagonal/></border>\n"
-         "<border><left style=\"thin\"/><right style=\"thin\"/><top "
-         "style=\"thin\"/><bottom style=\"thin\"/><diagonal/></border>\n"
-         "</borders>\n"
-         "<cellStyleXfs count=\"1\">\n"
-         "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/>\n"
-         "</cellStyleXfs>\n"
-         "<cellXfs count=\"2\">\n"
-         "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" "
-         "xfId=\"0\"/>\n"
-         "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"2\" borderId=\"1\" "
-         "xfId=\"0\"/>\n"
-         "</cellXfs>\n"
-         "</styleSheet>";
-}
-
-wxString RoutingTablePanel::CreateWorksheetXML() {
-  wxString xml =
-      "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
-      "<worksheet "
-      "xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">\n"
-      "<sheetData>\n";
-
-  // Header row with style
-  xml += "<row r=\"1\">\n";
-  for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-    wxString cellRef = GetCellReference(1, col + 1);
-    wxString header = EscapeXML(m_gridWeatherTable->GetColLabelValue(col));
-    xml += wxString::Format(
-        "<c r=\"%s\" t=\"inlineStr\" s=\"1\"><is><t>%s</t></is></c>\n", cellRef,
-        header);
-  }
-  xml += "</row>\n";
-
-  // Data rows
-  for (int row = 0; row < m_gridWeatherTable->GetNumberRows(); row++) {
-    xml += wxString::Format("<row r=\"%d\">\n", row + 2);
-    for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-      wxString cellRef = GetCellReference(row + 2, col + 1);
-      wxString value = EscapeXML(m_gridWeatherTable->GetCellValue(row, col));
-      if (value.IsEmpty()) {
-        xml += wxString::Format(
-            "<c r=\"%s\" t=\"inlineStr\"><is><t></t></is></c>\n", cellRef);
-      } else {
-        xml += wxString::Format(
-            "<c r=\"%s\" t=\"inlineStr\"><is><t>%s</t></is></c>\n", cellRef,
-            value);
-      }
-    }
-    xml += "</row>\n";
-  }
-
-  xml += "</sheetData>\n</worksheet>";
-  return xml;
-}
-
 bool RoutingTablePanel::WriteSimpleXML(const wxString& filename) {
-  wxTextFile file(filename);
-
-  if (file.Exists()) {
-    file.Open();
-    file.Clear();
-  } else {
-    file.Create();
+  wxFileOutputStream file(filename);
+  if (!file.IsOk()) {
+    return false;
   }
 
+  // Lines are streamed to the file rather than collected in memory
+  bool ok = true;
+  auto addLine = [&](const wxString& line) {
+    ok = ok && WriteUTF8(file, line + "\n");
+  };
+
   // Excel XML header - simplified
-  file.AddLine("<?xml version=\"1.0\"?>");
-  file.AddLine("<?mso-application progid=\"Excel.Sheet\"?>");
-  file.AddLine(
+  addLine("<?xml version=\"1.0\"?>");
+  addLine("<?mso-application progid=\"Excel.Sheet\"?>");
+  addLine(
       "<Workbook xmlns=\"urn:schemas-microsoft-com:office:spreadsheet\" "
       "xmlns:o=\"urn:schemas-microsoft-com:office:office\" "
       "xmlns:x=\"urn:schemas-microsoft-com:office:excel\" "
@@ -2078,22 +2101,30 @@ bool RoutingTablePanel::WriteSimpleXML(const wxString& filename) {
       "xmlns:html=\"http://www.w3.org/TR/REC-html40\">");
 
   // Document properties
-  file.AddLine(
+  addLine(
       "<DocumentProperties xmlns=\"urn:schemas-microsoft-com:office:office\">");
-  file.AddLine("<Title>Weather Routing Table</Title>");
-  file.AddLine("<Subject>OpenCPN Weather Routing Export</Subject>");
-  file.AddLine("<Created>" + wxDateTime::Now().FormatISOCombined() +
-               "</Created>");
-  file.AddLine("</DocumentProperties>");
+  addLine("<Title>Weather Routing Table</Title>");
+  addLine("<Subject>OpenCPN Weather Routing Export</Subject>");
+  addLine("<Created>" + wxDateTime::Now().FormatISOCombined() + "</Created>");
+  addLine("</DocumentProperties>");
 
-  // Build unique styles based on cell colors
-  std::map<wxString, int> styleMap;
-  std::vector<wxString> styleDefinitions;
-  int styleIndex = 0;
+  // The styles come before the worksheet in this format, so the cells are
+  // scanned once for their styles before the rows are written
+  m_styles.clear();
+  m_styleMap.clear();
+  for (int row = 0; row < m_gridWeatherTable->GetNumberRows(); row++) {
+    for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
+      CellStyle cellStyle;
+      GetExportCell(row, col, cellStyle);
+      GetOrCreateStyleId(cellStyle);
+    }
+  }
+
+  // Write styles section
+  addLine("<Styles>");
 
   // Default style
-  styleMap["default"] = styleIndex++;
-  styleDefinitions.push_back(
+  addLine(
       "<Style ss:ID=\"Default\" ss:Name=\"Normal\">"
       "<Alignment ss:Vertical=\"Bottom\"/>"
       "<Borders/>"
@@ -2103,8 +2134,7 @@ bool RoutingTablePanel::WriteSimpleXML(const wxString& filename) {
       "</Style>");
 
   // Header style
-  styleMap["header"] = styleIndex++;
-  styleDefinitions.push_back(
+  addLine(
       "<Style ss:ID=\"Header\">"
       "<Font ss:FontName=\"Calibri\" ss:Size=\"10\" ss:Color=\"#000000\" "
       "ss:Bold=\"1\"/>"
@@ -2121,39 +2151,23 @@ bool RoutingTablePanel::WriteSimpleXML(const wxString& filename) {
       "</Borders>"
       "</Style>");
 
-  // Scan all cells to create unique styles
-  for (int row = 0; row < m_gridWeatherTable->GetNumberRows(); row++) {
-    for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-      CellStyle cellStyle = GetCellStyle(row, col);
-      wxString bgHex = ConvertColorToHex(cellStyle.bgColor);
-      wxString textHex = ConvertColorToHex(cellStyle.textColor);
-      wxString styleKey = wxString::Format(
-          "%s_%s_%s", bgHex, textHex, cellStyle.isBold ? "bold" : "normal");
-
-      if (styleMap.find(styleKey) == styleMap.end()) {
-        styleMap[styleKey] = styleIndex++;
-        wxString styleId = wxString::Format("Style%d", styleMap[styleKey]);
-        wxString styleDef = wxString::Format(
-            "<Style ss:ID=\"%s\">"
-            "<Font ss:FontName=\"Calibri\" ss:Size=\"10\" ss:Color=\"%s\"%s/>"
-            "<Interior ss:Color=\"%s\" ss:Pattern=\"Solid\"/>"
-            "</Style>",
-            styleId, textHex, cellStyle.isBold ? " ss:Bold=\"1\"" : "", bgHex);
-        styleDefinitions.push_back(styleDef);
-      }
-    }
-  }
-
-  // Write styles section
-  file.AddLine("<Styles>");
-  for (const auto& styleDef : styleDefinitions) {
-    file.AddLine(styleDef);
-  }
-  file.AddLine("</Styles>");
+  // Unique styles based on cell colors
+  for (size_t i = 0; i < m_styles.size(); i++) {
+    const CellStyle& cellStyle = m_styles[i];
+    addLine(wxString::Format(
+        "<Style ss:ID=\"Style%d\">"
+        "<Font ss:FontName=\"Calibri\" ss:Size=\"10\" ss:Color=\"%s\"%s/>"
+        "<Interior ss:Color=\"%s\" ss:Pattern=\"Solid\"/>"
+        "</Style>",
+        (int)i, ConvertColorToHex(cellStyle.textColor),
+        cellStyle.isBold ? " ss:Bold=\"1\"" : "",
+        ConvertColorToHex(cellStyle.bgColor)));
+  }
+  addLine("</Styles>");
 
   // Worksheet
-  file.AddLine("<Worksheet ss:Name=\"Routing Table\">");
-  file.AddLine(wxString::Format(
+  addLine("<Worksheet ss:Name=\"Routing Table\">");
+  addLine(wxString::Format(
       "<Table ss:ExpandedColumnCount=\"%d\" ss:ExpandedRowCount=\"%d\" "
       "x:FullColumns=\"1\" x:FullRows=\"1\" ss:DefaultRowHeight=\"15\">",
       m_gridWeatherTable->GetNumberCols(),
@@ -2161,58 +2175,71 @@ bool RoutingTablePanel::WriteSimpleXML(const wxString& filename) {
 
   // Column definitions
   for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-    file.AddLine("<Column ss:AutoFitWidth=\"1\"/>");
+    addLine("<Column ss:AutoFitWidth=\"1\"/>");
   }
 
   // Header row
-  file.AddLine("<Row>");
+  addLine("<Row>");
   for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-    file.AddLine("<Cell ss:StyleID=\"Header\">");
-    file.AddLine("<Data ss:Type=\"String\">" +
-                 EscapeXML(m_gridWeatherTable->GetColLabelValue(col)) +
-                 "</Data>");
-    file.AddLine("</Cell>");
+    addLine("<Cell ss:StyleID=\"Header\">");
+    addLine("<Data ss:Type=\"String\">" +
+            EscapeXML(m_gridWeatherTable->GetColLabelValue(col)) + "</Data>");
+    addLine("</Cell>");
   }
-  file.AddLine("</Row>");
+  addLine("</Row>");
 
   // Data rows with colors
   for (int row = 0; row < m_gridWeatherTable->GetNumberRows(); row++) {
-    file.AddLine("<Row>");
+    addLine("<Row>");
     for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
-      // Get cell style and determine style ID
-      CellStyle cellStyle = GetCellStyle(row, col);
-      wxString bgHex = ConvertColorToHex(cellStyle.bgColor);
-      wxString textHex = ConvertColorToHex(cellStyle.textColor);
-      wxString styleKey = wxString::Format(
-          "%s_%s_%s", bgHex, textHex, cellStyle.isBold ? "bold" : "normal");
-
-      wxString styleRef = "Default";
-      auto it = styleMap.find(styleKey);
-      if (it != styleMap.end()) {
-        styleRef = wxString::Format("Style%d", it->second);
-      }
+      CellStyle cellStyle;
+      wxString value = GetExportCell(row, col, cellStyle);
+      addLine(wxString::Format("<Cell ss:StyleID=\"Style%d\">",
+                               GetOrCreateStyleId(cellStyle)));
+      addLine("<Data ss:Type=\"String\">" + EscapeXML(value) + "</Data>");
+      addLine("</Cell>");
+    }
+    addLine("</Row>");
+  }
 
-      file.AddLine(wxString::Format("<Cell ss:StyleID=\"%s\">", styleRef));
+  addLine("</Table>");
+  addLine("</Worksheet>");
+  addLine("</Workbook>");
 
-      // Add the data
-      wxString value = m_gridWeatherTable->GetCellValue(row, col);
-      if (value.IsEmpty()) {
-        file.AddLine("<Data ss:Type=\"String\"></Data>");
-      } else {
-        file.AddLine("<Data ss:Type=\"String\">" + EscapeXML(value) +
-                     "</Data>");
-      }
+  return file.Close() && ok;
+}
 
-      file.AddLine("</Cell>");
-    }
-    file.AddLine("</Row>");
+bool RoutingTablePanel::WriteCSV(const wxString& filename) {
+  wxFileOutputStream file(filename);
+  if (!file.IsOk()) {
+    return false;
   }
 
-  file.AddLine("</Table>");
-  file.AddLine("</Worksheet>");
-  file.AddLine("</Workbook>");
+  // Quote fields holding separators, quotes or line breaks (RFC 4180)
+  auto field = [](const wxString& text) {
+    if (text.find_first_of(",\"\r\n") == wxString::npos) return text;
+    wxString quoted = text;
+    quoted.Replace("\"", "\"\"");
+    return "\"" + quoted + "\"";
+  };
 
-  bool success = file.Write();
-  file.Close();
-  return success;
-}
\ No newline at end of file
+  // The byte order mark lets spreadsheets detect UTF-8, for the degree signs
+  wxString line = wxString::FromUTF8("\xEF\xBB\xBF");
+  for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
+    if (col > 0) line += ",";
+    line += field(m_gridWeatherTable->GetColLabelValue(col));
+  }
+  bool ok = WriteUTF8(file, line + "\r\n");
+
+  // Rows are written one at a time so only a row is held in memory
+  for (int row = 0; ok && row < m_gridWeatherTable->GetNumberRows(); row++) {
+    line.clear();
+    for (int col = 0; col < m_gridWeatherTable->GetNumberCols(); col++) {
+      if (col > 0) line += ",";
+      line += field(m_weatherTable->FormatCell(row, col, nullptr));
+    }
+    ok = WriteUTF8(file, line + "\r\n");
+  }
+
+  return file.Close() && ok;
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   Copyright (C) 2016 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+
+#include <wx/wx.h>
+#include <wx/file.h>
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "json/json.h"
+
+#include "RoutingTrace.h"
+
+std::atomic<bool> RoutingTrace::s_Recording(false);
+
+struct TraceSpan {
+  const char* name;
+  const char* category;
+  int thread;
+  RoutingTrace::TimePoint start, end;
+};
+
+static std::mutex s_trace_mutex;
+static std::vector<TraceSpan> s_trace_spans;
+static std::map<int, wxString> s_trace_threads;
+static RoutingTrace::TimePoint s_trace_start;
+
+/* small ids in the order the threads first record a span, which the trace
+   viewers show more readably than the system thread ids */
+static int TraceThread() {
+  static std::atomic<int> next(1);
+  thread_local int thread = 0;
+  if (!thread) {
+    thread = next++;
+    wxString name = wxThread::IsMain() ? wxString("main")
+                                       : wxString::Format("worker %d", thread);
+    std::lock_guard<std::mutex> lock(s_trace_mutex);
+    s_trace_threads[thread] = name;
+  }
+  return thread;
+}
+
+void RoutingTrace::Start() {
+  std::lock_guard<std::mutex> lock(s_trace_mutex);
+  s_trace_spans.clear();
+  s_trace_start = std::chrono::steady_clock::now();
+  s_Recording = true;
+}
+
+void RoutingTrace::Stop() { s_Recording = false; }
+
+void RoutingTrace::Span(const char* name, const char* category,
+                        TimePoint start, TimePoint end) {
+  if (!Recording()) return;
+  int thread = TraceThread();
+  std::lock_guard<std::mutex> lock(s_trace_mutex);
+  /* started before the recording */
+  if (start < s_trace_start) start = s_trace_start;
+  s_trace_spans.push_back({name, category, thread, start, end});
+}
+
+/* microseconds from the start of the recording, as the format expects */
+static double TraceMicroseconds(RoutingTrace::TimePoint time) {
+  return std::chrono::duration<double, std::micro>(time - s_trace_start)
+      .count();
+}
+
+bool RoutingTrace::Save(const wxString& filename) {
+  Json::Value root;
+  Json::Value& events = root["traceEvents"];
+  events = Json::Value(Json::arrayValue);
+  {
+    std::lock_guard<std::mutex> lock(s_trace_mutex);
+    for (const auto& thread : s_trace_threads) {
+      Json::Value event;
+      event["name"] = "thread_name";
+      event["ph"] = "M";
+      event["pid"] = 1;
+      event["tid"] = thread.first;
+      event["args"]["name"] = std::string(thread.second.ToUTF8());
+      events.append(event);
+    }
+    for (const TraceSpan& span : s_trace_spans) {
+      Json::Value event;
+      event["name"] = span.name;
+      event["cat"] = span.category;
+      event["ph"] = "X";
+      event["pid"] = 1;
+      event["tid"] = span.thread;
+      event["ts"] = TraceMicroseconds(span.start);
+      event["dur"] =
+          std::chrono::duration<double, std::micro>(span.end - span.start)
+              .count();
+      events.append(event);
+    }
+  }
+  root["displayTimeUnit"] = "ms";
+
+  wxFile file;
+  Json::FastWriter writer;
+  return file.Open(filename, wxFile::write) &&
+         file.Write(wxString::FromUTF8(writer.write(root).c_str()));
+}
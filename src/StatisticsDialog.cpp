@@ -25,6 +25,7 @@
  */
 
 #include <wx/wx.h>
+#include <wx/file.h>
 
 #include <stdlib.h>
 #include <math.h>
@@ -32,11 +33,94 @@
 
 #include <list>
 
+#include "json/json.h"
+
 #include "StatisticsDialog.h"
 
 #include "Utilities.h"
 #include "Boat.h"
 #include "RouteMapOverlay.h"
+#include "RoutingTrace.h"
+
+static wxString PhaseLabel(RoutingProfile::Phase phase) {
+  switch (phase) {
+    case RoutingProfile::PROPAGATE:
+      return _("Propagate");
+    case RoutingProfile::MERGE:
+      return _("Merge");
+    case RoutingProfile::WEATHER:
+      return _("Weather");
+    case RoutingProfile::POLAR:
+      return _("Polar");
+    case RoutingProfile::LAND:
+      return _("Land");
+    case RoutingProfile::BOUNDARY:
+      return _("Boundary");
+    case RoutingProfile::GRIB_WAIT:
+      return _("Grib Wait");
+    case RoutingProfile::CHECK_SWELL:
+      return _("Max Swell");
+    case RoutingProfile::CHECK_MAX_LATITUDE:
+      return _("Max Latitude");
+    case RoutingProfile::CHECK_MAX_TRUE_WIND:
+      return _("Max True Wind");
+    case RoutingProfile::CHECK_MAX_APPARENT_WIND:
+      return _("Max Apparent Wind");
+    case RoutingProfile::CHECK_WIND_VS_CURRENT:
+      return _("Wind vs Current");
+    case RoutingProfile::CHECK_MAX_COURSE_ANGLE:
+      return _("Max Course Angle");
+    case RoutingProfile::CHECK_MAX_DIVERTED_COURSE:
+      return _("Max Diverted Course");
+    case RoutingProfile::CHECK_CORRIDOR:
+      return _("Corridor");
+    case RoutingProfile::CHECK_HEURISTIC_BOUND:
+      return _("Heuristic Bound");
+    case RoutingProfile::CHECK_CYCLONE_TRACK:
+      return _("Cyclone Tracks");
+    default:
+      return wxEmptyString;
+  }
+}
+
+static wxString ReasonLabel(RejectionHistogram::Reason reason) {
+  switch (reason) {
+    case RejectionHistogram::SEARCH_ANGLE:
+      return _("Search Angle");
+    case RejectionHistogram::POLAR:
+      return _("Polar");
+    case RejectionHistogram::MAX_COURSE_ANGLE:
+      return _("Max Course Angle");
+    case RejectionHistogram::MAX_DIVERTED_COURSE:
+      return _("Max Diverted Course");
+    case RejectionHistogram::CORRIDOR:
+      return _("Corridor");
+    case RejectionHistogram::MAX_APPARENT_WIND:
+      return _("Max Apparent Wind");
+    case RejectionHistogram::LAND:
+      return _("Land");
+    case RejectionHistogram::BOUNDARY:
+      return _("Boundary");
+    case RejectionHistogram::CYCLONE_TRACK:
+      return _("Cyclone Tracks");
+    case RejectionHistogram::MAX_SWELL:
+      return _("Max Swell");
+    case RejectionHistogram::MAX_LATITUDE:
+      return _("Max Latitude");
+    case RejectionHistogram::MAX_TRUE_WIND:
+      return _("Max True Wind");
+    case RejectionHistogram::WIND_VS_CURRENT:
+      return _("Wind vs Current");
+    case RejectionHistogram::WIND_DATA:
+      return _("No Wind Data");
+    case RejectionHistogram::HEURISTIC_BOUND:
+      return _("Heuristic Bound");
+    case RejectionHistogram::REVERSE_REACH:
+      return _("Reverse Pass");
+    default:
+      return wxEmptyString;
+  }
+}
 
 StatisticsDialog::StatisticsDialog(wxWindow* parent)
 #ifndef __WXOSX__
@@ -47,6 +131,67 @@ StatisticsDialog::StatisticsDialog(wxWindow* parent)
                            wxDEFAULT_DIALOG_STYLE | wxSTAY_ON_TOP)
 #endif
 {
+  wxWindow* box = m_sbProfile->GetStaticBox();
+  const wxString headings[] = {_("Phase"), _("Calls"), _("Seconds"),
+                               _("Last Step")};
+  for (const wxString& heading : headings)
+    m_fgProfile->Add(new wxStaticText(box, wxID_ANY, heading), 0, wxALL, 5);
+  for (int i = 0; i < RoutingProfile::PHASE_COUNT; i++) {
+    m_fgProfile->Add(
+        new wxStaticText(box, wxID_ANY, PhaseLabel(RoutingProfile::Phase(i))),
+        0, wxALL, 5);
+    m_stProfileCalls[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgProfile->Add(m_stProfileCalls[i], 0, wxALL | wxALIGN_RIGHT, 5);
+    m_stProfileTime[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgProfile->Add(m_stProfileTime[i], 0, wxALL | wxALIGN_RIGHT, 5);
+    m_stProfileLast[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgProfile->Add(m_stProfileLast[i], 0, wxALL | wxALIGN_RIGHT, 5);
+  }
+
+  box = m_sbRejections->GetStaticBox();
+  const wxString reasonheadings[] = {_("Reason"), _("Headings"),
+                                     _("Positions"), _("Last Step")};
+  for (const wxString& heading : reasonheadings)
+    m_fgRejections->Add(new wxStaticText(box, wxID_ANY, heading), 0, wxALL,
+                        5);
+  for (int i = 0; i < RejectionHistogram::REASON_COUNT; i++) {
+    m_fgRejections->Add(
+        new wxStaticText(box, wxID_ANY,
+                         ReasonLabel(RejectionHistogram::Reason(i))),
+        0, wxALL, 5);
+    m_stRejectedHeadings[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgRejections->Add(m_stRejectedHeadings[i], 0, wxALL | wxALIGN_RIGHT, 5);
+    m_stRejectedPositions[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgRejections->Add(m_stRejectedPositions[i], 0, wxALL | wxALIGN_RIGHT,
+                        5);
+    m_stRejectedLast[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgRejections->Add(m_stRejectedLast[i], 0, wxALL | wxALIGN_RIGHT, 5);
+  }
+
+  /* headings by their angle off the bearing from start to destination */
+  const wxString bucketheadings[] = {_("Off Course"), _("Tried"),
+                                     _("Rejected"), _("Last Step")};
+  for (const wxString& heading : bucketheadings)
+    m_fgRejectionBuckets->Add(new wxStaticText(box, wxID_ANY, heading), 0,
+                              wxALL, 5);
+  for (int i = 0; i < RejectionHistogram::BUCKET_COUNT; i++) {
+    m_fgRejectionBuckets->Add(
+        new wxStaticText(
+            box, wxID_ANY,
+            wxString::Format("%d-%d", i * RejectionHistogram::BUCKET_DEGREES,
+                             (i + 1) * RejectionHistogram::BUCKET_DEGREES)),
+        0, wxALL, 5);
+    m_stBucketTried[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgRejectionBuckets->Add(m_stBucketTried[i], 0, wxALL | wxALIGN_RIGHT,
+                              5);
+    m_stBucketRejected[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgRejectionBuckets->Add(m_stBucketRejected[i], 0,
+                              wxALL | wxALIGN_RIGHT, 5);
+    m_stBucketLast[i] = new wxStaticText(box, wxID_ANY, "0");
+    m_fgRejectionBuckets->Add(m_stBucketLast[i], 0, wxALL | wxALIGN_RIGHT,
+                              5);
+  }
+
   SetRouteMapOverlays(std::list<RouteMapOverlay*>());
 #ifdef __OCPN__ANDROID__
   wxSize sz = ::wxGetDisplaySize();
@@ -56,9 +201,12 @@ StatisticsDialog::StatisticsDialog(wxWindow* parent)
 
 void StatisticsDialog::SetRouteMapOverlays(
     std::list<RouteMapOverlay*> routemapoverlays) {
+  m_RouteMapOverlays = routemapoverlays;
   bool running = false;
   int tisochrons = 0, troutes = 0, tinvroutes = 0, tskippositions = 0,
       tpositions = 0;
+  RoutingProfile profile, last;
+  RejectionHistogram rejections, lastrejections;
   for (std::list<RouteMapOverlay*>::iterator it = routemapoverlays.begin();
        it != routemapoverlays.end(); it++) {
     if ((*it)->Running()) running = true;
@@ -68,6 +216,12 @@ void StatisticsDialog::SetRouteMapOverlays(
                          positions);
     tisochrons += isochrones, troutes += routes, tinvroutes += invroutes;
     tskippositions += skippositions, tpositions += positions;
+
+    profile.Add((*it)->GetProfile());
+    last.Add((*it)->GetLastStepProfile());
+
+    rejections.Add((*it)->GetRejections());
+    lastrejections.Add((*it)->GetLastStepRejections());
   }
 
   m_stState->SetLabel(routemapoverlays.empty() ? _("No Route")
@@ -79,9 +233,114 @@ void StatisticsDialog::SetRouteMapOverlays(
   m_stSkipPositions->SetLabel(wxString::Format("%d", tskippositions));
   m_stPositions->SetLabel(wxString::Format("%d", tpositions));
 
+  /* the constraint checks which are only counted show the calls of the last
+     step instead of its time */
+  for (int i = 0; i < RoutingProfile::PHASE_COUNT; i++) {
+    RoutingProfile::Phase phase = RoutingProfile::Phase(i);
+    m_stProfileCalls[i]->SetLabel(
+        wxString::Format("%ld", profile.Calls(phase)));
+    if (RoutingProfile::Timed(phase)) {
+      m_stProfileTime[i]->SetLabel(
+          wxString::Format("%.3f", profile.Seconds(phase)));
+      m_stProfileLast[i]->SetLabel(
+          wxString::Format("%.3f", last.Seconds(phase)));
+    } else {
+      m_stProfileTime[i]->SetLabel("-");
+      m_stProfileLast[i]->SetLabel(wxString::Format("%ld", last.Calls(phase)));
+    }
+  }
+
+  /* the last step shows the headings and positions rejected together */
+  for (int i = 0; i < RejectionHistogram::REASON_COUNT; i++) {
+    RejectionHistogram::Reason reason = RejectionHistogram::Reason(i);
+    m_stRejectedHeadings[i]->SetLabel(
+        wxString::Format("%ld", rejections.Rejected(reason)));
+    m_stRejectedPositions[i]->SetLabel(
+        wxString::Format("%ld", rejections.RejectedPositions(reason)));
+    m_stRejectedLast[i]->SetLabel(
+        wxString::Format("%ld", lastrejections.Rejected(reason) +
+                                    lastrejections.RejectedPositions(reason)));
+  }
+  for (int i = 0; i < RejectionHistogram::BUCKET_COUNT; i++) {
+    m_stBucketTried[i]->SetLabel(
+        wxString::Format("%ld", rejections.Tried(i)));
+    m_stBucketRejected[i]->SetLabel(
+        wxString::Format("%ld", rejections.RejectedInBucket(i)));
+    m_stBucketLast[i]->SetLabel(
+        wxString::Format("%ld", lastrejections.RejectedInBucket(i)));
+  }
+
   Fit();
 }
 
 void StatisticsDialog::SetRunTime(wxTimeSpan RunTime) {
   m_stRunTime->SetLabel(RunTime.Format());
 }
+
+void StatisticsDialog::OnSaveProfile(wxCommandEvent& event) {
+  wxFileDialog saveDialog(this, _("Save Profile"), wxEmptyString,
+                          "profile.json",
+                          wxT("JSON files (*.json)|*.json|All files (*.*)|*.*"),
+                          wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+  if (saveDialog.ShowModal() != wxID_OK) return;
+
+  /* the cumulative profile and rejections of each route, and those of each of
+     its propagation steps */
+  Json::Value root;
+  Json::Value& routes = root["routes"];
+  routes = Json::Value(Json::arrayValue);
+  for (RouteMapOverlay* routemapoverlay : m_RouteMapOverlays) {
+    std::shared_ptr<const RouteMapConfiguration> configuration =
+        routemapoverlay->GetConfigurationSnapshot();
+    Json::Value route;
+    route["start"] = std::string(configuration->Start.ToUTF8());
+    route["end"] = std::string(configuration->End.ToUTF8());
+    routemapoverlay->GetProfile().toJson(route["profile"]);
+    routemapoverlay->GetRejections().toJson(route["rejections"]);
+    Json::Value& steps = route["steps"];
+    steps = Json::Value(Json::arrayValue);
+    std::vector<RoutingProfile> profiles = routemapoverlay->GetStepProfiles();
+    std::vector<RejectionHistogram> rejections =
+        routemapoverlay->GetStepRejections();
+    for (size_t i = 0; i < profiles.size(); i++) {
+      Json::Value& step = steps.append(Json::Value());
+      profiles[i].toJson(step);
+      if (i < rejections.size()) rejections[i].toJson(step["rejections"]);
+    }
+    routes.append(route);
+  }
+
+  wxString filename =
+      wxFileDialog::AppendExtension(saveDialog.GetPath(), "*.json");
+  wxFile file;
+  Json::StyledWriter writer;
+  if (!file.Open(filename, wxFile::write) ||
+      !file.Write(wxString::FromUTF8(writer.write(root).c_str()))) {
+    wxMessageDialog mdlg(this, _("Failed to save profile to: ") + filename,
+                         _("Weather Routing"), wxOK | wxICON_ERROR);
+    mdlg.ShowModal();
+  }
+}
+
+void StatisticsDialog::OnRecordTrace(wxCommandEvent& event) {
+  if (m_cbRecordTrace->GetValue())
+    RoutingTrace::Start();
+  else
+    RoutingTrace::Stop();
+}
+
+void StatisticsDialog::OnSaveTrace(wxCommandEvent& event) {
+  wxFileDialog saveDialog(
+      this, _("Save Trace"), wxEmptyString, "trace.json",
+      wxT("Chrome trace files (*.json)|*.json|All files (*.*)|*.*"),
+      wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+  if (saveDialog.ShowModal() != wxID_OK) return;
+
+  wxString filename =
+      wxFileDialog::AppendExtension(saveDialog.GetPath(), "*.json");
+  if (!RoutingTrace::Save(filename)) {
+    wxMessageDialog mdlg(this, _("Failed to save trace to: ") + filename,
+                         _("Weather Routing"), wxOK | wxICON_ERROR);
+    mdlg.ShowModal();
+  }
+}
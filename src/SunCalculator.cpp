@@ -21,7 +21,7 @@
 
 #include <math.h>
 #include <time.h>
-#include <unordered_map>
+#include <vector>
 
 #include "SunCalculator.h"
 
@@ -316,129 +316,54 @@ DayLightStatus SunCalculator::GetDayLightStatus(double lat, double lon,
   int day_of_year = time.GetDayOfYear();
   int hourOfDay = time.GetHour(wxDateTime::UTC);
 
-  wxCriticalSectionLocker lock(m_cacheLock);
-
-  // Increment access counter
-  m_accessCounter++;
-
-  // Create a cache key for O(1) lookup
-  CacheKey key = CacheKey::Pack(day_of_year, lat_index, lon_index);
-
-  // Check if key exists in the map (O(1) lookup instead of linear search)
-  auto mapIt = m_cacheMap.find(key);
-  if (mapIt != m_cacheMap.end()) {
-    // Cache hit - get the index to the entry in the vector
-    size_t cacheIndex = mapIt->second;
-    if (cacheIndex < m_cache.size()) {
-      // Get the entry from the vector
-      SunTimeCache& entry = m_cache[cacheIndex];
-
-      // Update access counter (only occasionally to reduce overhead)
-      if (m_accessCounter % 100 == 0) {
-        entry.access_counter = m_accessCounter;
-      }
-
-      // Use cached year and hour values
-      int sunriseYear = entry.sunriseYear;
-      int sunsetYear = entry.sunsetYear;
-      int sunriseHour = entry.sunriseHour;
-      int sunsetHour = entry.sunsetHour;
-
-      // Calculate sun elevation if requested (for cache hits)
-      if (sunElevation != nullptr) {
-        *sunElevation = calculateElevation();
-      }
-
-      // Handle edge cases
-      if (sunriseYear == 999) {
-        // Sun never rises (polar night) - elevation already set by
-        // calculateElevation
-        return DayLightStatus::Night;
-      } else if (sunsetYear == 999) {
-        // Sun never sets (midnight sun) - elevation already set by
-        // calculateElevation
-        return DayLightStatus::Day;
-      }
-
-      // Normal case: compare current time to sunrise/sunset
-      if (sunsetHour < sunriseHour) {
-        // Sun sets after midnight
-        return (hourOfDay >= sunriseHour || hourOfDay < sunsetHour)
-                   ? DayLightStatus::Day
-                   : DayLightStatus::Night;
-      } else {
-        // Normal case: sunrise and sunset on same day
-        return (hourOfDay >= sunriseHour && hourOfDay < sunsetHour)
-                   ? DayLightStatus::Day
-                   : DayLightStatus::Night;
-      }
-    }
-  }
-
-  // Cache miss - calculate new values
-  wxDateTime sunrise, sunset;
-  CalculateSun(lat, lon, day_of_year, sunrise, sunset);
-
-  int sunriseYear = sunrise.GetYear();
-  int sunsetYear = sunset.GetYear();
-  int sunriseHour = sunrise.GetHour(wxDateTime::UTC);
-  int sunsetHour = sunset.GetHour(wxDateTime::UTC);
-
-  // Add to cache using LRU replacement policy if needed
-  if (m_cache.size() >= MAX_SUN_CACHE_SIZE) {
-    // Find least recently accessed entry
-    auto oldest =
-        std::min_element(m_cache.begin(), m_cache.end(),
-                         [](const SunTimeCache& a, const SunTimeCache& b) {
-                           return a.access_counter < b.access_counter;
-                         });
-
-    // Get the index of the oldest entry
-    size_t oldestIndex = std::distance(m_cache.begin(), oldest);
-
-    // Replace it with new entry
-    oldest->day_of_year = day_of_year;
-    oldest->lat_index = lat_index;
-    oldest->lon_index = lon_index;
-    oldest->sunriseYear = sunriseYear;
-    oldest->sunsetYear = sunsetYear;
-    oldest->sunriseHour = sunriseHour;
-    oldest->sunsetHour = sunsetHour;
-    oldest->access_counter = m_accessCounter;
-
-    // Update the map with the new key -> same index
-    m_cacheMap[key] = oldestIndex;
-  } else {
-    // Add new entry to the end of the vector
-    m_cache.push_back({day_of_year, lat_index, lon_index, sunriseYear,
-                       sunsetYear, sunriseHour, sunsetHour, m_accessCounter});
+  uint32_t key = PackKey(day_of_year, lat_index, lon_index);
+  SunTimes& entry = CacheSlot(key);
+  if (entry.key != key) {
+    // Cache miss - calculate new values, replacing the slot's previous cell
+    wxDateTime sunrise, sunset;
+    CalculateSun(lat, lon, day_of_year, sunrise, sunset);
 
-    // Add to the map with the index of the newly added entry
-    m_cacheMap[key] = m_cache.size() - 1;
+    entry.key = key;
+    entry.neverRises = sunrise.GetYear() == 999;
+    entry.neverSets = sunset.GetYear() == 999;
+    entry.sunriseHour = sunrise.GetHour(wxDateTime::UTC);
+    entry.sunsetHour = sunset.GetHour(wxDateTime::UTC);
   }
 
-  // Calculate sun elevation if requested (for cache misses)
+  // Calculate sun elevation if requested
   if (sunElevation != nullptr) {
     *sunElevation = calculateElevation();
   }
 
-  // Determine day/night status with new calculation
-  if (sunriseYear == 999) {
+  // Handle edge cases
+  if (entry.neverRises) {
     // Polar night - elevation already set by calculateElevation
     return DayLightStatus::Night;
-  } else if (sunsetYear == 999) {
+  } else if (entry.neverSets) {
     // Midnight sun - elevation already set by calculateElevation
     return DayLightStatus::Day;
   }
-  if (sunsetHour < sunriseHour) {
+  if (entry.sunsetHour < entry.sunriseHour) {
     // Sun sets after midnight
-    return (hourOfDay >= sunriseHour || hourOfDay < sunsetHour)
+    return (hourOfDay >= entry.sunriseHour || hourOfDay < entry.sunsetHour)
                ? DayLightStatus::Day
                : DayLightStatus::Night;
   } else {
     // Normal case: sunrise and sunset on same day
-    return (hourOfDay >= sunriseHour && hourOfDay < sunsetHour)
+    return (hourOfDay >= entry.sunriseHour && hourOfDay < entry.sunsetHour)
                ? DayLightStatus::Day
                : DayLightStatus::Night;
   }
-}
\ No newline at end of file
+}
+
+SunCalculator::SunTimes& SunCalculator::CacheSlot(uint32_t key) {
+  // Allocated on first use, a large static thread local block could not be
+  // reserved when the plugin library is loaded.
+  thread_local std::vector<SunTimes> cache;
+  if (cache.empty()) {
+    SunTimes empty = {EMPTY_KEY, 0, 0, false, false};
+    cache.assign(size_t(1) << SUN_CACHE_BITS, empty);
+  }
+
+  return cache[SlotIndex(key)];
+}
@@ -22,11 +22,15 @@
 #include <wx/imaglist.h>
 #include <wx/progdlg.h>
 #include <wx/dir.h>
+#include <wx/wfstream.h>
 
 #include <stdlib.h>
 #include <math.h>
 #include <cmath>
 #include <time.h>
+#include <atomic>
+#include <set>
+#include <vector>
 
 #include <wx/glcanvas.h>
 
@@ -509,8 +513,10 @@ WeatherRouting::~WeatherRouting() {
   SaveXML(m_FileName.GetFullPath());
 
   for (std::list<WeatherRoute*>::iterator it = m_WeatherRoutes.begin();
-       it != m_WeatherRoutes.end(); it++)
+       it != m_WeatherRoutes.end(); it++) {
+    m_ReportDialog.RemoveRouteMapOverlay((*it)->routemapoverlay);
     delete *it;
+  }
   delete m_panel;
   delete m_colpane;
 
@@ -1001,7 +1007,7 @@ void WeatherRouting::UpdateCursorPositionDialog() {
   if (p->polar == -1)
     dlg.m_stPolar->SetLabel(wxEmptyString);
   else {
-    wxFileName fn = configuration.boat.Polars[p->polar].FileName;
+    wxFileName fn = configuration.boat->Polars[p->polar].FileName;
     dlg.m_stPolar->SetLabel(fn.GetFullName());
   }
 
@@ -1098,7 +1104,7 @@ void WeatherRouting::UpdateRoutePositionDialog() {
   if (data.polar == -1)
     dlg.m_stPolar->SetLabel(wxEmptyString);
   else {
-    wxFileName fn = configuration.boat.Polars[data.polar].FileName;
+    wxFileName fn = configuration.boat->Polars[data.polar].FileName;
     dlg.m_stPolar->SetLabel(fn.GetFullName());
   }
 
@@ -1980,7 +1986,7 @@ void WeatherRouting::OnExportRouteAsGPX(wxCommandEvent& event) {
   int nfail = 0;
   for (std::list<RouteMapOverlay*>::iterator it = routemapoverlays.begin();
        it != routemapoverlays.end(); it++) {
-    std::list<PlotData> plotdata = (*it)->GetPlotData(false);
+    std::list<PlotData>& plotdata = (*it)->GetPlotData(false);
 
     if (plotdata.empty())
       nfail++;
@@ -2007,6 +2013,312 @@ void WeatherRouting::OnSaveAllAsTracks(wxCommandEvent& event) {
                      ->routemapoverlay);
 }
 
+// Helper function to format a UTC time as in GPX files
+static wxString FormatExportTime(const wxDateTime& time) {
+  return time.FormatISODate() + "T" + time.FormatISOTime() + "Z";
+}
+
+// Helper function to format a number for export, empty when not available
+static wxString FormatExportNumber(double value, int precision) {
+  if (std::isnan(value)) return wxEmptyString;
+  return wxString::Format("%.*f", precision, value);
+}
+
+static wxString EscapeExportXML(const wxString& text) {
+  wxString escaped = text;
+  escaped.Replace("&", "&amp;");
+  escaped.Replace("<", "&lt;");
+  escaped.Replace(">", "&gt;");
+  escaped.Replace("\"", "&quot;");
+  return escaped;
+}
+
+static wxString EscapeExportJSON(const wxString& text) {
+  wxString escaped = text;
+  escaped.Replace("\\", "\\\\");
+  escaped.Replace("\"", "\\\"");
+  escaped.Replace("\n", "\\n");
+  return "\"" + escaped + "\"";
+}
+
+static wxString EscapeExportCSV(const wxString& text) {
+  if (text.find_first_of(",\"\r\n") == wxString::npos) return text;
+  wxString quoted = text;
+  quoted.Replace("\"", "\"\"");
+  return "\"" + quoted + "\"";
+}
+
+/*
+ * Writes the plot data of many routings to one GPX, GeoJSON or CSV file.
+ *
+ * The plot data is copied from the routings on the GUI thread, where it is
+ * usually cached already, this thread only formats and writes it. Each
+ * routing is released once written.
+ */
+class BulkExportThread : public wxThread {
+public:
+  enum Format { GPX, GEOJSON, CSV };
+
+  /** A routing to export. */
+  struct Route {
+    wxString name;
+    wxString boat;
+    std::list<PlotData> plotdata;
+    /** Destination reached after the last plot data, if any. */
+    bool destination;
+    double destinationLat, destinationLon;
+    wxDateTime endTime;
+  };
+
+  BulkExportThread(const wxString& filename, Format format)
+      : wxThread(wxTHREAD_JOINABLE),
+        m_FileName(filename),
+        m_Format(format),
+        m_Exported(0),
+        m_Success(false) {
+    Create();
+  }
+
+  void* Entry();
+
+  std::vector<Route> m_Routes;
+  wxString m_FileName;
+  Format m_Format;
+  /** Number of routings written so far, polled by the GUI thread. */
+  std::atomic<int> m_Exported;
+  bool m_Success;
+
+private:
+  wxString FormatRoute(const Route& route, bool first);
+};
+
+void* BulkExportThread::Entry() {
+  wxFileOutputStream file(m_FileName);
+  if (!file.IsOk()) return 0;
+
+  auto write = [&file](const wxString& text) {
+    wxCharBuffer buffer = text.ToUTF8();
+    file.Write(buffer.data(), buffer.length());
+    return file.IsOk();
+  };
+
+  bool ok;
+  switch (m_Format) {
+    case GPX:
+      ok = write(
+          "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          "<gpx version=\"1.1\" creator=\"OpenCPN Weather Routing\" "
+          "xmlns=\"http://www.topografix.com/GPX/1/1\">\n");
+      break;
+    case GEOJSON:
+      ok = write("{\"type\": \"FeatureCollection\", \"features\": [\n");
+      break;
+    case CSV:
+      ok = write(
+          "route,boat,time,lat,lon,sog,cog,stw,ctw,hdg,tws,twd,gust,"
+          "current_speed,current_dir,wave_height,rain,pressure\r\n");
+      break;
+  }
+
+  for (size_t i = 0; ok && i < m_Routes.size(); i++) {
+    if (TestDestroy()) return 0;
+
+    ok = write(FormatRoute(m_Routes[i], i == 0));
+    m_Routes[i].plotdata.clear();
+    m_Exported = i + 1;
+  }
+
+  switch (m_Format) {
+    case GPX:
+      ok = ok && write("</gpx>\n");
+      break;
+    case GEOJSON:
+      ok = ok && write("\n]}\n");
+      break;
+    case CSV:
+      break;
+  }
+
+  m_Success = file.Close() && ok;
+  return 0;
+}
+
+wxString BulkExportThread::FormatRoute(const Route& route, bool first) {
+  // Points of the routing, ending with its destination
+  struct Point {
+    double lat, lon;
+    wxDateTime time;
+    const PlotData* data;
+  };
+  std::vector<Point> points;
+  points.reserve(route.plotdata.size() + 1);
+  for (const PlotData& data : route.plotdata)
+    points.push_back({data.lat, heading_resolve(data.lon), data.time, &data});
+  if (route.destination)
+    points.push_back({route.destinationLat,
+                      heading_resolve(route.destinationLon), route.endTime,
+                      nullptr});
+
+  wxString text;
+  switch (m_Format) {
+    case GPX:
+      text = "<trk>\n<name>" + EscapeExportXML(route.name) + "</name>\n";
+      text += "<desc>" + EscapeExportXML(route.boat) + "</desc>\n<trkseg>\n";
+      for (const Point& p : points)
+        text += wxString::Format(
+            "<trkpt lat=\"%.6f\" lon=\"%.6f\"><time>%s</time></trkpt>\n",
+            p.lat, p.lon, FormatExportTime(p.time));
+      text += "</trkseg>\n</trk>\n";
+      break;
+
+    case GEOJSON: {
+      wxString coordinates, times;
+      for (const Point& p : points) {
+        if (!coordinates.empty()) {
+          coordinates += ", ";
+          times += ", ";
+        }
+        coordinates += wxString::Format("[%.6f, %.6f]", p.lon, p.lat);
+        times += EscapeExportJSON(FormatExportTime(p.time));
+      }
+      text = first ? "" : ",\n";
+      text += "{\"type\": \"Feature\", \"properties\": {\"name\": " +
+              EscapeExportJSON(route.name) +
+              ", \"boat\": " + EscapeExportJSON(route.boat) +
+              ", \"times\": [" + times +
+              "]}, \"geometry\": {\"type\": \"LineString\", "
+              "\"coordinates\": [" +
+              coordinates + "]}}";
+      break;
+    }
+
+    case CSV: {
+      wxString prefix = EscapeExportCSV(route.name) + "," +
+                        EscapeExportCSV(route.boat) + ",";
+      for (const Point& p : points) {
+        text += prefix + FormatExportTime(p.time) + ",";
+        text += wxString::Format("%.6f,%.6f", p.lat, p.lon);
+        const PlotData* d = p.data;
+        if (d) {
+          double values[] = {d->sog,
+                             d->cog,
+                             d->stw,
+                             d->ctw,
+                             d->hdg,
+                             d->twsOverWater,
+                             d->twdOverWater,
+                             d->VW_GUST,
+                             d->currentSpeed,
+                             d->currentDir,
+                             d->WVHT,
+                             d->rain_mm_per_hour,
+                             d->air_pressure};
+          for (double value : values)
+            text += "," + FormatExportNumber(value, 2);
+        } else {
+          text += wxString(',', 13);
+        }
+        text += "\r\n";
+      }
+      break;
+    }
+  }
+  return text;
+}
+
+void WeatherRouting::OnExportAllRoutes(wxCommandEvent& event) {
+  wxFileDialog saveDialog(this, _("Export all routings"), "",
+                          "weather_routes.gpx",
+                          _("GPX files (*.gpx)|*.gpx|GeoJSON files "
+                            "(*.geojson)|*.geojson|CSV files (*.csv)|*.csv"),
+                          wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+  if (saveDialog.ShowModal() == wxID_CANCEL) return;
+
+  // the extension typed decides the format, the filter only names files
+  // typed without one
+  static const char* extensions[] = {"gpx", "geojson", "csv"};
+  BulkExportThread::Format format =
+      (BulkExportThread::Format)wxMax(0, saveDialog.GetFilterIndex());
+  wxFileName filename(saveDialog.GetPath());
+  for (int i = BulkExportThread::GPX; i <= BulkExportThread::CSV; i++)
+    if (filename.GetExt().IsSameAs(extensions[i], false))
+      format = (BulkExportThread::Format)i;
+  if (filename.GetExt().empty()) filename.SetExt(extensions[format]);
+
+  BulkExportThread* thread =
+      new BulkExportThread(filename.GetFullPath(), format);
+
+  // Plot data is not thread safe, copy it here. Finished routings already
+  // have it cached for the routings list.
+  for (WeatherRoute* weatherroute : m_WeatherRoutes) {
+    RouteMapOverlay* routemapoverlay = weatherroute->routemapoverlay;
+    if (!routemapoverlay->Finished()) continue;
+    std::list<PlotData>& plotdata = routemapoverlay->GetPlotData(false);
+    if (plotdata.empty()) continue;
+
+    BulkExportThread::Route route;
+    route.name = weatherroute->Start + " - " + weatherroute->End + " (" +
+                 weatherroute->StartTime + ")";
+    route.boat = weatherroute->BoatFilename;
+    route.plotdata = plotdata;
+    Position* destination = routemapoverlay->GetDestination();
+    route.destination = destination != nullptr;
+    if (destination) {
+      route.destinationLat = destination->lat;
+      route.destinationLon = destination->lon;
+      route.endTime = routemapoverlay->EndTime();
+    }
+    thread->m_Routes.push_back(route);
+  }
+
+  int count = thread->m_Routes.size();
+  if (!count) {
+    delete thread;
+    wxMessageDialog mdlg(this, _("No computed routing to export\n"),
+                         _("Weather Routing"), wxOK | wxICON_WARNING);
+    mdlg.ShowModal();
+    return;
+  }
+
+  wxProgressDialog progressdialog(
+      _("Export all routings"), _("Weather Routing"), count, this,
+      wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME);
+
+  bool cancelled = false;
+  if (thread->Run() == wxTHREAD_NO_ERROR) {
+    while (thread->IsRunning()) {
+      if (!progressdialog.Update(wxMin((int)thread->m_Exported, count - 1))) {
+        cancelled = true;
+        break;
+      }
+      wxMilliSleep(50);
+    }
+  }
+
+  // Stops the thread if cancelled, and waits for it
+  thread->Delete();
+  bool success = !cancelled && thread->m_Success;
+  delete thread;
+  progressdialog.Hide();
+
+  if (cancelled) {
+    wxRemoveFile(filename.GetFullPath());
+  } else if (success) {
+    wxMessageDialog mdlg(
+        this,
+        wxString::Format(_("%d routings exported to\n%s"), count,
+                         filename.GetFullPath()),
+        _("Weather Routing"), wxOK);
+    mdlg.ShowModal();
+  } else {
+    wxMessageDialog mdlg(this,
+                         _("Failed to export routings to\n") +
+                             filename.GetFullPath(),
+                         _("Weather Routing"), wxOK | wxICON_ERROR);
+    mdlg.ShowModal();
+  }
+}
+
 void WeatherRouting::OnSettings(wxCommandEvent& event) {
   m_SettingsDialog.Show();
 }
@@ -2118,12 +2430,35 @@ void WeatherRouting::OnComputationTimer(wxTimerEvent&) {
 
       it = m_RunningRouteMaps.erase(it);
 
+      /* a pass of a multi pass route is done, or its restricted fine pass
+         missed the destination, queue the next pass */
+      if (routemapoverlay->StartFinePass()) {
+        m_RoutesToRun++;
+        m_WaitingRouteMaps.push_front(routemapoverlay);
+        UpdateRouteMap(routemapoverlay);
+        continue;
+      }
+
       m_panel->m_gProgress->SetValue(m_RoutesToRun - m_WaitingRouteMaps.size() -
                                      m_RunningRouteMaps.size());
       UpdateRouteMap(routemapoverlay);
 
-      /* update report if needed */
-      m_ReportDialog.m_bReportStale = true;
+      /* where the time went and which work was thrown away, for slow
+         routes, when debugging */
+      std::shared_ptr<const RouteMapConfiguration> configuration =
+          routemapoverlay->GetConfigurationSnapshot();
+      wxLogGeneric(wxLOG_Debug, "weather_routing_pi: profile of %s to %s: %s",
+                   configuration->Start, configuration->End,
+                   routemapoverlay->GetProfile().ToString());
+      wxLogGeneric(wxLOG_Debug,
+                   "weather_routing_pi: rejections of %s to %s: %s, "
+                   "last step %s",
+                   configuration->Start, configuration->End,
+                   routemapoverlay->GetRejections().ToString(),
+                   routemapoverlay->GetLastStepRejections().ToString());
+
+      /* update report if needed, only this route's metrics are recomputed */
+      m_ReportDialog.RemoveRouteMapOverlay(routemapoverlay);
       if (m_ReportDialog.IsShown()) {
         std::list<RouteMapOverlay*> routemapoverlays = CurrentRouteMaps();
         for (std::list<RouteMapOverlay*>::iterator it =
@@ -2213,6 +2548,31 @@ void WeatherRouting::OnRenderedTimer(wxTimerEvent&) {
   }
 }
 
+/* identifies what a snapshot was computed from: the attributes of the
+   configuration element of the route and the boat file, which may have been
+   edited since */
+static uint64_t SnapshotFingerprint(const TiXmlElement* e,
+                                    const wxString& boatfile) {
+  wxString inputs;
+  for (const TiXmlAttribute* a = e->FirstAttribute(); a; a = a->Next())
+    if (strcmp(a->Name(), "Snapshot"))
+      inputs << wxString::FromUTF8(a->Name()) << "="
+             << wxString::FromUTF8(a->Value()) << "\n";
+  if (wxFileName::FileExists(boatfile)) {
+    wxDateTime modified = wxFileName(boatfile).GetModificationTime();
+    inputs << wxString::Format("%lld", (long long)modified.GetTicks());
+  }
+
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  wxScopedCharBuffer utf8 = inputs.ToUTF8();
+  for (size_t i = 0; i < utf8.length(); i++) {
+    hash ^= (unsigned char)utf8.data()[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 bool WeatherRouting::OpenXML(wxString filename, bool reportfailure) {
   TiXmlDocument doc;
   wxString error;
@@ -2224,9 +2584,6 @@ bool WeatherRouting::OpenXML(wxString filename, bool reportfailure) {
   wxProgressDialog* progressdialog = NULL;
   wxDateTime start = wxDateTime::UNow();
 
-  wxString lastboatFileName;
-  Boat lastboat;
-
   if (!doc.LoadFile(filename.mb_str()))
     FAIL(_("Failed to load file."));
   else {
@@ -2386,6 +2743,12 @@ bool WeatherRouting::OpenXML(wxString filename, bool reportfailure) {
         configuration.InvertedRegions =
             AttributeBool(e, "InvertedRegions", false);
         configuration.Anchoring = AttributeBool(e, "Anchoring", false);
+        configuration.HeuristicPruning =
+            AttributeBool(e, "HeuristicPruning", false);
+        configuration.Bidirectional = AttributeBool(e, "Bidirectional", false);
+        configuration.MultiResolution =
+            AttributeBool(e, "MultiResolution", false);
+        configuration.CorridorWidth = AttributeDouble(e, "CorridorWidth", 100.);
 
         configuration.FromDegree = AttributeDouble(e, "FromDegree", 0);
         configuration.ToDegree = AttributeDouble(e, "ToDegree", 180);
@@ -2397,15 +2760,33 @@ bool WeatherRouting::OpenXML(wxString filename, bool reportfailure) {
             AttributeDouble(e, "MotorSpeedThreshold", 2.0);
         configuration.MotorSpeed = AttributeDouble(e, "MotorSpeed", 5.0);
 
-        if (configuration.boatFileName == lastboatFileName)
-          configuration.boat = lastboat;
-
-        AddConfiguration(configuration);
-
-        lastboatFileName = configuration.boatFileName;
-        m_WeatherRoutes.back()->routemapoverlay->LoadBoat();
-        lastboat =
-            m_WeatherRoutes.back()->routemapoverlay->GetConfiguration().boat;
+        if (AddConfiguration(configuration)) {
+          RouteMapOverlay* routemapoverlay =
+              m_WeatherRoutes.back()->routemapoverlay;
+          // configurations using the same boat file share its polars
+          routemapoverlay->LoadBoat();
+
+          // restore the computed route instead of computing it again
+          const char* snapshot = e->Attribute("Snapshot");
+          if (snapshot) {
+            // relative to the configuration file
+            wxFileName path(wxString::FromUTF8(snapshot));
+            if (!path.IsAbsolute()) path.MakeAbsolute(fn.GetPath());
+            uint64_t fingerprint = SnapshotFingerprint(
+                e, routemapoverlay->GetConfiguration().boatFileName);
+            // the GRIB requested to check the snapshot goes to the route
+            wxString snapshoterror;
+            m_RouteMapOverlayNeedingGrib = routemapoverlay;
+            bool restored = routemapoverlay->LoadSnapshot(
+                path.GetFullPath(), fingerprint, snapshoterror);
+            m_RouteMapOverlayNeedingGrib = NULL;
+            if (restored) {
+              m_WeatherRoutes.back()->Update(this);
+              UpdateItem(m_panel->m_lWeatherRoutes->GetItemCount() - 1);
+            } else
+              wxLogMessage("weather_routing_pi: %s", snapshoterror);
+          }
+        }
       } else
         FAIL(_("Unrecognized xml node"));
     }
@@ -2453,6 +2834,8 @@ void WeatherRouting::SaveXML(wxString filename) {
     root->LinkEndChild(c);
   }
 
+  std::set<wxString> snapshots;
+  int index = 0;
   for (auto it = m_WeatherRoutes.begin(); it != m_WeatherRoutes.end(); it++) {
     // Ideally the name of the XML element should be "Routings" but it is kept
     // as "Configuration" for backward compatibility.
@@ -2516,6 +2899,10 @@ void WeatherRouting::SaveXML(wxString filename) {
 
     c->SetAttribute("InvertedRegions", configuration.InvertedRegions);
     c->SetAttribute("Anchoring", configuration.Anchoring);
+    c->SetAttribute("HeuristicPruning", configuration.HeuristicPruning);
+    c->SetAttribute("Bidirectional", configuration.Bidirectional);
+    c->SetAttribute("MultiResolution", configuration.MultiResolution);
+    c->SetDoubleAttribute("CorridorWidth", configuration.CorridorWidth);
 
     c->SetDoubleAttribute("FromDegree", configuration.FromDegree);
     c->SetDoubleAttribute("ToDegree", configuration.ToDegree);
@@ -2527,9 +2914,26 @@ void WeatherRouting::SaveXML(wxString filename) {
                           configuration.MotorSpeedThreshold);
     c->SetDoubleAttribute("MotorSpeed", configuration.MotorSpeed);
 
+    wxString snapshot = SaveSnapshot(
+        (*it)->routemapoverlay, fn, index++,
+        SnapshotFingerprint(c, configuration.boatFileName));
+    if (!snapshot.IsEmpty()) {
+      c->SetAttribute("Snapshot", snapshot.ToUTF8());
+      snapshots.insert(wxFileName(snapshot).GetFullName());
+    }
+
     root->LinkEndChild(c);
   }
 
+  // remove the snapshots of routes which were reset or deleted
+  wxString dir = fn.GetPathWithSep() + fn.GetName() + _T("_snapshots");
+  if (wxFileName::DirExists(dir)) {
+    wxArrayString files;
+    wxDir::GetAllFiles(dir, &files, _T("route*"), wxDIR_FILES);
+    for (const wxString& file : files)
+      if (!snapshots.count(wxFileName(file).GetFullName())) wxRemoveFile(file);
+  }
+
   if (!doc.SaveFile(filename.mb_str())) {
     wxMessageDialog mdlg(this, _("Failed to save xml file: ") + filename,
                          _("Weather Routing"), wxOK | wxICON_ERROR);
@@ -2537,6 +2941,36 @@ void WeatherRouting::SaveXML(wxString filename) {
   }
 }
 
+wxString WeatherRouting::SaveSnapshot(RouteMapOverlay* routemapoverlay,
+                                      const wxFileName& fn, int index,
+                                      uint64_t fingerprint) {
+  if (routemapoverlay->Running() || !routemapoverlay->Finished() ||
+      routemapoverlay->Empty())
+    return wxEmptyString;
+
+  // snapshots are kept in a directory next to the configuration file, named
+  // after the position of the route in it
+  wxString name = fn.GetName() + _T("_snapshots/") +
+                  wxString::Format(_T("route%d.snapshot"), index);
+  wxFileName path(name);
+  path.MakeAbsolute(fn.GetPath());
+  wxString snapshot = path.GetFullPath();
+  if (routemapoverlay->SnapshotFileName() == snapshot &&
+      routemapoverlay->SnapshotFingerprint() == fingerprint &&
+      wxFileName::FileExists(snapshot))
+    return name;
+
+  if (!wxFileName::DirExists(path.GetPath()) &&
+      !wxFileName::Mkdir(path.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+    return wxEmptyString;
+
+  if (!routemapoverlay->SaveSnapshot(snapshot, fingerprint)) {
+    wxRemoveFile(snapshot);
+    return wxEmptyString;
+  }
+  return name;
+}
+
 void WeatherRouting::SetEnableConfigurationMenu() {
   bool current = FirstCurrentRouteMap() != NULL;
   m_mBatch->Enable(current);
@@ -2557,6 +2991,7 @@ void WeatherRouting::SetEnableConfigurationMenu() {
   m_mDeleteAll->Enable(cnt);
   m_mComputeAll->Enable(cnt);
   m_mSaveAllAsTracks->Enable(cnt);
+  m_mExportAllRoutes->Enable(cnt);
 }
 
 void WeatherRouting::UpdateConfigurations() {
@@ -2632,6 +3067,7 @@ bool WeatherRouting::AddConfiguration(RouteMapConfiguration& configuration) {
   m_mDeleteAll->Enable();
   m_mComputeAll->Enable();
   m_mSaveAllAsTracks->Enable();
+  m_mExportAllRoutes->Enable();
   m_tAutoSaveXML.Start(5000, true);  // Schedule auto-save in 5 seconds
   return true;
 }
@@ -3104,7 +3540,7 @@ void WeatherRouting::RebuildList() {
 }
 
 void WeatherRouting::SaveAsTrack(RouteMapOverlay& routemapoverlay) {
-  std::list<PlotData> plotdata = routemapoverlay.GetPlotData(false);
+  std::list<PlotData>& plotdata = routemapoverlay.GetPlotData(false);
 
   if (plotdata.empty()) {
     wxMessageDialog mdlg(this, _("Empty routing, nothing to save\n"),
@@ -3162,7 +3598,7 @@ void WeatherRouting::SaveAsTrack(RouteMapOverlay& routemapoverlay) {
 }
 
 void WeatherRouting::SaveAsRoute(RouteMapOverlay& routemapoverlay) {
-  std::list<PlotData> plotdata = routemapoverlay.GetPlotData(false);
+  std::list<PlotData>& plotdata = routemapoverlay.GetPlotData(false);
 
   if (plotdata.empty()) {
     wxMessageDialog mdlg(this, _("Empty routing, nothing to save\n"),
@@ -3220,7 +3656,7 @@ void WeatherRouting::SaveAsRoute(RouteMapOverlay& routemapoverlay) {
 }
 
 void WeatherRouting::ExportRoute(RouteMapOverlay& routemapoverlay) {
-  std::list<PlotData> plotdata = routemapoverlay.GetPlotData(false);
+  std::list<PlotData>& plotdata = routemapoverlay.GetPlotData(false);
 
   if (plotdata.empty()) {
     wxMessageDialog mdlg(this, _("Empty Routing, nothing to export\n"),
@@ -3449,6 +3885,7 @@ void WeatherRouting::Start(RouteMapOverlay* routemapoverlay) {
        it != m_WaitingRouteMaps.end(); it++) {
     if (*it == routemapoverlay) return;
   }
+  routemapoverlay->DeleteSnapshot();
   routemapoverlay->Reset();
   m_RoutesToRun++;
   m_WaitingRouteMaps.push_back(routemapoverlay);
@@ -3513,6 +3950,7 @@ void WeatherRouting::Reset() {
   for (int i = 0; i < m_panel->m_lWeatherRoutes->GetItemCount(); i++) {
     WeatherRoute* weatherroute = reinterpret_cast<WeatherRoute*>(
         wxUIntToPtr(m_panel->m_lWeatherRoutes->GetItemData(i)));
+    weatherroute->routemapoverlay->DeleteSnapshot();
     weatherroute->routemapoverlay->Reset();
   }
   m_positionOnRoute = nullptr;
@@ -3560,6 +3998,8 @@ void WeatherRouting::DeleteRouteMaps(
     for (std::list<WeatherRoute*>::iterator writ = m_WeatherRoutes.begin();
          writ != m_WeatherRoutes.end(); writ++)
       if ((*writ)->routemapoverlay == *it) {
+        m_ReportDialog.RemoveRouteMapOverlay(*it);
+        (*it)->DeleteSnapshot();
         delete *writ;
         m_WeatherRoutes.erase(writ);
         break;
@@ -3626,6 +4066,10 @@ RouteMapConfiguration WeatherRouting::DefaultConfiguration() {
   configuration.OptimizeTacking = false;
   configuration.InvertedRegions = false;
   configuration.Anchoring = false;
+  configuration.HeuristicPruning = false;
+  configuration.Bidirectional = false;
+  configuration.MultiResolution = false;
+  configuration.CorridorWidth = 100.;
 
   configuration.FromDegree = 0;
   configuration.ToDegree = 180;
@@ -3660,7 +4104,7 @@ void WeatherRouting::SaveSimplifiedRoute(
         wxString::Format("WP%03d", newRoute->pWaypointList->GetCount() + 1);
 
     // Try to add time information if available
-    std::list<PlotData> plotData = routemapoverlay.GetPlotData(false);
+    std::list<PlotData>& plotData = routemapoverlay.GetPlotData(false);
     if (!plotData.empty()) {
       // Find the closest plot data point to this position
       PlotData* closestData = nullptr;
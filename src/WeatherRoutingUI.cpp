@@ -159,6 +159,11 @@ WeatherRoutingBase::WeatherRoutingBase(wxWindow* parent, wxWindowID id,
       wxEmptyString, wxITEM_NORMAL);
   m_mConfiguration->Append(m_mExportRouteAsGPX);
 
+  m_mExportAllRoutes = new wxMenuItem(
+      m_mConfiguration, wxID_ANY, wxString(_("Export all routings...")),
+      wxEmptyString, wxITEM_NORMAL);
+  m_mConfiguration->Append(m_mExportAllRoutes);
+
   m_mConfiguration->AppendSeparator();
 
   wxMenuItem* m_mFilter;
@@ -406,6 +411,10 @@ WeatherRoutingBase::WeatherRoutingBase(wxWindow* parent, wxWindowID id,
       wxEVT_COMMAND_MENU_SELECTED,
       wxCommandEventHandler(WeatherRoutingBase::OnExportRouteAsGPX), this,
       m_mExportRouteAsGPX->GetId());
+  m_mConfiguration->Bind(
+      wxEVT_COMMAND_MENU_SELECTED,
+      wxCommandEventHandler(WeatherRoutingBase::OnExportAllRoutes), this,
+      m_mExportAllRoutes->GetId());
   m_mConfiguration->Bind(
       wxEVT_COMMAND_MENU_SELECTED,
       wxCommandEventHandler(WeatherRoutingBase::OnSaveAllAsTracks), this,
@@ -1825,6 +1834,35 @@ ConfigurationDialogBase::ConfigurationDialogBase(wxWindow* parent,
         "periods when facing strong currents."));
   fgSizer1121->Add(m_cbAnchoring, 0, wxALL, 5);
 
+  m_cbHeuristicPruning = new wxCheckBox(
+      sbOptions1->GetStaticBox(), wxID_ANY, _("Heuristic Pruning"),
+      wxDefaultPosition, wxDefaultSize, wxCHK_3STATE);
+  m_cbHeuristicPruning->SetToolTip(
+      _("When enabled, a quick coarse route is calculated first. Positions "
+        "which cannot reach the destination before its arrival time, even "
+        "at the maximum polar speed plus the maximum current, are then not "
+        "propagated further. Disabled with climatology winds."));
+  fgSizer1121->Add(m_cbHeuristicPruning, 0, wxALL, 5);
+
+  m_cbBidirectional =
+      new wxCheckBox(sbOptions1->GetStaticBox(), wxID_ANY, _("Bidirectional"),
+                     wxDefaultPosition, wxDefaultSize, wxCHK_3STATE);
+  m_cbBidirectional->SetToolTip(
+      _("When enabled, a coarse route is computed first, then a front is "
+        "propagated backwards in time from the destination. The route is "
+        "then computed at full resolution, without the positions from which "
+        "the destination cannot be reached in time."));
+  fgSizer1121->Add(m_cbBidirectional, 0, wxALL, 5);
+
+  m_cbMultiResolution = new wxCheckBox(
+      sbOptions1->GetStaticBox(), wxID_ANY, _("Multi-resolution"),
+      wxDefaultPosition, wxDefaultSize, wxCHK_3STATE);
+  m_cbMultiResolution->SetToolTip(
+      _("When enabled, a fast coarse route is computed first without land "
+        "detection, then the route is computed again at full resolution "
+        "restricted to a corridor around the coarse route."));
+  fgSizer1121->Add(m_cbMultiResolution, 0, wxALL, 5);
+
   fgSizer113->Add(fgSizer1121, 1, wxEXPAND, 5);
 
   wxFlexGridSizer* fgSizer115;
@@ -2005,6 +2043,37 @@ ConfigurationDialogBase::ConfigurationDialogBase(wxWindow* parent,
 
   fgSizer113->Add(fgSizer11511, 1, wxEXPAND, 5);
 
+  wxFlexGridSizer* fgSizerCorridor;
+  fgSizerCorridor = new wxFlexGridSizer(1, 0, 0, 0);
+  fgSizerCorridor->SetFlexibleDirection(wxBOTH);
+  fgSizerCorridor->SetNonFlexibleGrowMode(wxFLEX_GROWMODE_SPECIFIED);
+
+  m_staticTextCorridorWidth =
+      new wxStaticText(sbOptions1->GetStaticBox(), wxID_ANY,
+                       _("Corridor Width"), wxDefaultPosition, wxDefaultSize, 0);
+  m_staticTextCorridorWidth->Wrap(-1);
+  fgSizerCorridor->Add(m_staticTextCorridorWidth, 0,
+                       wxALIGN_CENTER_VERTICAL | wxALL, 5);
+
+  m_sCorridorWidth =
+      new wxSpinCtrlDouble(sbOptions1->GetStaticBox(), wxID_ANY, wxEmptyString,
+                           wxDefaultPosition, wxSize(140, -1), wxSP_ARROW_KEYS,
+                           1., 1000., 100. /* initial value */, 1. /* inc */);
+  m_sCorridorWidth->SetToolTip(
+      _("Maximum distance in nautical miles from the coarse route explored by "
+        "the full resolution pass of a multi-resolution route."));
+  fgSizerCorridor->Add(m_sCorridorWidth, 0, wxALL | wxALIGN_CENTER_VERTICAL,
+                       5);
+
+  m_staticTextCorridorWidthUnit =
+      new wxStaticText(sbOptions1->GetStaticBox(), wxID_ANY, _("NM"),
+                       wxDefaultPosition, wxDefaultSize, 0);
+  m_staticTextCorridorWidthUnit->Wrap(-1);
+  fgSizerCorridor->Add(m_staticTextCorridorWidthUnit, 0,
+                       wxALIGN_CENTER_VERTICAL | wxALL, 5);
+
+  fgSizer113->Add(fgSizerCorridor, 1, wxEXPAND, 5);
+
   sbOptions1->Add(fgSizer113, 1, wxEXPAND, 5);
 
   fgSizer109->Add(sbOptions1, 1, wxEXPAND | wxALL, 5);
@@ -2558,6 +2627,15 @@ ConfigurationDialogBase::ConfigurationDialogBase(wxWindow* parent,
   m_cbAnchoring->Connect(
       wxEVT_COMMAND_CHECKBOX_CLICKED,
       wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
+  m_cbHeuristicPruning->Connect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
+  m_cbBidirectional->Connect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
+  m_cbMultiResolution->Connect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
   m_cIntegrator->Connect(
       wxEVT_COMMAND_TEXT_UPDATED,
       wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
@@ -2749,6 +2827,13 @@ ConfigurationDialogBase::ConfigurationDialogBase(wxWindow* parent,
   m_sSafetyMarginLand->Connect(
       wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED,
       wxSpinEventHandler(ConfigurationDialogBase::OnUpdateSpin), NULL, this);
+  m_sCorridorWidth->Connect(
+      wxEVT_MOTION,
+      wxMouseEventHandler(ConfigurationDialogBase::EnableSpinDouble), NULL,
+      this);
+  m_sCorridorWidth->Connect(
+      wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED,
+      wxSpinEventHandler(ConfigurationDialogBase::OnUpdateSpin), NULL, this);
   m_sUpwindEfficiency->Connect(
       wxEVT_COMMAND_SPINCTRL_UPDATED,
       wxSpinEventHandler(ConfigurationDialogBase::OnUpdateSpin), NULL, this);
@@ -3173,6 +3258,15 @@ ConfigurationDialogBase::~ConfigurationDialogBase() {
   m_cbAnchoring->Disconnect(
       wxEVT_COMMAND_CHECKBOX_CLICKED,
       wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
+  m_cbHeuristicPruning->Disconnect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
+  m_cbBidirectional->Disconnect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
+  m_cbMultiResolution->Disconnect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
   m_cIntegrator->Disconnect(
       wxEVT_COMMAND_TEXT_UPDATED,
       wxCommandEventHandler(ConfigurationDialogBase::OnUpdate), NULL, this);
@@ -3369,6 +3463,12 @@ ConfigurationDialogBase::~ConfigurationDialogBase() {
   m_sSafetyMarginLand->Disconnect(
       wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED,
       wxSpinEventHandler(ConfigurationDialogBase::OnUpdateSpin), NULL, this);
+  m_sCorridorWidth->Disconnect(
+      wxEVT_MOTION, wxMouseEventHandler(ConfigurationDialogBase::EnableSpin),
+      NULL, this);
+  m_sCorridorWidth->Disconnect(
+      wxEVT_COMMAND_SPINCTRLDOUBLE_UPDATED,
+      wxSpinEventHandler(ConfigurationDialogBase::OnUpdateSpin), NULL, this);
   m_sUpwindEfficiency->Disconnect(
       wxEVT_COMMAND_SPINCTRL_UPDATED,
       wxSpinEventHandler(ConfigurationDialogBase::OnUpdateSpin), NULL, this);
@@ -4709,6 +4809,62 @@ StatisticsDialogBase::StatisticsDialogBase(wxWindow* parent, wxWindowID id,
 
   fgSizer55->Add(sbSizer10, 1, wxEXPAND | wxALL, 5);
 
+  m_sbProfile = new wxStaticBoxSizer(
+      new wxStaticBox(this, wxID_ANY, _("Profile")), wxVERTICAL);
+
+  m_fgProfile = new wxFlexGridSizer(0, 4, 0, 0);
+  m_fgProfile->SetFlexibleDirection(wxBOTH);
+  m_fgProfile->SetNonFlexibleGrowMode(wxFLEX_GROWMODE_SPECIFIED);
+
+  m_sbProfile->Add(m_fgProfile, 1, wxEXPAND, 5);
+
+  wxBoxSizer* bSizerProfile;
+  bSizerProfile = new wxBoxSizer(wxHORIZONTAL);
+
+  m_bSaveProfile =
+      new wxButton(m_sbProfile->GetStaticBox(), wxID_ANY, _("Save Profile..."),
+                   wxDefaultPosition, wxDefaultSize, 0);
+  bSizerProfile->Add(m_bSaveProfile, 0, wxALL, 5);
+
+  m_cbRecordTrace =
+      new wxCheckBox(m_sbProfile->GetStaticBox(), wxID_ANY, _("Record Trace"),
+                     wxDefaultPosition, wxDefaultSize, 0);
+  m_cbRecordTrace->SetToolTip(
+      _("Record a timeline of the routing threads, the grib requests and the "
+        "rendering"));
+  bSizerProfile->Add(m_cbRecordTrace, 0, wxALIGN_CENTER_VERTICAL | wxALL, 5);
+
+  m_bSaveTrace =
+      new wxButton(m_sbProfile->GetStaticBox(), wxID_ANY, _("Save Trace..."),
+                   wxDefaultPosition, wxDefaultSize, 0);
+  bSizerProfile->Add(m_bSaveTrace, 0, wxALL, 5);
+
+  m_sbProfile->Add(bSizerProfile, 0, wxEXPAND, 5);
+
+  wxBoxSizer* bSizerStatistics;
+  bSizerStatistics = new wxBoxSizer(wxHORIZONTAL);
+
+  bSizerStatistics->Add(m_sbProfile, 1, wxEXPAND | wxALL, 5);
+
+  m_sbRejections = new wxStaticBoxSizer(
+      new wxStaticBox(this, wxID_ANY, _("Rejected Candidates")), wxHORIZONTAL);
+
+  m_fgRejections = new wxFlexGridSizer(0, 4, 0, 0);
+  m_fgRejections->SetFlexibleDirection(wxBOTH);
+  m_fgRejections->SetNonFlexibleGrowMode(wxFLEX_GROWMODE_SPECIFIED);
+
+  m_sbRejections->Add(m_fgRejections, 1, wxEXPAND, 5);
+
+  m_fgRejectionBuckets = new wxFlexGridSizer(0, 4, 0, 0);
+  m_fgRejectionBuckets->SetFlexibleDirection(wxBOTH);
+  m_fgRejectionBuckets->SetNonFlexibleGrowMode(wxFLEX_GROWMODE_SPECIFIED);
+
+  m_sbRejections->Add(m_fgRejectionBuckets, 1, wxEXPAND, 5);
+
+  bSizerStatistics->Add(m_sbRejections, 1, wxEXPAND | wxALL, 5);
+
+  fgSizer55->Add(bSizerStatistics, 1, wxEXPAND, 5);
+
   m_sdbSizer5 = new wxStdDialogButtonSizer();
   m_sdbSizer5OK = new wxButton(this, wxID_OK);
   m_sdbSizer5->AddButton(m_sdbSizer5OK);
@@ -4721,9 +4877,31 @@ StatisticsDialogBase::StatisticsDialogBase(wxWindow* parent, wxWindowID id,
   fgSizer55->Fit(this);
 
   this->Centre(wxBOTH);
+
+  // Connect Events
+  m_bSaveProfile->Connect(
+      wxEVT_COMMAND_BUTTON_CLICKED,
+      wxCommandEventHandler(StatisticsDialogBase::OnSaveProfile), NULL, this);
+  m_cbRecordTrace->Connect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(StatisticsDialogBase::OnRecordTrace), NULL, this);
+  m_bSaveTrace->Connect(
+      wxEVT_COMMAND_BUTTON_CLICKED,
+      wxCommandEventHandler(StatisticsDialogBase::OnSaveTrace), NULL, this);
 }
 
-StatisticsDialogBase::~StatisticsDialogBase() {}
+StatisticsDialogBase::~StatisticsDialogBase() {
+  // Disconnect Events
+  m_bSaveProfile->Disconnect(
+      wxEVT_COMMAND_BUTTON_CLICKED,
+      wxCommandEventHandler(StatisticsDialogBase::OnSaveProfile), NULL, this);
+  m_cbRecordTrace->Disconnect(
+      wxEVT_COMMAND_CHECKBOX_CLICKED,
+      wxCommandEventHandler(StatisticsDialogBase::OnRecordTrace), NULL, this);
+  m_bSaveTrace->Disconnect(
+      wxEVT_COMMAND_BUTTON_CLICKED,
+      wxCommandEventHandler(StatisticsDialogBase::OnSaveTrace), NULL, this);
+}
 
 ReportDialogBase::ReportDialogBase(wxWindow* parent, wxWindowID id,
                                    const wxString& title, const wxPoint& pos,
@@ -461,7 +461,7 @@ void weather_routing_pi::NewWR() {
   SendPluginMessage("GRIB_TIMELINE_REQUEST", "");
   SendPluginMessage("CLIMATOLOGY_REQUEST", "");
   RequestOcpnDrawSetting();
-  m_pWeather_Routing->Reset();
+  // nothing was computed yet, and routes restored from snapshots are kept
 }
 
 void weather_routing_pi::OnToolbarToolCallback(int id) {
@@ -0,0 +1,294 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+#ifndef _WEATHER_ROUTING_BENCHMARK_FIXTURES_H_
+#define _WEATHER_ROUTING_BENCHMARK_FIXTURES_H_
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include <wx/string.h>
+#include <wx/datetime.h>
+
+#include "Boat.h"
+#include "GribRecord.h"
+#include "IsoRoute.h"
+#include "Polar.h"
+#include "Position.h"
+#include "RouteMap.h"
+#include "WeatherDataProvider.h"
+#include "georef.h"
+
+/* Shared inputs of the engine benchmarks: the test polars and a synthetic,
+   deterministic wind and current field, so results only change when the code
+   does. */
+
+/* area covered by the synthetic grib, in degrees */
+static const double BENCHMARK_LAT_MIN = 30, BENCHMARK_LAT_MAX = 50;
+static const double BENCHMARK_LON_MIN = -30, BENCHMARK_LON_MAX = 0;
+/* grid spacing of the synthetic grib, as in a 0.25 degree GFS download */
+static const double BENCHMARK_GRID_STEP = .25;
+
+static const wxString BENCHMARK_POLAR =
+    wxString(TESTDATADIR) + "/polars/Hallberg-Rassy_40_test.pol";
+
+/**
+ * A grib record filled from a function instead of a grib file.
+ *
+ * Sets the protected grid description the same way the grib reader does for
+ * a regular latitude/longitude grid scanned west to east and south to north,
+ * without a bit map.
+ */
+class SyntheticGribRecord : public GribRecord {
+public:
+  SyntheticGribRecord(zuchar type, double lat1, double lon1, double lat2,
+                      double lon2, double step,
+                      const std::function<double(double, double)>& value) {
+    id = 0;
+    ok = knownData = true;
+    waveData = IsDuplicated = eof = false;
+    dataCenterModel = 0;
+    editionNumber = 1;
+    idCenter = idModel = idGrid = 0;
+    dataType = type;
+    levelType = LV_ABOV_GND;
+    levelValue = 10;
+    dataKey = makeKey(dataType, levelType, levelValue);
+    strRefDate[0] = strCurDate[0] = 0;
+    hasBMS = false;
+    refyear = refmonth = refday = refhour = refminute = 0;
+    periodP1 = periodP2 = periodsec = 0;
+    timeRange = 0;
+    refDate = curDate = 0;
+    NV = PV = gridType = 0;
+
+    Ni = lround((lon2 - lon1) / step) + 1;
+    Nj = lround((lat2 - lat1) / step) + 1;
+    La1 = latMin = lat1, Lo1 = lonMin = lon1;
+    La2 = latMax = lat2, Lo2 = lonMax = lon2;
+    Di = Dj = step;
+    resolFlags = scanFlags = 0;
+    hasDiDj = isEarthSpheric = isUeastVnorth = true;
+    isScanIpositive = isScanJpositive = isAdjacentI = true;
+    BMSsize = 0;
+    BMSbits = nullptr;
+
+    data = new double[Ni * Nj];
+    for (zuint j = 0; j < Nj; j++)
+      for (zuint i = 0; i < Ni; i++)
+        data[j * Ni + i] = value(getY(j), getX(i));
+    m_bfilled = true;
+  }
+};
+
+/* start of the synthetic forecast */
+static const wxDateTime BENCHMARK_START_TIME(1, wxDateTime::Jun, 2024, 12);
+
+/* wind from the south west veering and strengthening across the area, in
+   degrees and m/s like the grib. Over time the pattern backs and veers with
+   a two day period and freshens and eases daily. */
+inline double BenchmarkWindDirection(double lat, double lon, double hours = 0) {
+  return 225 + 60 * sin(lon * DEGREE * 12) + 20 * cos(lat * DEGREE * 18) +
+         30 * sin(hours * 2 * M_PI / 48);
+}
+
+inline double BenchmarkWindSpeed(double lat, double lon, double hours = 0) {
+  return (7 + 4 * sin(lat * DEGREE * 9) * cos(lon * DEGREE * 6)) *
+         (1 + .2 * sin(hours * 2 * M_PI / 24));
+}
+
+/* current setting south east along the coasts, in degrees and m/s */
+inline double BenchmarkCurrentDirection(double lat, double lon) {
+  return 160 + 30 * sin(lon * DEGREE * 10);
+}
+
+inline double BenchmarkCurrentSpeed(double lat, double lon) {
+  return .25 + .1 * cos(lat * DEGREE * 15);
+}
+
+/**
+ * Builds a grib record set with the synthetic wind and current fields.
+ *
+ * The record set owns the records, the caller owns the record set.
+ * @param hours Forecast time, in hours after BENCHMARK_START_TIME. Each time
+ * gets its own reference time and id, as the record sets of a grib file do.
+ */
+inline WR_GribRecordSet* BenchmarkGribRecordSet(int hours = 0) {
+  WR_GribRecordSet* grib = new WR_GribRecordSet(hours + 1);
+  grib->m_Reference_Time = BENCHMARK_START_TIME.GetTicks() + hours * 3600;
+  /* the u and v components of the wind blowing from the direction */
+  grib->SetUnRefGribRecord(
+      Idx_WIND_VX,
+      new SyntheticGribRecord(
+          GRB_WIND_VX, BENCHMARK_LAT_MIN, BENCHMARK_LON_MIN, BENCHMARK_LAT_MAX,
+          BENCHMARK_LON_MAX, BENCHMARK_GRID_STEP, [=](double lat, double lon) {
+            return -BenchmarkWindSpeed(lat, lon, hours) *
+                   sin(BenchmarkWindDirection(lat, lon, hours) * DEGREE);
+          }));
+  grib->SetUnRefGribRecord(
+      Idx_WIND_VY,
+      new SyntheticGribRecord(
+          GRB_WIND_VY, BENCHMARK_LAT_MIN, BENCHMARK_LON_MIN, BENCHMARK_LAT_MAX,
+          BENCHMARK_LON_MAX, BENCHMARK_GRID_STEP, [=](double lat, double lon) {
+            return -BenchmarkWindSpeed(lat, lon, hours) *
+                   cos(BenchmarkWindDirection(lat, lon, hours) * DEGREE);
+          }));
+  /* and of the current flowing to the direction */
+  grib->SetUnRefGribRecord(
+      Idx_SEACURRENT_VX,
+      new SyntheticGribRecord(
+          GRB_UOGRD, BENCHMARK_LAT_MIN, BENCHMARK_LON_MIN, BENCHMARK_LAT_MAX,
+          BENCHMARK_LON_MAX, BENCHMARK_GRID_STEP, [](double lat, double lon) {
+            return BenchmarkCurrentSpeed(lat, lon) *
+                   sin(BenchmarkCurrentDirection(lat, lon) * DEGREE);
+          }));
+  grib->SetUnRefGribRecord(
+      Idx_SEACURRENT_VY,
+      new SyntheticGribRecord(
+          GRB_VOGRD, BENCHMARK_LAT_MIN, BENCHMARK_LON_MIN, BENCHMARK_LAT_MAX,
+          BENCHMARK_LON_MAX, BENCHMARK_GRID_STEP, [](double lat, double lon) {
+            return BenchmarkCurrentSpeed(lat, lon) *
+                   cos(BenchmarkCurrentDirection(lat, lon) * DEGREE);
+          }));
+  return grib;
+}
+
+/**
+ * Gets a boat with the test polar as each of its sail plans, with the
+ * cross over chart generated.
+ *
+ * Generating the chart takes a while, so the boats are made once and shared.
+ * @param polars The number of sail plans.
+ */
+inline std::shared_ptr<const Boat> BenchmarkBoat(int polars = 1) {
+  static std::map<int, std::shared_ptr<const Boat>> boats;
+  std::shared_ptr<const Boat>& boat = boats[polars];
+  if (!boat) {
+    Polar polar;
+    wxString message;
+    if (!polar.Open(BENCHMARK_POLAR, message))
+      fprintf(stderr, "Failed to open polar file: %s\n",
+              BENCHMARK_POLAR.mb_str().data());
+
+    std::shared_ptr<Boat> b = std::make_shared<Boat>();
+    for (int i = 0; i < polars; i++) b->Polars.push_back(polar);
+    b->GenerateCrossOverChart();
+    boat = b;
+  }
+  return boat;
+}
+
+/**
+ * Configuration for propagating positions through the synthetic wind field,
+ * with the defaults of a new route and without land detection.
+ * @param by_degrees Angle between headings, as in the configuration dialog.
+ */
+inline RouteMapConfiguration BenchmarkConfiguration(double by_degrees = 5) {
+  static const wxString start = "Benchmark start", end = "Benchmark end";
+  static bool positions = false;
+  if (!positions) {
+    RouteMap::Positions.push_back(RouteMapPosition(start, 38, -25));
+    RouteMap::Positions.push_back(RouteMapPosition(end, 44, -5));
+    positions = true;
+  }
+
+  RouteMapConfiguration configuration;
+  configuration.Start = start;
+  configuration.End = end;
+  configuration.StartTime = BENCHMARK_START_TIME;
+  configuration.UseCurrentTime = false;
+  configuration.DeltaTime = configuration.UsedDeltaTime = 3600;
+  configuration.boat = BenchmarkBoat();
+  configuration.Integrator = RouteMapConfiguration::NEWTON;
+  configuration.MaxDivertedCourse = 90;
+  configuration.MaxCourseAngle = 180;
+  configuration.MaxSearchAngle = 120;
+  configuration.MaxTrueWindKnots = configuration.MaxApparentWindKnots = 50;
+  configuration.MaxSwellMeters = 20;
+  configuration.MaxLatitude = 90;
+  configuration.TackingTime = configuration.JibingTime = 0;
+  configuration.SailPlanChangeTime = 0;
+  configuration.WindVSCurrent = 0;
+  configuration.SafetyMarginLand = 0;
+  configuration.AvoidCycloneTracks = false;
+  configuration.CycloneMonths = 1;
+  configuration.CycloneDays = 0;
+  configuration.UseGrib = true;
+  configuration.ClimatologyType = RouteMapConfiguration::DISABLED;
+  configuration.AllowDataDeficient = false;
+  configuration.WindStrength = 1;
+  configuration.DetectLand = configuration.DetectBoundary = false;
+  configuration.Currents = false;
+  configuration.OptimizeTacking = false;
+  configuration.InvertedRegions = configuration.Anchoring = false;
+  configuration.FromDegree = 0;
+  configuration.ToDegree = 180;
+  configuration.ByDegrees = by_degrees;
+  configuration.Update();
+  configuration.time = configuration.StartTime;
+  return configuration;
+}
+
+/**
+ * Route map that runs the routing on the calling thread, for driving the
+ * isochrone generation and merging without the overlay and its worker.
+ */
+class BenchmarkRouteMap : public RouteMap {
+public:
+  using RouteMap::ReduceList;
+
+protected:
+  /* single threaded, nothing to lock */
+  void Lock() override {}
+  void Unlock() override {}
+  bool TestAbort() override { return false; }
+};
+
+/**
+ * Builds a closed route of positions around a center, in the clockwise
+ * order Position::Propagate() produces them.
+ * @param radius Distance of the positions from the center in nautical miles.
+ * @param count Number of positions.
+ * @param wobble Relative change of the radius along the route, so merged
+ * routes cross at many points like propagated isochrones do.
+ */
+inline IsoRoute* BenchmarkRoute(double lat, double lon, double radius,
+                                int count, double wobble = 0) {
+  Position* points = nullptr;
+  for (int i = 0; i < count; i++) {
+    double brg = 360.0 * i / count;
+    double dist = radius * (1 + wobble * sin(brg * DEGREE * 7));
+    double dlat, dlon;
+    ll_gc_ll(lat, lon, brg, dist, &dlat, &dlon);
+    Position* p = new Position(dlat, dlon);
+    if (points) {
+      p->prev = points->prev;
+      p->next = points;
+      points->prev->next = p;
+      points->prev = p;
+    } else
+      p->prev = p->next = points = p;
+  }
+  return new IsoRoute(points->BuildSkipList());
+}
+
+#endif
@@ -0,0 +1,284 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+/* Micro benchmarks of the routing hot paths.
+
+   Run them with 'make benchmarks', which writes the results to
+   benchmarks.json in the build directory for comparing releases. */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark_fixtures.h"
+#include "Geodesy.h"
+#include "SunCalculator.h"
+
+/* number of precomputed inputs each benchmark cycles through, a power of two
+   so the index wraps with a mask */
+static const int INPUTS = 1024;
+
+/* uniformly distributed inputs, the same on every run */
+static std::vector<double> Inputs(double min, double max, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(min, max);
+  std::vector<double> inputs(INPUTS);
+  for (double& input : inputs) input = distribution(generator);
+  return inputs;
+}
+
+static void BM_PolarSpeed(benchmark::State& state) {
+  const Polar& polar = BenchmarkBoat()->Polars[0];
+  std::vector<double> twa = Inputs(0, 180, 1), tws = Inputs(0, 40, 2);
+  PolarSpeedStatus status;
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(polar.Speed(twa[i], tws[i], &status, true));
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PolarSpeed);
+
+/* the argument is the number of sail plans of the boat */
+static void BM_FindBestPolarForCondition(benchmark::State& state) {
+  std::shared_ptr<const Boat> boat = BenchmarkBoat(state.range(0));
+  std::vector<double> twa = Inputs(0, 180, 1), tws = Inputs(0, 40, 2);
+  PolarSpeedStatus status;
+  int i = 0, polar = 0;
+  for (auto _ : state) {
+    polar = boat->FindBestPolarForCondition(polar, tws[i], twa[i], 0, false,
+                                            &status);
+    benchmark::DoNotOptimize(polar);
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindBestPolarForCondition)->Arg(1)->Arg(4);
+
+static void BM_GribInterpolatedValue(benchmark::State& state) {
+  std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet());
+  const GribRecord* record = grib->m_GribRecordPtrArray[Idx_WIND_VX];
+  std::vector<double> lat = Inputs(BENCHMARK_LAT_MIN, BENCHMARK_LAT_MAX, 3),
+                      lon = Inputs(BENCHMARK_LON_MIN, BENCHMARK_LON_MAX, 4);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(record->getInterpolatedValue(lon[i], lat[i]));
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GribInterpolatedValue);
+
+/* wind speed and direction from the u and v records, as read for every
+   propagated position */
+static void BM_GribInterpolatedValues(benchmark::State& state) {
+  std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet());
+  std::vector<double> lat = Inputs(BENCHMARK_LAT_MIN, BENCHMARK_LAT_MAX, 3),
+                      lon = Inputs(BENCHMARK_LON_MIN, BENCHMARK_LON_MAX, 4);
+  double speed, direction;
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(GribRecord::getInterpolatedValues(
+        speed, direction, grib->m_GribRecordPtrArray[Idx_WIND_VX],
+        grib->m_GribRecordPtrArray[Idx_WIND_VY], lon[i], lat[i]));
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GribInterpolatedValues);
+
+static void BM_ll_gc_ll(benchmark::State& state) {
+  std::vector<double> lat = Inputs(-60, 60, 3), brg = Inputs(0, 360, 5),
+                      dist = Inputs(1, 20, 6);
+  double dlat, dlon;
+  int i = 0;
+  for (auto _ : state) {
+    ll_gc_ll(lat[i], -20, brg[i], dist[i], &dlat, &dlon);
+    benchmark::DoNotOptimize(dlat);
+    benchmark::DoNotOptimize(dlon);
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ll_gc_ll);
+
+/* the replacement of ll_gc_ll() when propagating positions */
+static void BM_GeodesicOriginDestination(benchmark::State& state) {
+  GeodesicOrigin origin(40, -20);
+  std::vector<double> brg = Inputs(0, 360, 5), dist = Inputs(1, 20, 6);
+  double dlat, dlon;
+  int i = 0;
+  for (auto _ : state) {
+    origin.Destination(brg[i], dist[i], &dlat, &dlon);
+    benchmark::DoNotOptimize(dlat);
+    benchmark::DoNotOptimize(dlon);
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GeodesicOriginDestination);
+
+static void BM_DistGreatCircle(benchmark::State& state) {
+  std::vector<double> lat1 = Inputs(-60, 60, 3), lon1 = Inputs(-180, 180, 4),
+                      lat2 = Inputs(-60, 60, 5), lon2 = Inputs(-180, 180, 6);
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        DistGreatCircle(lat1[i], lon1[i], lat2[i], lon2[i]));
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DistGreatCircle);
+
+/* propagation of one position in all directions, the argument is the angle
+   between headings in degrees. Includes allocating and freeing the new
+   positions, as the routing does. */
+static void BM_PositionPropagate(benchmark::State& state) {
+  RouteMapConfiguration configuration =
+      BenchmarkConfiguration(state.range(0));
+  std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet());
+  configuration.grib = grib.get();
+  std::vector<double> lat = Inputs(35, 45, 3), lon = Inputs(-25, -5, 4);
+  int i = 0;
+  for (auto _ : state) {
+    Position position(lat[i], lon[i]);
+    IsoRouteList routelist;
+    benchmark::DoNotOptimize(position.Propagate(routelist, configuration));
+    for (IsoRoute* route : routelist) delete route;
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          configuration.DegreeSteps.size());
+}
+BENCHMARK(BM_PositionPropagate)->Arg(10)->Arg(5)->Arg(2);
+
+/* as above with the Runge-Kutta integrator and a night efficiency, which
+   read the weather again at the midpoints of each heading and need the day
+   or night status at the position */
+static void BM_PositionPropagateRungeKutta(benchmark::State& state) {
+  RouteMapConfiguration configuration =
+      BenchmarkConfiguration(state.range(0));
+  configuration.Integrator = RouteMapConfiguration::RUNGE_KUTTA;
+  configuration.NightCumulativeEfficiency = .8;
+  std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet());
+  configuration.grib = grib.get();
+  std::vector<double> lat = Inputs(35, 45, 3), lon = Inputs(-25, -5, 4);
+  int i = 0;
+  for (auto _ : state) {
+    Position position(lat[i], lon[i]);
+    IsoRouteList routelist;
+    benchmark::DoNotOptimize(position.Propagate(routelist, configuration));
+    for (IsoRoute* route : routelist) delete route;
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          configuration.DegreeSteps.size());
+}
+BENCHMARK(BM_PositionPropagateRungeKutta)->Arg(5)->Arg(2);
+
+/* merging the overlapping routes propagated from neighbouring positions of
+   an isochrone into one, most of it in Normalize(). The argument is the
+   number of routes. */
+static void BM_IsoRouteMerge(benchmark::State& state) {
+  const int routes = state.range(0);
+  RouteMapConfiguration configuration = BenchmarkConfiguration();
+  BenchmarkRouteMap routemap;
+  for (auto _ : state) {
+    state.PauseTiming();
+    /* 72 positions each as for 5 degree steps, spread along an arc so each
+       route overlaps its neighbours */
+    IsoRouteList routelist, merged;
+    for (int r = 0; r < routes; r++) {
+      double lat, lon;
+      ll_gc_ll(40, -20, 30 + 120.0 * r / routes, 50, &lat, &lon);
+      routelist.push_back(BenchmarkRoute(lat, lon, 10, 72, .2));
+    }
+    state.ResumeTiming();
+
+    routemap.ReduceList(merged, routelist, configuration);
+
+    state.PauseTiming();
+    for (IsoRoute* route : merged) delete route;
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * routes);
+}
+BENCHMARK(BM_IsoRouteMerge)->Arg(8)->Arg(32)->Arg(128);
+
+/* point in route test of an isochrone, the argument is the number of
+   positions of the route */
+static void BM_IsoRouteContains(benchmark::State& state) {
+  std::unique_ptr<IsoRoute> route(
+      BenchmarkRoute(40, -20, 100, state.range(0), .2));
+  double bounds[4]; /* min lon, max lon, min lat, max lat */
+  route->FindIsoRouteBounds(bounds);
+  std::vector<double> lat = Inputs(bounds[2], bounds[3], 3),
+                      lon = Inputs(bounds[0], bounds[1], 4);
+  int i = 0;
+  for (auto _ : state) {
+    Position position(lat[i], lon[i]);
+    benchmark::DoNotOptimize(route->Contains(position, true));
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsoRouteContains)->Arg(256)->Arg(4096);
+
+/* the argument is the number of sail plans of the boat */
+static void BM_GenerateCrossOverChart(benchmark::State& state) {
+  std::shared_ptr<const Boat> boat = BenchmarkBoat(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Boat copy;
+    copy.Polars = boat->Polars;
+    state.ResumeTiming();
+
+    copy.GenerateCrossOverChart();
+  }
+}
+BENCHMARK(BM_GenerateCrossOverChart)
+    ->Arg(1)
+    ->Arg(2)
+    ->Unit(benchmark::kMillisecond);
+
+/* the argument selects positions close together on one day, which share
+   the cached sun data, or spread over the ocean and a month, which do not */
+static void BM_SunDayLightStatus(benchmark::State& state) {
+  bool spread = state.range(0);
+  double degrees = spread ? 40 : .2;
+  std::vector<double> lat = Inputs(40 - degrees, 40 + degrees, 3),
+                      lon = Inputs(-20 - degrees, -20 + degrees, 4),
+                      hours = Inputs(0, spread ? 24 * 30 : 23, 5);
+  std::vector<wxDateTime> times;
+  wxDateTime start(1, wxDateTime::Jun, 2024);
+  for (double h : hours) times.push_back(start + wxTimeSpan::Minutes(h * 60));
+
+  SunCalculator& sun = SunCalculator::GetInstance();
+  int i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sun.GetDayLightStatus(lat[i], lon[i], times[i]));
+    i = (i + 1) & (INPUTS - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SunDayLightStatus)->Arg(0)->Arg(1);
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+#include <gtest/gtest.h>
+#include <Geodesy.h>
+#include <georef.h>
+
+// Fast steps must stay within the error bound of the ellipsoidal solution.
+TEST(GeodesyTests, DestinationWithinErrorBound) {
+  for (double lat = -85; lat <= 85; lat += 5) {
+    GeodesicOrigin origin(lat, 10, 1000, 1000);  // always fast
+    for (double dist : {0.5, 2.0, 10.0, 25.0}) {
+      // ll_gc_ll() gives NaN going due east or west on the equator
+      for (double brg = 7.5; brg < 360; brg += 15) {
+        double flat, flon, elat, elon;
+        origin.Destination(brg, dist, &flat, &flon);
+        ll_gc_ll(lat, 10, brg, dist, &elat, &elon);
+        EXPECT_LE(DistLoxodrome(flat, flon, elat, elon),
+                  GeodesicOrigin::ErrorBound(lat, dist))
+            << "lat " << lat << " dist " << dist << " brg " << brg;
+      }
+    }
+  }
+}
+
+// With the default limits the fast steps stay within the maximum error, and
+// longer steps give exactly the ellipsoidal solution.
+TEST(GeodesyTests, DestinationDefaultLimits) {
+  for (double lat : {0.0, 45.0, -70.0, 89.5}) {
+    GeodesicOrigin origin(lat, -30);
+    for (double dist : {1.0, 20.0, 100.0}) {
+      double flat, flon, elat, elon;
+      origin.Destination(30, dist, &flat, &flon);
+      ll_gc_ll(lat, -30, 30, dist, &elat, &elon);
+      if (dist <= origin.MaxFastDistance()) {
+        EXPECT_LE(DistLoxodrome(flat, flon, elat, elon),
+                  GeodesicOrigin::DEFAULT_MAX_ERROR);
+      } else {
+        EXPECT_DOUBLE_EQ(flat, elat);
+        EXPECT_DOUBLE_EQ(flon, elon);
+      }
+    }
+  }
+  EXPECT_LT(GeodesicOrigin(89.5, 0).MaxFastDistance(), 0);
+}
+
+TEST(GeodesyTests, DestinationAcrossAntimeridian) {
+  GeodesicOrigin origin(20, 179.95);
+  double dlat, dlon;
+  origin.Destination(90, 10, &dlat, &dlon);
+  EXPECT_GT(dlon, -180);
+  EXPECT_LT(dlon, -179.7);
+}
+
+TEST(GeodesyTests, FastDistance) {
+  EXPECT_DOUBLE_EQ(FastDistance(10, 20, 10, 20), 0);
+  // one minute of arc on the mean sphere is close to a nautical mile
+  EXPECT_NEAR(FastDistance(0, 0, 1, 0), 60, 0.1);
+  double d = DistGreatCircle(10, 10, 12, 13);
+  EXPECT_NEAR(FastDistance(10, 10, 12, 13), d, d * 0.005);
+}
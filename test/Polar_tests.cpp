@@ -107,6 +107,22 @@ TEST_F(PolarTest, TrueWindSpeedBasic) {
   EXPECT_NEAR(speed, 4.428, 1e-3);
 }
 
+TEST_F(PolarTest, MaxSpeedBasic) {
+  EXPECT_NEAR(m_polar.MaxSpeed(), 11.2, 1e-3);
+  EXPECT_EQ(Polar().MaxSpeed(), 0);
+}
+
+TEST_F(PolarTest, MaxSpeedExtrapolated) {
+  double maxspeed = m_polar.MaxSpeed(60);
+  EXPECT_GE(maxspeed, m_polar.MaxSpeed());
+  for (double twa = 0; twa <= 180; twa += 2.5)
+    for (double tws = 0; tws <= 60; tws += .5) {
+      double speed = m_polar.Speed(twa, tws, nullptr, false);
+      if (!std::isnan(speed))
+        EXPECT_LE(speed, maxspeed + 1e-9) << "twa " << twa << " tws " << tws;
+    }
+}
+
 TEST_F(PolarTest, InterpolateSpeedsBasic) {
   bool success = m_polar.InterpolateSpeeds();
   EXPECT_EQ(success, false); // @todo: The call fails. Figure out why, and fix this test.
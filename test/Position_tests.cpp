@@ -1,5 +1,12 @@
 #include "Position_tests.h"
 
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "Benchmark_fixtures.h"
+#include "SunCalculator.h"
+
 TEST_F(PositionTest, ConstructorBasic) {
     // Check that the position is initialized correctly
     EXPECT_DOUBLE_EQ(m_position.lat, m_latitude);
@@ -39,3 +46,72 @@ TEST_F(PositionTest, fromJsonBasic) {
     EXPECT_EQ(m_position.data_mask, position.data_mask);
     EXPECT_EQ(m_position.grib_is_data_deficient, position.grib_is_data_deficient);
 }
+
+/* the positions of a propagated route list, in order */
+static std::vector<Position*> RoutePositions(const IsoRouteList& routelist) {
+    std::vector<Position*> positions;
+    for (IsoRoute* route : routelist) {
+        Position* p = route->skippoints->point;
+        do {
+            positions.push_back(p);
+            p = p->next;
+        } while (p != route->skippoints->point);
+    }
+    return positions;
+}
+
+// The Runge-Kutta steps of a heading sail with the day or night status of
+// the position they start from, also where they reach a cell in which the
+// sun has not risen yet.
+TEST_F(PositionTest, RungeKuttaNightEfficiencyAtSunrise) {
+    RouteMapConfiguration configuration = BenchmarkConfiguration(10);
+    configuration.Integrator = RouteMapConfiguration::RUNGE_KUTTA;
+    configuration.DeltaTime = configuration.UsedDeltaTime = 3 * 3600;
+    std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet());
+    configuration.grib = grib.get();
+
+    /* a cell where the sun has risen while it has not in the cell to the
+       west, at the same hour */
+    SunCalculator& sun = SunCalculator::GetInstance();
+    const double lat = 40;
+    int cell = 0;
+    bool found = false;
+    for (int hours = -12; !found && hours < 12; hours++) {
+        configuration.time =
+            configuration.StartTime + wxTimeSpan::Hours(hours);
+        for (cell = -28; !found && cell <= -2; cell++)
+            found = sun.GetDayLightStatus(lat, cell, configuration.time) ==
+                        DayLightStatus::Day &&
+                    sun.GetDayLightStatus(lat, cell - 1,
+                                          configuration.time) ==
+                        DayLightStatus::Night;
+    }
+    ASSERT_TRUE(found) << "no sunrise boundary in the synthetic grib";
+    cell--;
+
+    /* close enough to the cell to the west for the steps of the westerly
+       headings to reach it */
+    const double lon = cell - .45;
+    IsoRouteList night, day;
+    configuration.NightCumulativeEfficiency = .5;
+    Position start(lat, lon);
+    ASSERT_TRUE(start.Propagate(night, configuration));
+    configuration.NightCumulativeEfficiency = 1;
+    Position reference(lat, lon);
+    ASSERT_TRUE(reference.Propagate(day, configuration));
+
+    std::vector<Position*> positions = RoutePositions(night),
+                           expected = RoutePositions(day);
+    ASSERT_EQ(positions.size(), expected.size());
+    bool west = false;
+    for (size_t i = 0; i < positions.size(); i++) {
+        EXPECT_DOUBLE_EQ(positions[i]->lat, expected[i]->lat);
+        EXPECT_DOUBLE_EQ(positions[i]->lon, expected[i]->lon);
+        EXPECT_FALSE(positions[i]->data_mask & DataMask::NIGHT_TIME);
+        west |= std::round(positions[i]->lon) < cell;
+    }
+    EXPECT_TRUE(west) << "no heading reached the cell to the west";
+
+    for (IsoRoute* route : night) delete route;
+    for (IsoRoute* route : day) delete route;
+}
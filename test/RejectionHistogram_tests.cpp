@@ -0,0 +1,66 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+#include <gtest/gtest.h>
+#include <RejectionHistogram.h>
+
+// Headings are bucketed by how far they are off course, either side.
+TEST(RejectionHistogramTests, Bucket) {
+  EXPECT_EQ(RejectionHistogram::Bucket(0), 0);
+  EXPECT_EQ(RejectionHistogram::Bucket(14.9), 0);
+  EXPECT_EQ(RejectionHistogram::Bucket(15), 1);
+  EXPECT_EQ(RejectionHistogram::Bucket(-20), 1);
+  EXPECT_EQ(RejectionHistogram::Bucket(340), 1);
+  EXPECT_EQ(RejectionHistogram::Bucket(-340), 1);
+  EXPECT_EQ(RejectionHistogram::Bucket(180),
+            RejectionHistogram::BUCKET_COUNT - 1);
+  EXPECT_EQ(RejectionHistogram::Bucket(-180),
+            RejectionHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(RejectionHistogramTests, AddAndTotals) {
+  RejectionHistogram step;
+  step.Try(0);
+  step.Try(0);
+  step.Try(3);
+  step.Reject(RejectionHistogram::LAND, 0);
+  step.Reject(RejectionHistogram::MAX_COURSE_ANGLE, 3);
+  step.RejectPosition(RejectionHistogram::MAX_SWELL);
+
+  RejectionHistogram total;
+  total.Add(step);
+  total.Add(step);
+  EXPECT_EQ(total.Tried(), 6);
+  EXPECT_EQ(total.Tried(0), 4);
+  EXPECT_EQ(total.Rejected(RejectionHistogram::LAND), 2);
+  EXPECT_EQ(total.Rejected(RejectionHistogram::LAND, 3), 0);
+  EXPECT_EQ(total.RejectedInBucket(3), 2);
+  EXPECT_EQ(total.Rejected(RejectionHistogram::MAX_SWELL), 0);
+  EXPECT_EQ(total.RejectedPositions(RejectionHistogram::MAX_SWELL), 2);
+
+  step.Clear();
+  step.RejectPosition(RejectionHistogram::HEURISTIC_BOUND);
+  total.Add(step);
+  EXPECT_EQ(total.RejectedPositions(RejectionHistogram::HEURISTIC_BOUND), 1);
+  EXPECT_TRUE(total.ToString().Contains("heuristic_bound 1 positions"));
+
+  total.Clear();
+  EXPECT_EQ(total.Tried(), 0);
+  EXPECT_EQ(total.RejectedPositions(RejectionHistogram::MAX_SWELL), 0);
+}
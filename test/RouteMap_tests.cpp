@@ -0,0 +1,414 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+#include "Benchmark_fixtures.h"
+#include "ConstraintChecker.h"
+#include "RouteMapOverlay.h"
+#include "Utilities.h"
+
+/* Propagates isochrones until the route map is finished, handing it the
+   forecast of each step as the overlay thread does. */
+template <typename Map>
+static void RunPass(Map& routemap) {
+  while (!routemap.Finished()) {
+    if (routemap.NeedsGrib()) {
+      int hours = (routemap.NewTime() - BENCHMARK_START_TIME).GetHours();
+      std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet(hours));
+      routemap.SetNewGrib(grib.get());
+      routemap.RequestedGrib();
+    }
+    routemap.Propagate();
+  }
+}
+
+/* Runs every pass the configuration asks for. Returns the end of the last
+   isochrone. */
+static wxDateTime RouteToDestination(BenchmarkRouteMap& routemap) {
+  do RunPass(routemap);
+  while (routemap.StartFinePass());
+  return routemap.NewTime();
+}
+
+static RouteMapConfiguration ReferenceConfiguration() {
+  RouteMapConfiguration configuration = BenchmarkConfiguration(10);
+  configuration.DeltaTime = configuration.UsedDeltaTime = 3 * 3600;
+  configuration.Currents = true;
+  return configuration;
+}
+
+TEST(RouteMapTest, HeuristicPruningKeepsArrivalTime) {
+  RouteMapConfiguration configuration = ReferenceConfiguration();
+
+  BenchmarkRouteMap reference;
+  configuration.HeuristicPruning = false;
+  reference.SetConfiguration(configuration);
+  reference.Reset();
+  wxDateTime arrival = RouteToDestination(reference);
+  ASSERT_TRUE(reference.ReachedDestination());
+  EXPECT_EQ(reference.GetRejections().RejectedPositions(
+                RejectionHistogram::HEURISTIC_BOUND),
+            0);
+
+  BenchmarkRouteMap pruned;
+  configuration.HeuristicPruning = true;
+  pruned.SetConfiguration(configuration);
+  pruned.Reset();
+  wxDateTime pruned_arrival = RouteToDestination(pruned);
+  ASSERT_TRUE(pruned.ReachedDestination());
+  EXPECT_TRUE(pruned.GetConfiguration().FinePass);
+
+  EXPECT_EQ(pruned_arrival, arrival)
+      << pruned_arrival.FormatISOCombined().mb_str().data() << " instead of "
+      << arrival.FormatISOCombined().mb_str().data();
+}
+
+TEST(RouteMapTest, BidirectionalKeepsArrivalTime) {
+  RouteMapConfiguration configuration = ReferenceConfiguration();
+  int isochrones, routes, invroutes, skippositions, positions;
+
+  BenchmarkRouteMap reference;
+  reference.SetConfiguration(configuration);
+  reference.Reset();
+  wxDateTime arrival = RouteToDestination(reference);
+  ASSERT_TRUE(reference.ReachedDestination());
+  reference.GetStatistics(isochrones, routes, invroutes, skippositions,
+                          positions);
+
+  BenchmarkRouteMap bidirectional;
+  configuration.Bidirectional = true;
+  bidirectional.SetConfiguration(configuration);
+  bidirectional.Reset();
+  wxDateTime bidirectional_arrival = RouteToDestination(bidirectional);
+  ASSERT_TRUE(bidirectional.ReachedDestination());
+  EXPECT_TRUE(bidirectional.GetConfiguration().FinePass);
+  EXPECT_GT(bidirectional.GetRejections().RejectedPositions(
+                RejectionHistogram::REVERSE_REACH),
+            0);
+
+  EXPECT_EQ(bidirectional_arrival, arrival)
+      << bidirectional_arrival.FormatISOCombined().mb_str().data()
+      << " instead of " << arrival.FormatISOCombined().mb_str().data();
+
+  int bidirectional_positions;
+  bidirectional.GetStatistics(isochrones, routes, invroutes, skippositions,
+                              bidirectional_positions);
+  EXPECT_LT(bidirectional_positions, positions);
+}
+
+TEST(RouteMapTest, HeuristicBoundWithoutTimeLeft) {
+  RouteMapConfiguration configuration = BenchmarkConfiguration();
+  configuration.HeuristicPruning = true;
+  configuration.HeuristicSpeedBound = 10;
+
+  /* 20 nm from the destination, it cannot be reached within an hour */
+  double lat = configuration.EndLat - 20.0 / 60, lon = configuration.EndLon;
+  PropagationError error_code = PROPAGATION_NO_ERROR;
+  configuration.HeuristicTimeBound = 3600;
+  EXPECT_FALSE(
+      ConstraintChecker::CheckHeuristicBound(configuration, lat, lon,
+                                             error_code));
+  EXPECT_EQ(error_code, PROPAGATION_HEURISTIC_PRUNED);
+
+  /* past the arrival time, or without one, nothing is pruned */
+  configuration.HeuristicTimeBound = -3600;
+  EXPECT_TRUE(
+      ConstraintChecker::CheckHeuristicBound(configuration, lat, lon,
+                                             error_code));
+  configuration.HeuristicTimeBound = 0;
+  EXPECT_TRUE(
+      ConstraintChecker::CheckHeuristicBound(configuration, lat, lon,
+                                             error_code));
+  configuration.HeuristicTimeBound = NAN;
+  EXPECT_TRUE(
+      ConstraintChecker::CheckHeuristicBound(configuration, lat, lon,
+                                             error_code));
+}
+
+TEST(RouteMapTest, MultiResolutionFallsBackWithoutCorridor) {
+  RouteMapConfiguration configuration = ReferenceConfiguration();
+
+  BenchmarkRouteMap reference;
+  reference.SetConfiguration(configuration);
+  reference.Reset();
+  wxDateTime arrival = RouteToDestination(reference);
+  ASSERT_TRUE(reference.ReachedDestination());
+
+  /* far too narrow for the fine pass to follow the coarse track */
+  BenchmarkRouteMap routemap;
+  configuration.MultiResolution = true;
+  configuration.CorridorWidth = 1;
+  routemap.SetConfiguration(configuration);
+  routemap.Reset();
+
+  RunPass(routemap);
+  ASSERT_TRUE(routemap.ReachedDestination());
+  ASSERT_TRUE(routemap.StartFinePass());
+  EXPECT_FALSE(routemap.GetConfiguration().Corridor.empty());
+
+  RunPass(routemap);
+  EXPECT_FALSE(routemap.ReachedDestination());
+  ASSERT_TRUE(routemap.StartFinePass());
+  EXPECT_TRUE(routemap.GetConfiguration().FinePass);
+  EXPECT_TRUE(routemap.GetConfiguration().Corridor.empty());
+
+  RunPass(routemap);
+  ASSERT_TRUE(routemap.ReachedDestination());
+  EXPECT_FALSE(routemap.StartFinePass());
+  EXPECT_EQ(routemap.NewTime(), arrival);
+}
+
+/* distance in nautical miles from a position to the nearest leg of a track,
+   on the same local flat projection as the corridor constraint */
+static double CorridorDistance(
+    const std::vector<std::pair<double, double>>& track, double lat,
+    double lon) {
+  double coslat = cos(deg2rad(lat));
+  double mindist = INFINITY;
+  for (size_t i = 0; i + 1 < track.size(); i++) {
+    double ax = 60 * coslat * heading_resolve(track[i].second - lon);
+    double ay = 60 * (track[i].first - lat);
+    double bx = 60 * coslat * heading_resolve(track[i + 1].second - lon);
+    double by = 60 * (track[i + 1].first - lat);
+    double dx = bx - ax, dy = by - ay;
+    double len2 = dx * dx + dy * dy;
+    double t = len2 > 0 ? -(ax * dx + ay * dy) / len2 : 0;
+    t = std::max(0., std::min(1., t));
+    double x = ax + t * dx, y = ay + t * dy;
+    mindist = std::min(mindist, sqrt(x * x + y * y));
+  }
+  return mindist;
+}
+
+/* The legs of the grid cells find every position a scan of all legs finds,
+   across the antimeridian and on the edges of the cells. */
+TEST(RouteMapTest, CorridorGridMatchesLinearScan) {
+  std::vector<std::pair<double, double>> track = {
+      {-32.5, 171.0}, {-30.0, 175.5}, {-29.0, 179.75}, {-27.5, -178.0},
+      {-27.0, -176.0}, {-24.0, -174.5}, {-24.5, -170.0}};
+  double width = 60;
+
+  RouteMapConfiguration configuration;
+  configuration.Corridor = track;
+  configuration.CorridorWidth = width;
+  configuration.CorridorCells =
+      std::make_shared<const CorridorGrid>(track, width);
+
+  std::vector<std::pair<double, double>> positions;
+  std::mt19937 random(20240601);
+  std::uniform_real_distribution<double> lats(-35.0, -21.0);
+  std::uniform_real_distribution<double> lons(168.0, 193.0);
+  for (int i = 0; i < 20000; i++)
+    positions.push_back(
+        std::make_pair(lats(random), heading_resolve(lons(random))));
+
+  /* the cells are one corridor width high and wide, at the highest latitude
+     of the grid, starting a width off the track, so these are on the edges
+     of the rows and columns */
+  double cell_lat = width / 60, cell_lon = cell_lat / cos(deg2rad(33.5));
+  for (double lat = -32.5 - cell_lat; lat <= -22.5; lat += cell_lat)
+    for (double lon = 169.0; lon <= 191.0; lon += 0.25)
+      positions.push_back(std::make_pair(lat, heading_resolve(lon)));
+  for (double lon = 171.0 - cell_lon; lon <= 191.0; lon += cell_lon)
+    for (double lat = -34.0; lat <= -22.0; lat += 0.25)
+      positions.push_back(std::make_pair(lat, heading_resolve(lon)));
+
+  int inside = 0;
+  for (const std::pair<double, double>& p : positions) {
+    bool expected = CorridorDistance(track, p.first, p.second) <= width;
+    EXPECT_EQ(ConstraintChecker::CheckCorridorConstraint(configuration,
+                                                         p.first, p.second),
+              expected)
+        << "lat " << p.first << " lon " << p.second;
+    inside += expected;
+  }
+  /* both answers were exercised */
+  EXPECT_GT(inside, 1000);
+  EXPECT_LT(inside, (int)positions.size() - 1000);
+}
+
+/**
+ * Route map overlay computed on the calling thread, which lists its
+ * isochrones for the snapshot tests.
+ */
+class SnapshotRouteMap : public RouteMapOverlay {
+public:
+  /* one line per isochrone and position, a position refers to its parent by
+     the number of its line */
+  std::vector<wxString> Contents() {
+    std::vector<wxString> lines;
+    std::map<const Position*, int> index;
+    for (IsoChron* isochron : origin) {
+      lines.push_back(wxString::Format(
+          "isochrone %s %.3f %d", isochron->time.FormatISOCombined(),
+          isochron->delta, (int)isochron->routes.size()));
+      for (IsoRoute* route : isochron->routes) AddRoute(route, lines, index);
+    }
+    return lines;
+  }
+
+private:
+  bool TestAbort() override { return false; }
+
+  static void AddRoute(IsoRoute* route, std::vector<wxString>& lines,
+                       std::map<const Position*, int>& index) {
+    lines.push_back(wxString::Format("route %d %d", route->direction,
+                                     (int)route->children.size()));
+    Position* p = route->skippoints->point;
+    do {
+      auto parent = index.find(p->parent);
+      lines.push_back(wxString::Format(
+          "position %.17g %.17g %d %d %d %d %d", p->lat, p->lon, p->polar,
+          p->tacks, p->jibes,
+          parent == index.end() ? -1 : parent->second, p->propagated));
+      index[p] = lines.size() - 1;
+      p = p->next;
+    } while (p != route->skippoints->point);
+    for (IsoRoute* child : route->children) AddRoute(child, lines, index);
+  }
+};
+
+static const uint64_t SNAPSHOT_FINGERPRINT = 0x0123456789abcdefULL;
+
+/* A finished route saved to a snapshot in the temporary directory. */
+class SnapshotTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_FileName = wxFileName(wxFileName::GetTempDir(),
+                            wxString::Format("weather_routing_snapshot_%lu",
+                                             wxGetProcessId()))
+                     .GetFullPath();
+
+    RouteMapConfiguration configuration = ReferenceConfiguration();
+    m_RouteMap.SetConfiguration(configuration);
+    m_RouteMap.Reset();
+    RunPass(m_RouteMap);
+    m_RouteMap.UpdateDestination();
+    ASSERT_TRUE(m_RouteMap.ReachedDestination());
+    ASSERT_TRUE(m_RouteMap.SaveSnapshot(m_FileName, SNAPSHOT_FINGERPRINT));
+  }
+
+  void TearDown() override {
+    for (const wxString& name : {m_FileName, m_FileName + ".bad"})
+      if (wxFileName::FileExists(name)) wxRemoveFile(name);
+  }
+
+  std::vector<char> ReadSnapshot() {
+    wxFile file(m_FileName);
+    std::vector<char> buffer(file.Length());
+    file.Read(buffer.data(), buffer.size());
+    return buffer;
+  }
+
+  /* writes a damaged copy of the snapshot, returns its name */
+  wxString WriteSnapshot(const std::vector<char>& buffer) {
+    wxString name = m_FileName + ".bad";
+    wxFile file;
+    file.Create(name, true);
+    file.Write(buffer.data(), buffer.size());
+    return name;
+  }
+
+  /* loading a damaged snapshot fails and leaves the route map alone */
+  void ExpectRejected(const wxString& name, uint64_t fingerprint,
+                      const wxString& reason) {
+    SnapshotRouteMap routemap;
+    routemap.SetConfiguration(ReferenceConfiguration());
+    routemap.Reset();
+    wxString error;
+    EXPECT_FALSE(routemap.LoadSnapshot(name, fingerprint, error));
+    EXPECT_TRUE(error.StartsWith(reason)) << error.mb_str().data();
+    EXPECT_TRUE(routemap.Contents().empty());
+    EXPECT_TRUE(routemap.SnapshotFileName().IsEmpty());
+  }
+
+  SnapshotRouteMap m_RouteMap;
+  wxString m_FileName;
+};
+
+TEST_F(SnapshotTest, RoundTrip) {
+  SnapshotRouteMap routemap;
+  routemap.SetConfiguration(ReferenceConfiguration());
+  routemap.Reset();
+  wxString error;
+  ASSERT_TRUE(routemap.LoadSnapshot(m_FileName, SNAPSHOT_FINGERPRINT, error))
+      << error.mb_str().data();
+
+  EXPECT_EQ(routemap.Contents(), m_RouteMap.Contents());
+  EXPECT_TRUE(routemap.Finished());
+  EXPECT_TRUE(routemap.ReachedDestination());
+  EXPECT_EQ(routemap.EndTime(), m_RouteMap.EndTime());
+  ASSERT_TRUE(routemap.GetDestination());
+  EXPECT_EQ(routemap.GetDestination()->lat,
+            m_RouteMap.GetDestination()->lat);
+  EXPECT_EQ(routemap.GetDestination()->lon,
+            m_RouteMap.GetDestination()->lon);
+  EXPECT_EQ(routemap.GetDestination()->BuildRoute().size(),
+            m_RouteMap.GetDestination()->BuildRoute().size());
+  EXPECT_EQ(routemap.SnapshotFileName(), m_FileName);
+  EXPECT_EQ(routemap.SnapshotFingerprint(), SNAPSHOT_FINGERPRINT);
+}
+
+TEST_F(SnapshotTest, TruncatedIsRejected) {
+  std::vector<char> buffer = ReadSnapshot();
+  ASSERT_GT(buffer.size(), 100u);
+  /* in the magic, after the 24 byte header, in the isochrones and in the
+     plot data at the end */
+  for (size_t size : {size_t(4), size_t(30), buffer.size() / 2,
+                      buffer.size() - 1}) {
+    std::vector<char> truncated(buffer.begin(), buffer.begin() + size);
+    ExpectRejected(WriteSnapshot(truncated), SNAPSHOT_FINGERPRINT,
+                   size < 8 ? _("Not a weather routing snapshot")
+                            : _("Corrupt snapshot file"));
+  }
+}
+
+TEST_F(SnapshotTest, BadMagicOrVersionIsRejected) {
+  std::vector<char> buffer = ReadSnapshot();
+  buffer[0] ^= 1;
+  ExpectRejected(WriteSnapshot(buffer), SNAPSHOT_FINGERPRINT,
+                 _("Not a weather routing snapshot"));
+
+  /* the version follows the 8 byte magic */
+  buffer = ReadSnapshot();
+  uint32_t version;
+  memcpy(&version, &buffer[8], sizeof version);
+  version++;
+  memcpy(&buffer[8], &version, sizeof version);
+  ExpectRejected(WriteSnapshot(buffer), SNAPSHOT_FINGERPRINT,
+                 _("Unsupported snapshot version or byte order"));
+}
+
+TEST_F(SnapshotTest, OtherConfigurationIsRejected) {
+  ExpectRejected(m_FileName, SNAPSHOT_FINGERPRINT + 1,
+                 _("Snapshot of a different configuration"));
+}
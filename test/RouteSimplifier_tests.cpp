@@ -0,0 +1,207 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Benchmark_fixtures.h"
+#include "RouteMapOverlay.h"
+#include "RouteSimplifier.h"
+
+/**
+ * Route map overlay computed on the calling thread, so the simplifier gets
+ * the isochrones and the destination the overlay thread would leave.
+ */
+class SimplifierRouteMap : public RouteMapOverlay {
+private:
+  bool TestAbort() override { return false; }
+};
+
+/* Routes from the east of the synthetic forecast back to the west, mostly
+   to windward, so the route tacks and jibes on the wind shifts and the
+   alternate route search has maneuvers to remove. */
+static void RecordRoute(SimplifierRouteMap& routemap) {
+  RouteMapConfiguration configuration = BenchmarkConfiguration(10);
+  configuration.Start = "Benchmark end";
+  configuration.End = "Benchmark start";
+  configuration.DeltaTime = configuration.UsedDeltaTime = 3 * 3600;
+  configuration.Update();
+  routemap.SetConfiguration(configuration);
+  routemap.Reset();
+
+  while (!routemap.Finished()) {
+    if (routemap.NeedsGrib()) {
+      int hours = (routemap.NewTime() - BENCHMARK_START_TIME).GetHours();
+      std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet(hours));
+      routemap.SetNewGrib(grib.get());
+      routemap.RequestedGrib();
+    }
+    routemap.Propagate();
+  }
+  routemap.UpdateDestination();
+}
+
+TEST(RouteSimplifierTest, ParallelMatchesSerial) {
+  SimplifierRouteMap routemap;
+  RecordRoute(routemap);
+  ASSERT_TRUE(routemap.ReachedDestination());
+
+  SimplificationParams params;
+  params.threads = 1;
+  RouteSimplifier serial(&routemap);
+  SimplificationResult expected = serial.Simplify(params);
+  ASSERT_TRUE(expected.success) << expected.message.mb_str().data();
+
+  params.threads = 4;
+  RouteSimplifier parallel(&routemap);
+  SimplificationResult result = parallel.Simplify(params);
+  ASSERT_TRUE(result.success) << result.message.mb_str().data();
+
+  EXPECT_EQ(result.waypointReduction, expected.waypointReduction);
+  EXPECT_EQ(result.maneuverReduction, expected.maneuverReduction);
+  EXPECT_EQ(result.simplifiedManeuverCount, expected.simplifiedManeuverCount);
+  EXPECT_EQ(result.totalDuration, expected.totalDuration);
+  ASSERT_EQ(result.simplifiedRoute.size(), expected.simplifiedRoute.size());
+  /* positions made while simplifying differ, but not where they are */
+  auto it = expected.simplifiedRoute.begin();
+  for (Position* p : result.simplifiedRoute) {
+    EXPECT_DOUBLE_EQ(p->lat, (*it)->lat);
+    EXPECT_DOUBLE_EQ(p->lon, (*it)->lon);
+    ++it;
+  }
+}
+
+// Simplifying again with the same simplifier finds the final legs and the
+// segments of the first pass in the memo. Only the segments ending at the
+// positions the second pass creates are checked again.
+TEST(RouteSimplifierTest, MemoHitsAndMisses) {
+  SimplifierRouteMap routemap;
+  RecordRoute(routemap);
+  ASSERT_TRUE(routemap.ReachedDestination());
+
+  RouteSimplifier simplifier(&routemap);
+  EXPECT_EQ(simplifier.GetMemoHits(), 0);
+  EXPECT_EQ(simplifier.GetMemoMisses(), 0);
+
+  SimplificationParams params;
+  SimplificationResult first = simplifier.Simplify(params);
+  ASSERT_TRUE(first.success) << first.message.mb_str().data();
+  long hits = simplifier.GetMemoHits(), misses = simplifier.GetMemoMisses();
+  ASSERT_GT(misses, 0) << "the route has no maneuvers to reduce";
+
+  SimplificationResult second = simplifier.Simplify(params);
+  ASSERT_TRUE(second.success) << second.message.mb_str().data();
+  EXPECT_GT(simplifier.GetMemoHits(), hits);
+  EXPECT_LT(simplifier.GetMemoMisses() - misses, misses);
+  EXPECT_EQ(second.simplifiedRoute.size(), first.simplifiedRoute.size());
+  EXPECT_EQ(second.totalDuration, first.totalDuration);
+}
+
+static RouteSimplifier::RouteCandidate Candidate(double seconds, int tacks,
+                                                 int jibes = 0) {
+  return RouteSimplifier::RouteCandidate{nullptr, seconds, tacks, jibes, 0};
+}
+
+// Of the candidates arriving at the same time only one with the fewest
+// maneuvers is kept.
+TEST(RouteSimplifierTest, ParetoFrontierTies) {
+  std::vector<RouteSimplifier::RouteCandidate> frontier =
+      RouteSimplifier::ParetoFrontier(
+          {Candidate(1000, 4), Candidate(1000, 2, 1), Candidate(1000, 3),
+           Candidate(1000, 2, 1)},
+          1000, .05);
+  ASSERT_EQ(frontier.size(), 1u);
+  EXPECT_EQ(frontier[0].Maneuvers(), 3);
+}
+
+// A slower candidate stays on the frontier when it has fewer maneuvers than
+// every faster one, and is dropped when it does not.
+TEST(RouteSimplifierTest, ParetoFrontierSlowerWithFewerManeuvers) {
+  std::vector<RouteSimplifier::RouteCandidate> frontier =
+      RouteSimplifier::ParetoFrontier(
+          {Candidate(1030, 1), Candidate(1020, 5), Candidate(1000, 4),
+           Candidate(1010, 2)},
+          1000, .05);
+  ASSERT_EQ(frontier.size(), 3u);
+  EXPECT_EQ(frontier[0].seconds, 1000);
+  EXPECT_EQ(frontier[0].Maneuvers(), 4);
+  EXPECT_EQ(frontier[1].seconds, 1010);
+  EXPECT_EQ(frontier[1].Maneuvers(), 2);
+  EXPECT_EQ(frontier[2].seconds, 1030);
+  EXPECT_EQ(frontier[2].Maneuvers(), 1);
+}
+
+// Candidates arriving later than the duration penalty allows are dropped,
+// however few maneuvers they have; the limit itself is allowed.
+TEST(RouteSimplifierTest, ParetoFrontierDurationPenalty) {
+  std::vector<RouteSimplifier::RouteCandidate> candidates = {
+      Candidate(1000, 6), Candidate(1100, 3), Candidate(1101, 0)};
+  std::vector<RouteSimplifier::RouteCandidate> frontier =
+      RouteSimplifier::ParetoFrontier(candidates, 1000, .1);
+  ASSERT_EQ(frontier.size(), 2u);
+  EXPECT_EQ(frontier.back().seconds, 1100);
+
+  frontier = RouteSimplifier::ParetoFrontier(candidates, 1000, .05);
+  ASSERT_EQ(frontier.size(), 1u);
+  EXPECT_EQ(frontier[0].seconds, 1000);
+
+  EXPECT_TRUE(RouteSimplifier::ParetoFrontier(candidates, 900, .1).empty());
+}
+
+// The frontier holds, by arrival time, one candidate of each arrival and
+// maneuver count that no other candidate within the duration penalty
+// beats, compared with every pair of random candidates.
+TEST(RouteSimplifierTest, ParetoFrontierMatchesDominance) {
+  std::mt19937 random(1);
+  for (int trial = 0; trial < 1000; trial++) {
+    std::vector<RouteSimplifier::RouteCandidate> candidates;
+    int count = random() % 12;
+    for (int i = 0; i < count; i++)
+      candidates.push_back(Candidate(1000 + random() % 8 * 10, random() % 4,
+                                     random() % 3));
+    double penalty = random() % 5 * .02;
+
+    std::vector<std::pair<double, int>> expected;
+    for (const auto& a : candidates) {
+      if (a.seconds > 1000 * (1 + penalty)) continue;
+      bool dominated = false;
+      for (const auto& b : candidates)
+        dominated |= (b.seconds < a.seconds &&
+                      b.Maneuvers() <= a.Maneuvers()) ||
+                     (b.seconds == a.seconds && b.Maneuvers() < a.Maneuvers());
+      if (!dominated) expected.push_back({a.seconds, a.Maneuvers()});
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.erase(std::unique(expected.begin(), expected.end()),
+                   expected.end());
+
+    std::vector<RouteSimplifier::RouteCandidate> frontier =
+        RouteSimplifier::ParetoFrontier(candidates, 1000, penalty);
+    ASSERT_EQ(frontier.size(), expected.size()) << trial;
+    for (size_t i = 0; i < frontier.size(); i++) {
+      EXPECT_EQ(frontier[i].seconds, expected[i].first) << trial;
+      EXPECT_EQ(frontier[i].Maneuvers(), expected[i].second) << trial;
+    }
+  }
+}
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+/* Macro benchmark of a complete routing, from the Azores to the Bay of
+   Biscay through the synthetic wind and current forecast, with land detection
+   against a simplified coastline.
+
+   It runs as the routing_benchmark test, which writes the results to
+   routing_benchmark.json in the build directory. */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+#ifdef __WXMSW__
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "Benchmark_fixtures.h"
+#include "RoutingProfile.h"
+#include "mock_plugin_api.h"
+
+static const wxString BENCHMARK_COASTLINE =
+    wxString(TESTDATADIR) + "/coastline/iberia_azores.txt";
+
+/* peak resident memory of the process so far, in megabytes */
+static double PeakResidentMegabytes() {
+#ifdef __WXMSW__
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters))
+    return 0;
+  return counters.PeakWorkingSetSize / 1048576.0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage)) return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1048576.0; /* bytes */
+#else
+  return usage.ru_maxrss / 1024.0; /* kilobytes */
+#endif
+#endif
+}
+
+/* Propagates isochrones until the destination is reached, handing the route
+   map the forecast of each step as the overlay thread does. The forecast is
+   hourly, so steps within the same hour share their record set. */
+static void BM_RouteMapToDestination(benchmark::State& state) {
+  if (!LoadMockCoastline(BENCHMARK_COASTLINE)) {
+    state.SkipWithError("Failed to load the coastline");
+    return;
+  }
+
+  RouteMapConfiguration configuration = BenchmarkConfiguration();
+  configuration.DeltaTime = configuration.UsedDeltaTime = 7200;
+  configuration.DetectLand = true;
+  configuration.Currents = true;
+
+  int isochrones = 0, positions = 0;
+  RoutingProfile profile;
+  for (auto _ : state) {
+    BenchmarkRouteMap routemap;
+    routemap.SetConfiguration(configuration);
+    routemap.Reset();
+    while (!routemap.Finished()) {
+      if (routemap.NeedsGrib()) {
+        state.PauseTiming();
+        int hours = (routemap.NewTime() - BENCHMARK_START_TIME).GetHours();
+        std::unique_ptr<WR_GribRecordSet> grib(BenchmarkGribRecordSet(hours));
+        state.ResumeTiming();
+        routemap.SetNewGrib(grib.get());
+        routemap.RequestedGrib();
+      }
+      routemap.Propagate();
+    }
+
+    state.PauseTiming();
+    if (!routemap.ReachedDestination()) {
+      state.SkipWithError("The routing did not reach the destination");
+      state.ResumeTiming();
+      break;
+    }
+    int count, routes, invroutes, skippositions, points;
+    routemap.GetStatistics(count, routes, invroutes, skippositions, points);
+    isochrones += count;
+    positions += points;
+    profile.Add(routemap.GetProfile());
+    state.ResumeTiming();
+  }
+
+  state.counters["isochrones_per_second"] =
+      benchmark::Counter(isochrones, benchmark::Counter::kIsRate);
+  state.counters["positions_per_second"] =
+      benchmark::Counter(positions, benchmark::Counter::kIsRate);
+  state.counters["peak_rss_mb"] = PeakResidentMegabytes();
+  for (int i = 0; i < RoutingProfile::PHASE_COUNT; i++) {
+    RoutingProfile::Phase phase = RoutingProfile::Phase(i);
+    if (!RoutingProfile::Timed(phase)) continue;
+    state.counters[std::string(RoutingProfile::PhaseName(phase)) +
+                   "_seconds"] =
+        benchmark::Counter(profile.Seconds(phase),
+                           benchmark::Counter::kAvgIterations);
+  }
+}
+BENCHMARK(BM_RouteMapToDestination)
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,153 @@
+/***************************************************************************
+ *   Copyright (C) 2024 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ **************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "SunCalculator.h"
+
+/**
+ * Compares the cached day or night status of SunCalculator with the sunrise
+ * and sunset CalculateSun() gives for the same cell and day. The positions
+ * are whole degrees, so the cell of a position is the position itself.
+ */
+class SunCalculatorTest : public ::testing::Test {
+protected:
+  struct Sample {
+    int lat, lon;
+    wxDateTime time;
+  };
+
+  static wxDateTime Time(int day_of_year, int hour) {
+    return wxDateTime(1, wxDateTime::Jan, 2024, hour) +
+           wxDateSpan::Days(day_of_year - 1);
+  }
+
+  /* the status without the cache */
+  static DayLightStatus Direct(const Sample& s) {
+    wxDateTime sunrise, sunset;
+    SunCalculator::CalculateSun(s.lat, s.lon, s.time.GetDayOfYear(), sunrise,
+                                sunset);
+    if (sunrise.GetYear() == 999) return DayLightStatus::Night;
+    if (sunset.GetYear() == 999) return DayLightStatus::Day;
+    int hour = s.time.GetHour(wxDateTime::UTC);
+    int rise = sunrise.GetHour(wxDateTime::UTC);
+    int set = sunset.GetHour(wxDateTime::UTC);
+    bool day = set < rise ? hour >= rise || hour < set
+                          : hour >= rise && hour < set;
+    return day ? DayLightStatus::Day : DayLightStatus::Night;
+  }
+
+  static DayLightStatus Cached(const Sample& s) {
+    return SunCalculator::GetInstance().GetDayLightStatus(s.lat, s.lon,
+                                                          s.time);
+  }
+
+  /* equinoxes, solstices and days in between, at every hour, from pole to
+     pole */
+  static std::vector<Sample> Samples() {
+    std::vector<Sample> samples;
+    for (int day : {1, 80, 135, 172, 266, 355})
+      for (int lat = -89; lat <= 89; lat += 8)
+        for (int lon = -180; lon <= 180; lon += 45)
+          for (int hour = 0; hour < 24; hour += 1)
+            samples.push_back({lat, lon, Time(day, hour)});
+    return samples;
+  }
+
+  static uint32_t Slot(int day_of_year, int lat, int lon) {
+    return SunCalculator::SlotIndex(
+        SunCalculator::PackKey(day_of_year, lat, lon));
+  }
+};
+
+// Every sample is looked up twice, the second time from the cache.
+TEST_F(SunCalculatorTest, CachedMatchesDirect) {
+  for (const Sample& s : Samples()) {
+    DayLightStatus expected = Direct(s);
+    EXPECT_EQ(Cached(s), expected)
+        << s.lat << " " << s.lon << " "
+        << s.time.FormatISOCombined().mb_str().data();
+    EXPECT_EQ(Cached(s), expected)
+        << s.lat << " " << s.lon << " "
+        << s.time.FormatISOCombined().mb_str().data();
+  }
+}
+
+// The cells inside the polar circles on the solstices, where CalculateSun()
+// finds no sunrise or no sunset, get its status at every hour.
+TEST_F(SunCalculatorTest, PolarDayAndNight) {
+  for (int day : {172, 355})
+    for (int lat : {-80, 80}) {
+      wxDateTime sunrise, sunset;
+      SunCalculator::CalculateSun(lat, 15, day, sunrise, sunset);
+      EXPECT_TRUE(sunrise.GetYear() == 999 || sunset.GetYear() == 999)
+          << lat << " " << day;
+      for (int hour = 0; hour < 24; hour++) {
+        Sample s = {lat, 15, Time(day, hour)};
+        EXPECT_EQ(Cached(s), Direct(s)) << lat << " " << day << " " << hour;
+      }
+    }
+}
+
+// Two cells sharing a slot evict each other, neither gets the sunrise and
+// sunset of the other.
+TEST_F(SunCalculatorTest, CollidingKeys) {
+  const int day = 80;
+  bool found = false;
+  int lat = 0, lon = 0;
+  for (int i = 0; !found && i < 360 * 170; i++) {
+    lat = i / 360 - 85, lon = i % 360 - 180;
+    found = std::abs(lon) > 60 && Slot(day, lat, lon) == Slot(day, 0, 0);
+  }
+  ASSERT_TRUE(found) << "no cell shares the slot of 0, 0";
+
+  /* far enough apart in longitude for the sun to rise at another hour */
+  for (int hour = 0; hour < 24; hour++) {
+    Sample a = {0, 0, Time(day, hour)}, b = {lat, lon, Time(day, hour)};
+    EXPECT_EQ(Cached(a), Direct(a)) << hour;
+    EXPECT_EQ(Cached(b), Direct(b)) << lat << " " << lon << " " << hour;
+    EXPECT_EQ(Cached(a), Direct(a)) << hour;
+  }
+}
+
+// Each thread has its own table, threads looking up the same cells in a
+// different order get the same answers.
+TEST_F(SunCalculatorTest, Threads) {
+  std::vector<Sample> samples = Samples();
+  std::vector<DayLightStatus> expected;
+  for (const Sample& s : samples) expected.push_back(Direct(s));
+
+  std::atomic<int> mismatches(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++)
+    threads.emplace_back([&, t] {
+      for (int pass = 0; pass < 3; pass++)
+        for (size_t i = 0; i < samples.size(); i++) {
+          size_t j = (i * (2 * t + 1) + pass) % samples.size();
+          if (Cached(samples[j]) != expected[j]) mismatches++;
+        }
+    });
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(mismatches.load(), 0);
+}
@@ -21,6 +21,7 @@
 #define _WEATHER_ROUTING_MOCK_PLUGIN_API_H_
 
 #include "ocpn_plugin.h"
+#include <utility>
 #include <vector>
 #include <wx/string.h>
 
@@ -30,6 +31,14 @@
 void ClearNMEASentences();
 const std::vector<wxString>& GetNMEASentences();
 
+// Functions to set the coastline of the mock GSHHS. Until a coastline is set,
+// PlugIn_GSHHS_CrossesLand() reports every segment as crossing land.
+typedef std::vector<std::pair<double, double>> MockPolygon;  // (lat, lon)
+void SetMockCoastline(const std::vector<MockPolygon>& coastline);
+// Reads polygons of "lat lon" lines separated by blank lines, '#' starts a
+// comment. Returns false if the file cannot be read.
+bool LoadMockCoastline(const wxString& filename);
+
 // Base mock plugin class implementing all virtual functions with empty
 // implementations
 class mock_plugin_base : public opencpn_plugin_118 {
@@ -17,7 +17,13 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  **************************************************************************/
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
 #include "ocpn_plugin.h"
+#include "mock_plugin_api.h"
 
 // API 19 implementations
 
@@ -174,7 +180,6 @@ DECL_EXP void GetCanvasPixLL(PlugIn_ViewPort *vp, wxPoint *pp, double lat,
 DECL_EXP void GetDoubleCanvasPixLL(PlugIn_ViewPort *vp, wxPoint2DDouble *pp,
                                    double lat, double lon) {}
 DECL_EXP void JumpToPosition(double lat, double lon, double scale) {};
-DECL_EXP bool PlugIn_GSHHS_CrossesLand(double lat1, double lon1, double lat2, double lon2) { return true;}
 DECL_EXP void RequestRefresh(wxWindow *) {}
 DECL_EXP void SetCanvasMenuItemViz(int item, bool viz, const char *name) {}
 DECL_EXP wxString GetNewGUID() { return ""; }
@@ -196,3 +201,100 @@ DECL_EXP double toUsrDistance_Plugin(double nm_distance, int unit) { return 0.0;
 DECL_EXP double toUsrSpeed_Plugin(double kts_speed, int unit) { return 0.0; }
 DECL_EXP double toUsrTemp_Plugin(double cel_temp, int unit) { return 0.0; }
 
+// Coastline of the mock GSHHS, with the bounds of each polygon to skip the
+// polygons far from a segment.
+struct MockLand {
+  MockPolygon polygon;
+  double lat_min, lat_max, lon_min, lon_max;
+};
+static std::vector<MockLand> g_coastline;
+static bool g_coastline_set = false;
+
+void SetMockCoastline(const std::vector<MockPolygon> &coastline) {
+  g_coastline.clear();
+  for (const MockPolygon &polygon : coastline) {
+    if (polygon.size() < 3) continue;
+    MockLand land = {polygon, 90, -90, 180, -180};
+    for (const std::pair<double, double> &p : polygon) {
+      land.lat_min = std::min(land.lat_min, p.first);
+      land.lat_max = std::max(land.lat_max, p.first);
+      land.lon_min = std::min(land.lon_min, p.second);
+      land.lon_max = std::max(land.lon_max, p.second);
+    }
+    g_coastline.push_back(land);
+  }
+  g_coastline_set = true;
+}
+
+bool LoadMockCoastline(const wxString &filename) {
+  std::ifstream file(filename.ToStdString());
+  if (!file) return false;
+
+  std::vector<MockPolygon> coastline(1);
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream values(line);
+    double lat, lon;
+    if (values >> lat >> lon)
+      coastline.back().emplace_back(lat, lon);
+    else if (line.find_first_not_of(" \t\r") == std::string::npos &&
+             !coastline.back().empty())
+      coastline.emplace_back();
+  }
+  SetMockCoastline(coastline);
+  return true;
+}
+
+// Orientation of c from the segment a b, in the lat/lon plane.
+static double MockCross(const std::pair<double, double> &a,
+                        const std::pair<double, double> &b,
+                        const std::pair<double, double> &c) {
+  return (b.first - a.first) * (c.second - a.second) -
+         (b.second - a.second) * (c.first - a.first);
+}
+
+static bool MockSegmentsCross(const std::pair<double, double> &a,
+                              const std::pair<double, double> &b,
+                              const std::pair<double, double> &c,
+                              const std::pair<double, double> &d) {
+  double d1 = MockCross(c, d, a), d2 = MockCross(c, d, b);
+  double d3 = MockCross(a, b, c), d4 = MockCross(a, b, d);
+  return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+static bool MockContains(const MockPolygon &polygon,
+                         const std::pair<double, double> &p) {
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const std::pair<double, double> &a = polygon[i], &b = polygon[j];
+    if ((a.first > p.first) != (b.first > p.first) &&
+        p.second < (b.second - a.second) * (p.first - a.first) /
+                           (b.first - a.first) +
+                       a.second)
+      inside = !inside;
+  }
+  return inside;
+}
+
+DECL_EXP bool PlugIn_GSHHS_CrossesLand(double lat1, double lon1, double lat2,
+                                       double lon2) {
+  if (!g_coastline_set) return true;
+
+  if (lon1 > 180) lon1 -= 360;
+  if (lon2 > 180) lon2 -= 360;
+  std::pair<double, double> p1(lat1, lon1), p2(lat2, lon2);
+  for (const MockLand &land : g_coastline) {
+    if (std::max(lat1, lat2) < land.lat_min ||
+        std::min(lat1, lat2) > land.lat_max ||
+        std::max(lon1, lon2) < land.lon_min ||
+        std::min(lon1, lon2) > land.lon_max)
+      continue;
+
+    const MockPolygon &polygon = land.polygon;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+      if (MockSegmentsCross(p1, p2, polygon[j], polygon[i])) return true;
+    if (MockContains(polygon, p1) || MockContains(polygon, p2)) return true;
+  }
+  return false;
+}